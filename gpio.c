@@ -8,9 +8,15 @@
  *
  * @history   : date       author          description
  *              2023-01-18 huenrong        创建文件
+ *              2026-10-18 huenrong        增加纳秒超时的边沿等待接口
+ *              2026-10-19 huenrong        等待边沿前先读一次电平, 清除挂起的POLLPRI
+ *              2026-10-19 huenrong        增加同时设置方向和电平的输出接口
  *
  */
 
+// 使用ppoll需要定义_GNU_SOURCE
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -18,6 +24,8 @@
 #include <string.h>
 #include <unistd.h>
 #include <errno.h>
+#include <poll.h>
+#include <time.h>
 
 #include "./gpio.h"
 
@@ -208,6 +216,47 @@ bool gpio_set_direction(const uint16_t gpio_num, const gpio_direction_e directio
     return true;
 }
 
+/**
+ * @brief  设置GPIO为输出并同时设置电平(向direction写入"high"/"low"), 切换时不会先输出低电平
+ * @param  gpio_num: 输入参数, 待设置的GPIO编号
+ * @param  value   : 输入参数, 输出电平值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_set_output(const uint16_t gpio_num, const gpio_value_e value)
+{
+    int fd = -1;
+    int ret = -1;
+    const char *level = (E_GPIO_HIGH == value) ? "high" : "low";
+    char cmd_buf[CMD_BUF_MAX_LEN] = {0};
+
+    // 打开文件: /sys/class/gpio/gpiox/direction
+    snprintf(cmd_buf, sizeof(cmd_buf), "%s/gpio%d/direction", SYS_GPIO_DIR, gpio_num);
+    fd = open(cmd_buf, O_WRONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    // 内核按写入的电平设置输出寄存器后再切换方向
+    ret = write(fd, level, strlen(level));
+    if (-1 == ret)
+    {
+        close(fd);
+
+        return false;
+    }
+
+    // 关闭文件
+    ret = close(fd);
+    if (-1 == ret)
+    {
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief  设置GPIO输出电平值
  * @param  gpio_num: 输入参数, 待设置的GPIO编号
@@ -508,3 +557,104 @@ bool gpio_close(const int fd)
 
     return false;
 }
+
+/**
+ * @brief  获取CLOCK_MONOTONIC当前时间
+ * @return 当前时间, 单位: ns
+ */
+static int64_t gpio_now_ns(void)
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((int64_t)ts.tv_sec * 1000000000LL) + ts.tv_nsec;
+}
+
+/**
+ * @brief  等待GPIO产生指定边沿
+ * @note   需先用gpio_set_edge设置触发边沿; 使用ppoll, 超时精度为纳秒
+ * @param  event     : 输出参数, 边沿事件(index为0, 时间戳为检测到边沿时的CLOCK_MONOTONIC时间)
+ * @param  fd        : 输入参数, gpio_open返回的GPIO设备文件描述符
+ * @param  edge      : 输入参数, 等待的边沿, E_GPIO_RISING/E_GPIO_FALLING/E_GPIO_BOTH
+ * @param  timeout_ns: 输入参数, 超时时间, 单位: ns, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_wait_edge(gpio_event_t *event, const int fd, const gpio_edge_e edge, const int64_t timeout_ns)
+{
+    int ret = -1;
+    char ch = 0;
+    int64_t deadline_ns = 0;
+    int64_t remain_ns = 0;
+    struct timespec ts = {0};
+    struct pollfd pfd = {0};
+    gpio_edge_e got = E_GPIO_NONE;
+
+    if ((!event) || (fd < 0) || (E_GPIO_NONE == edge))
+    {
+        return false;
+    }
+
+    // 先读一次清除打开后或上次读取后挂起的POLLPRI, 否则第一次ppoll立即返回旧的状态
+    if (1 != pread(fd, &ch, 1, 0))
+    {
+        return false;
+    }
+
+    deadline_ns = gpio_now_ns() + timeout_ns;
+    pfd.fd = fd;
+    pfd.events = POLLPRI | POLLERR;
+
+    while (true)
+    {
+        if (timeout_ns >= 0)
+        {
+            remain_ns = deadline_ns - gpio_now_ns();
+            if (remain_ns < 0)
+            {
+                remain_ns = 0;
+            }
+
+            ts.tv_sec = remain_ns / 1000000000LL;
+            ts.tv_nsec = remain_ns % 1000000000LL;
+        }
+
+        ret = ppoll(&pfd, 1, (timeout_ns >= 0) ? &ts : NULL, NULL);
+        if (0 == ret)
+        {
+            errno = ETIMEDOUT;
+
+            return false;
+        }
+        else if (ret < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        // 读取电平清除POLLPRI, 根据电平判断边沿
+        event->timestamp_ns = (uint64_t)gpio_now_ns();
+        if (1 != pread(fd, &ch, 1, 0))
+        {
+            return false;
+        }
+
+        got = ('1' == ch) ? E_GPIO_RISING : E_GPIO_FALLING;
+        if (got & edge)
+        {
+            event->index = 0;
+            event->edge = got;
+            event->seqno = 0;
+            event->line_seqno = 0;
+            event->lost = 0;
+            event->count = 1;
+
+            return true;
+        }
+    }
+}
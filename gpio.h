@@ -8,6 +8,8 @@
  *
  * @history   : date       author          description
  *              2023-01-18 huenrong        创建文件
+ *              2026-10-18 huenrong        增加纳秒超时的边沿等待接口
+ *              2026-10-19 huenrong        增加同时设置方向和电平的输出接口
  *
  */
 
@@ -53,6 +55,25 @@ typedef enum
     E_GPIO_BOTH = 3,
 } gpio_edge_e;
 
+// GPIO边沿事件
+typedef struct
+{
+    // 触发事件的GPIO在组内的序号
+    uint8_t index;
+    // 事件边沿, E_GPIO_RISING或E_GPIO_FALLING
+    gpio_edge_e edge;
+    // 事件时间戳, 单位: ns; GPIO字符设备为内核时间戳, sysfs为读取时的CLOCK_MONOTONIC时间
+    uint64_t timestamp_ns;
+    // 请求内的事件序号(uAPI v2), 其他后端为0
+    uint32_t seqno;
+    // 该GPIO的事件序号(uAPI v2), 其他后端为0
+    uint32_t line_seqno;
+    // 该GPIO在本事件之前丢失的事件个数(uAPI v2)
+    uint32_t lost;
+    // 本事件代表的原始事件个数, 事件循环合并事件时大于1, 其余为1
+    uint32_t count;
+} gpio_event_t;
+
 /**
  * @brief  导出GPIO到用户空间
  * @param  gpio_num: 输入参数, 待导出的GPIO编号
@@ -78,6 +99,15 @@ bool gpio_unexport(const uint16_t gpio_num);
  */
 bool gpio_set_direction(const uint16_t gpio_num, const gpio_direction_e direction);
 
+/**
+ * @brief  设置GPIO为输出并同时设置电平(向direction写入"high"/"low"), 切换时不会先输出低电平
+ * @param  gpio_num: 输入参数, 待设置的GPIO编号
+ * @param  value   : 输入参数, 输出电平值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_set_output(const uint16_t gpio_num, const gpio_value_e value);
+
 /**
  * @brief  设置GPIO输出电平值
  * @param  gpio_num: 输入参数, 待设置的GPIO编号
@@ -121,6 +151,18 @@ int gpio_open(const uint16_t gpio_num);
  */
 bool gpio_close(const int fd);
 
+/**
+ * @brief  等待GPIO产生指定边沿
+ * @note   需先用gpio_set_edge设置触发边沿; 使用ppoll, 超时精度为纳秒
+ * @param  event     : 输出参数, 边沿事件(index为0, 时间戳为检测到边沿时的CLOCK_MONOTONIC时间)
+ * @param  fd        : 输入参数, gpio_open返回的GPIO设备文件描述符
+ * @param  edge      : 输入参数, 等待的边沿, E_GPIO_RISING/E_GPIO_FALLING/E_GPIO_BOTH
+ * @param  timeout_ns: 输入参数, 超时时间, 单位: ns, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_wait_edge(gpio_event_t *event, const int fd, const gpio_edge_e edge, const int64_t timeout_ns);
+
 #ifdef __cplusplus
 }
 #endif
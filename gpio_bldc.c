@@ -0,0 +1,478 @@
+/**
+ * @file      : gpio_bldc.c
+ * @brief     : 霍尔传感器BLDC电机六步换相源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 15:31:42
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        统计栅极输出失败次数
+ *              2026-10-19 huenrong        霍尔状态在锁内读取, 栅极输出失败时下一个事件重新读取霍尔状态并重试
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_bldc.h"
+#include "./gpio_timer.h"
+
+// 无效步序号
+#define GPIO_BLDC_INVALID_STEP 0xFF
+
+// 120度霍尔正转时第0~5步的默认霍尔状态
+static const uint8_t gpio_bldc_default_sequence[GPIO_BLDC_STEPS] = {5, 1, 3, 2, 6, 4};
+
+// 第0~5步导通的上管相和下管相: A+B-, A+C-, B+C-, B+A-, C+A-, C+B-
+static const uint8_t gpio_bldc_step_high[GPIO_BLDC_STEPS] = {0, 0, 1, 1, 2, 2};
+static const uint8_t gpio_bldc_step_low[GPIO_BLDC_STEPS] = {1, 2, 2, 0, 0, 1};
+
+/**
+ * @brief  读取霍尔状态
+ * @param  state: 输出参数, 霍尔状态
+ * @param  bldc : 输入参数, 换相引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_bldc_read_hall(uint8_t *state, const gpio_bldc_t *bldc)
+{
+    uint64_t mask = 0;
+    uint64_t values = 0;
+
+    for (uint8_t i = 0; i < GPIO_BLDC_PHASES; i++)
+    {
+        mask |= 1ULL << bldc->config.hall[i];
+    }
+
+    if (!gpio_group_get_values(&values, bldc->config.hall_group, mask))
+    {
+        return false;
+    }
+
+    *state = 0;
+    for (uint8_t i = 0; i < GPIO_BLDC_PHASES; i++)
+    {
+        *state |= (uint8_t)(((values >> bldc->config.hall[i]) & 1) << i);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  输出栅极(调用前需持有锁): 同一相上下管互换时先关断两步都不导通的管, 等待死区后再导通
+ * @param  bldc : 输入参数, 换相引擎
+ * @param  gates: 输入参数, 栅极输出
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_bldc_output(gpio_bldc_t *bldc, const uint64_t gates)
+{
+    uint64_t high = 0;
+    uint64_t low = 0;
+    uint64_t deadline_ns = 0;
+    bool conflict = false;
+
+    if (gates == bldc->gates)
+    {
+        return true;
+    }
+
+    for (uint8_t i = 0; i < GPIO_BLDC_PHASES; i++)
+    {
+        high = 1ULL << bldc->config.gate_high[i];
+        low = 1ULL << bldc->config.gate_low[i];
+        if (((bldc->gates & high) && (gates & low)) || ((bldc->gates & low) && (gates & high)))
+        {
+            conflict = true;
+        }
+    }
+
+    // 相邻两步不会出现同一相上下管互换, 只有反向或跳步时需要两次输出
+    if (conflict)
+    {
+        if (!gpio_group_set_values(bldc->config.gate_group, bldc->gate_mask, bldc->gates & gates))
+        {
+            return false;
+        }
+
+        bldc->gates &= gates;
+        deadline_ns = gpio_timer_now_ns() + bldc->config.dead_ns;
+        while (gpio_timer_now_ns() < deadline_ns)
+        {
+        }
+    }
+
+    if (!gpio_group_set_values(bldc->config.gate_group, bldc->gate_mask, gates))
+    {
+        return false;
+    }
+
+    bldc->gates = gates;
+
+    return true;
+}
+
+/**
+ * @brief  换相(调用前需持有锁): 查表输出, 统计延迟、跳步和转速; 输出失败时只计入errors, 不更新霍尔状态,
+ *         下一个事件重试
+ * @param  bldc        : 输入参数, 换相引擎
+ * @param  state       : 输入参数, 新的霍尔状态
+ * @param  timestamp_ns: 输入参数, 霍尔边沿的内核时间戳, 单位: ns
+ */
+static void gpio_bldc_commutate(gpio_bldc_t *bldc, const uint8_t state, const uint64_t timestamp_ns)
+{
+    gpio_bldc_stats_t *stats = &bldc->stats;
+    uint8_t prev = bldc->step_of[bldc->hall_state];
+    uint8_t step = bldc->step_of[state];
+    uint8_t diff = 0;
+    uint64_t latency_ns = 0;
+
+    // 上次输出失败后霍尔状态又回到已换相的状态时只需重新输出
+    if (state == bldc->hall_state)
+    {
+        if ((bldc->output_failed) && (gpio_bldc_output(bldc, bldc->table[bldc->direction][state])))
+        {
+            bldc->output_failed = false;
+        }
+
+        return;
+    }
+
+    if (!gpio_bldc_output(bldc, bldc->table[bldc->direction][state]))
+    {
+        stats->errors++;
+        bldc->history_num = 0;
+        bldc->output_failed = true;
+
+        return;
+    }
+
+    bldc->hall_state = state;
+    bldc->output_failed = false;
+
+    latency_ns = gpio_timer_now_ns() - timestamp_ns;
+
+    stats->commutations++;
+    stats->latency_ns = latency_ns;
+    stats->sum_latency_ns += latency_ns;
+    if ((0 == stats->min_latency_ns) || (latency_ns < stats->min_latency_ns))
+    {
+        stats->min_latency_ns = latency_ns;
+    }
+
+    if (latency_ns > stats->max_latency_ns)
+    {
+        stats->max_latency_ns = latency_ns;
+    }
+
+    if (GPIO_BLDC_INVALID_STEP == step)
+    {
+        stats->invalid++;
+        bldc->history_num = 0;
+
+        return;
+    }
+
+    // 正反转相邻步的差为1或5, 其余说明跳步, 转速重新测量
+    diff = (uint8_t)((step + GPIO_BLDC_STEPS - prev) % GPIO_BLDC_STEPS);
+    if ((GPIO_BLDC_INVALID_STEP == prev) || ((1 != diff) && (GPIO_BLDC_STEPS - 1 != diff)))
+    {
+        if (GPIO_BLDC_INVALID_STEP != prev)
+        {
+            stats->skips++;
+        }
+
+        bldc->history_num = 0;
+    }
+
+    // 与6次换相之前的时间戳之差为一个电周期
+    if (GPIO_BLDC_STEPS == bldc->history_num)
+    {
+        stats->period_ns = timestamp_ns - bldc->history[bldc->history_pos];
+        stats->rpm = 60000000000.0 / (double)stats->period_ns / bldc->config.pole_pairs;
+    }
+    else
+    {
+        bldc->history_num++;
+    }
+
+    bldc->history[bldc->history_pos] = timestamp_ns;
+    bldc->history_pos = (bldc->history_pos + 1) % GPIO_BLDC_STEPS;
+}
+
+/**
+ * @brief  初始化BLDC换相引擎, 预先计算换相表
+ * @param  bldc  : 输出参数, 换相引擎
+ * @param  config: 输入参数, 换相配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_init(gpio_bldc_t *bldc, const gpio_bldc_config_t *config)
+{
+    const uint8_t *sequence = NULL;
+    uint64_t hall_mask = 0;
+    uint8_t drive = 0;
+    uint8_t used = 0;
+
+    if ((!bldc) || (!config) || (!config->hall_group) || (!config->gate_group))
+    {
+        return false;
+    }
+
+    memset(bldc, 0, sizeof(gpio_bldc_t));
+    bldc->config = *config;
+    if (0 == bldc->config.pole_pairs)
+    {
+        bldc->config.pole_pairs = 1;
+    }
+
+    for (uint8_t i = 0; i < GPIO_BLDC_PHASES; i++)
+    {
+        if ((config->hall[i] >= config->hall_group->num) || (config->gate_high[i] >= config->gate_group->num) ||
+            (config->gate_low[i] >= config->gate_group->num) || (config->gate_high[i] == config->gate_low[i]))
+        {
+            return false;
+        }
+
+        // 霍尔和栅极各自两两不同
+        if ((hall_mask & (1ULL << config->hall[i])) ||
+            (bldc->gate_mask & ((1ULL << config->gate_high[i]) | (1ULL << config->gate_low[i]))))
+        {
+            return false;
+        }
+
+        hall_mask |= 1ULL << config->hall[i];
+        bldc->gate_mask |= (1ULL << config->gate_high[i]) | (1ULL << config->gate_low[i]);
+    }
+
+    if (((config->hall_group->rising_mask & hall_mask) != hall_mask) ||
+        ((config->hall_group->falling_mask & hall_mask) != hall_mask))
+    {
+        return false;
+    }
+
+    sequence = gpio_bldc_default_sequence;
+    for (uint8_t i = 0; i < GPIO_BLDC_STEPS; i++)
+    {
+        if (0 != config->sequence[i])
+        {
+            sequence = config->sequence;
+        }
+    }
+
+    // 霍尔顺序必须是1~6的一个排列
+    memset(bldc->step_of, GPIO_BLDC_INVALID_STEP, sizeof(bldc->step_of));
+    for (uint8_t i = 0; i < GPIO_BLDC_STEPS; i++)
+    {
+        if ((0 == sequence[i]) || (sequence[i] > 6) || (used & (1U << sequence[i])))
+        {
+            return false;
+        }
+
+        used |= (uint8_t)(1U << sequence[i]);
+        bldc->step_of[sequence[i]] = i;
+    }
+
+    // 反转时输出与当前步相差半个电周期的一步
+    for (uint8_t i = 0; i < GPIO_BLDC_STEPS; i++)
+    {
+        bldc->table[E_GPIO_BLDC_FORWARD][sequence[i]] =
+            (1ULL << config->gate_high[gpio_bldc_step_high[i]]) | (1ULL << config->gate_low[gpio_bldc_step_low[i]]);
+        drive = (i + GPIO_BLDC_STEPS / 2) % GPIO_BLDC_STEPS;
+        bldc->table[E_GPIO_BLDC_REVERSE][sequence[i]] = (1ULL << config->gate_high[gpio_bldc_step_high[drive]]) |
+                                                        (1ULL << config->gate_low[gpio_bldc_step_low[drive]]);
+    }
+
+    // 只有uAPI v2的同一请求内事件按内核顺序排列, 可由事件跟踪霍尔电平
+    bldc->track_hall = (E_GPIO_BACKEND_CDEV_V2 == config->hall_group->backend);
+    if (!gpio_bldc_read_hall(&bldc->hall_state, bldc))
+    {
+        return false;
+    }
+
+    if (0 != pthread_mutex_init(&bldc->mutex, NULL))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  销毁BLDC换相引擎(运行中时先停止)
+ * @param  bldc: 输入参数, 换相引擎
+ */
+void gpio_bldc_deinit(gpio_bldc_t *bldc)
+{
+    if (!bldc)
+    {
+        return;
+    }
+
+    gpio_bldc_stop(bldc);
+    pthread_mutex_destroy(&bldc->mutex);
+}
+
+/**
+ * @brief  启动: 读取当前霍尔状态并输出对应的一步
+ * @param  bldc: 输入参数, 换相引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_start(gpio_bldc_t *bldc)
+{
+    uint8_t state = 0;
+    bool ret = false;
+
+    if ((!bldc) || (!gpio_bldc_read_hall(&state, bldc)))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&bldc->mutex);
+    bldc->hall_state = state;
+    bldc->output_failed = false;
+    bldc->history_num = 0;
+    ret = gpio_bldc_output(bldc, bldc->table[bldc->direction][state]);
+    bldc->running = ret;
+    pthread_mutex_unlock(&bldc->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief  停止: 全部栅极关断
+ * @param  bldc: 输入参数, 换相引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_stop(gpio_bldc_t *bldc)
+{
+    bool ret = false;
+
+    if (!bldc)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&bldc->mutex);
+    bldc->running = false;
+    ret = gpio_bldc_output(bldc, 0);
+    pthread_mutex_unlock(&bldc->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief  设置旋转方向, 下一次换相生效
+ * @param  bldc     : 输入参数, 换相引擎
+ * @param  direction: 输入参数, 旋转方向
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_set_direction(gpio_bldc_t *bldc, const gpio_bldc_direction_e direction)
+{
+    if ((!bldc) || (direction > E_GPIO_BLDC_REVERSE))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&bldc->mutex);
+    bldc->direction = direction;
+    pthread_mutex_unlock(&bldc->mutex);
+
+    return true;
+}
+
+/**
+ * @brief  霍尔边沿事件钩子: 更新霍尔状态, 查表后一次批量设置输出全部栅极, 统计换相延迟和转速
+ * @note   用gpio_loop_set_hook注册到霍尔GPIO组, 在读取事件时立即换相, 不经过优先级队列和回调
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 换相引擎
+ * @return true : 霍尔事件已处理
+ * @return false: 不是霍尔事件
+ */
+bool gpio_bldc_hook(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_bldc_t *bldc = (gpio_bldc_t *)arg;
+    uint8_t phase = GPIO_BLDC_PHASES;
+    uint8_t state = 0;
+    bool resync = false;
+
+    if ((!bldc) || (!event) || (group != bldc->config.hall_group))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < GPIO_BLDC_PHASES; i++)
+    {
+        if (event->index == bldc->config.hall[i])
+        {
+            phase = i;
+        }
+    }
+
+    if (GPIO_BLDC_PHASES == phase)
+    {
+        return false;
+    }
+
+    // 霍尔状态与启停共用, 在锁内读取和推算
+    pthread_mutex_lock(&bldc->mutex);
+
+    // 丢失或合并的边沿、上次输出失败时无法由事件推算霍尔状态, 重新读取
+    resync = (!bldc->track_hall) || (0 != event->lost) || (event->count > 1) || (bldc->output_failed);
+    state = bldc->hall_state;
+    if (!resync)
+    {
+        state = (uint8_t)((state & ~(1U << phase)) | (((E_GPIO_RISING == event->edge) ? 1U : 0U) << phase));
+    }
+    else if (!gpio_bldc_read_hall(&state, bldc))
+    {
+        pthread_mutex_unlock(&bldc->mutex);
+
+        return true;
+    }
+
+    if ((0 != event->lost) || (event->count > 1))
+    {
+        bldc->stats.lost += (0 != event->lost) ? event->lost : (event->count - 1);
+    }
+
+    if (bldc->running)
+    {
+        gpio_bldc_commutate(bldc, state, event->timestamp_ns);
+    }
+    else
+    {
+        bldc->hall_state = state;
+        bldc->output_failed = false;
+    }
+
+    pthread_mutex_unlock(&bldc->mutex);
+
+    return true;
+}
+
+/**
+ * @brief  获取换相统计
+ * @param  stats: 输出参数, 换相统计
+ * @param  bldc : 输入参数, 换相引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_get_stats(gpio_bldc_stats_t *stats, gpio_bldc_t *bldc)
+{
+    if ((!stats) || (!bldc))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&bldc->mutex);
+    *stats = bldc->stats;
+    pthread_mutex_unlock(&bldc->mutex);
+
+    return true;
+}
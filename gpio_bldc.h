@@ -0,0 +1,179 @@
+/**
+ * @file      : gpio_bldc.h
+ * @brief     : 霍尔传感器BLDC电机六步换相头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 15:31:42
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        统计栅极输出失败次数
+ *              2026-10-19 huenrong        霍尔状态在锁内读取, 栅极输出失败时下一个事件重新读取霍尔状态并重试
+ *
+ */
+
+#ifndef __GPIO_BLDC_H
+#define __GPIO_BLDC_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "./gpio_group.h"
+
+// 相数
+#define GPIO_BLDC_PHASES 3
+
+// 每个电周期的换相步数
+#define GPIO_BLDC_STEPS 6
+
+// 旋转方向
+typedef enum
+{
+    E_GPIO_BLDC_FORWARD = 0,
+    E_GPIO_BLDC_REVERSE = 1,
+} gpio_bldc_direction_e;
+
+// BLDC换相配置
+typedef struct
+{
+    // 霍尔输入GPIO组(检测双边沿), A/B/C霍尔在组内的序号, 霍尔状态为A | B << 1 | C << 2
+    gpio_group_t *hall_group;
+    uint8_t hall[GPIO_BLDC_PHASES];
+    // 栅极输出GPIO组(只由换相引擎写入), A/B/C相上管和下管在组内的序号, 高电平导通
+    gpio_group_t *gate_group;
+    uint8_t gate_high[GPIO_BLDC_PHASES];
+    uint8_t gate_low[GPIO_BLDC_PHASES];
+    // 正转时第0~5步对应的霍尔状态, 全为0时使用120度霍尔的默认顺序5, 1, 3, 2, 6, 4;
+    // 第0~5步依次为A+B-, A+C-, B+C-, B+A-, C+A-, C+B-
+    uint8_t sequence[GPIO_BLDC_STEPS];
+    // 极对数, 0表示1
+    uint8_t pole_pairs;
+    // 同一相上下管切换时先全部关断, 等待该时间后再导通另一管, 单位: ns
+    uint64_t dead_ns;
+} gpio_bldc_config_t;
+
+// 换相统计
+typedef struct
+{
+    // 换相次数
+    uint64_t commutations;
+    // 无效霍尔状态(0或7)次数, 此时全部关断
+    uint64_t invalid;
+    // 霍尔状态跳过一步以上的次数(丢失边沿或传感器故障)
+    uint64_t skips;
+    // 内核丢失或事件循环合并的事件个数(重新读取霍尔状态)
+    uint64_t lost;
+    // 换相时栅极输出失败的次数(不计入换相次数和延迟)
+    uint64_t errors;
+    // 换相延迟(霍尔边沿内核时间戳到栅极输出完成), 单位: ns
+    uint64_t latency_ns;
+    uint64_t min_latency_ns;
+    uint64_t max_latency_ns;
+    uint64_t sum_latency_ns;
+    // 最近一个电周期(6次换相)的时长, 单位: ns, 0表示尚未测得
+    uint64_t period_ns;
+    // 机械转速, 单位: r/min
+    double rpm;
+} gpio_bldc_stats_t;
+
+// BLDC换相引擎
+typedef struct
+{
+    gpio_bldc_config_t config;
+    // 保护输出和统计, 事件循环线程换相与其他线程启停/读取统计互斥
+    pthread_mutex_t mutex;
+    bool running;
+    gpio_bldc_direction_e direction;
+    // 预先计算的栅极输出[方向][霍尔状态], 无效霍尔状态为0
+    uint64_t table[2][8];
+    // 霍尔状态在正转顺序中的步序号, 无效为0xFF
+    uint8_t step_of[8];
+    // 全部栅极输出掩码
+    uint64_t gate_mask;
+    // 当前栅极输出
+    uint64_t gates;
+    // 霍尔电平由同一请求中的边沿事件跟踪
+    bool track_hall;
+    // 已换相的霍尔状态
+    uint8_t hall_state;
+    // 上次栅极输出失败, 下一个事件重新读取霍尔状态并重试换相
+    bool output_failed;
+    // 最近6次换相的霍尔边沿时间戳(环形)
+    uint64_t history[GPIO_BLDC_STEPS];
+    uint8_t history_pos;
+    uint8_t history_num;
+    gpio_bldc_stats_t stats;
+} gpio_bldc_t;
+
+/**
+ * @brief  初始化BLDC换相引擎, 预先计算换相表
+ * @param  bldc  : 输出参数, 换相引擎
+ * @param  config: 输入参数, 换相配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_init(gpio_bldc_t *bldc, const gpio_bldc_config_t *config);
+
+/**
+ * @brief  销毁BLDC换相引擎(运行中时先停止)
+ * @param  bldc: 输入参数, 换相引擎
+ */
+void gpio_bldc_deinit(gpio_bldc_t *bldc);
+
+/**
+ * @brief  启动: 读取当前霍尔状态并输出对应的一步
+ * @param  bldc: 输入参数, 换相引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_start(gpio_bldc_t *bldc);
+
+/**
+ * @brief  停止: 全部栅极关断
+ * @param  bldc: 输入参数, 换相引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_stop(gpio_bldc_t *bldc);
+
+/**
+ * @brief  设置旋转方向, 下一次换相生效
+ * @param  bldc     : 输入参数, 换相引擎
+ * @param  direction: 输入参数, 旋转方向
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_set_direction(gpio_bldc_t *bldc, const gpio_bldc_direction_e direction);
+
+/**
+ * @brief  霍尔边沿事件钩子: 更新霍尔状态, 查表后一次批量设置输出全部栅极, 统计换相延迟和转速
+ * @note   用gpio_loop_set_hook注册到霍尔GPIO组, 在读取事件时立即换相, 不经过优先级队列和回调
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 换相引擎
+ * @return true : 霍尔事件已处理
+ * @return false: 不是霍尔事件
+ */
+bool gpio_bldc_hook(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+/**
+ * @brief  获取换相统计
+ * @param  stats: 输出参数, 换相统计
+ * @param  bldc : 输入参数, 换相引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_bldc_get_stats(gpio_bldc_stats_t *stats, gpio_bldc_t *bldc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_BLDC_H
@@ -0,0 +1,519 @@
+/**
+ * @file      : gpio_broker.c
+ * @brief     : GPIO文件描述符代理(特权进程按策略申请GPIO并传递文件描述符)源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 18:36:54
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        去掉无法强制的输出权限, 规则只按主组ID匹配
+ *
+ */
+
+// 使用struct ucred和accept4需要定义_GNU_SOURCE
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+#include "./gpio_broker.h"
+
+// 请求和应答魔数"GBRK"
+#define GPIO_BROKER_MAGIC 0x4B524247
+
+// 使用者标签最大长度(与内核GPIO_MAX_NAME_SIZE相同)
+#define GPIO_BROKER_CONSUMER_MAX_LEN 32
+
+// 客户端请求
+typedef struct
+{
+    uint32_t magic;
+    char chip[GPIO_BROKER_CHIP_MAX_LEN];
+    char consumer[GPIO_BROKER_CONSUMER_MAX_LEN];
+    uint8_t num;
+    uint8_t direction;
+    uint8_t line_edges[GPIO_GROUP_MAX_NUM];
+    uint16_t gpio_nums[GPIO_GROUP_MAX_NUM];
+    uint64_t init_values;
+    uint32_t event_buffer_size;
+} gpio_broker_request_t;
+
+// 代理应答, 成功时附带line request文件描述符
+typedef struct
+{
+    uint32_t magic;
+    // 0表示成功, 否则为errno
+    int32_t error;
+} gpio_broker_reply_t;
+
+/**
+ * @brief  按策略检查请求: 每个GPIO都需要被一条匹配的规则允许
+ * @note   gid只与客户端的主组ID比较; 不区分输入和输出, 客户端拿到文件描述符后可以自行修改配置
+ * @param  broker : 输入参数, 代理
+ * @param  request: 输入参数, 请求
+ * @param  cred   : 输入参数, 客户端身份
+ * @return true : 允许
+ * @return false: 拒绝
+ */
+static bool gpio_broker_check_policy(const gpio_broker_t *broker, const gpio_broker_request_t *request,
+                                     const struct ucred *cred)
+{
+    const gpio_broker_rule_t *rule = NULL;
+    bool allowed = false;
+
+    for (uint8_t i = 0; i < request->num; i++)
+    {
+        allowed = false;
+        for (uint8_t j = 0; (j < broker->config.rule_num) && (!allowed); j++)
+        {
+            rule = &broker->config.rules[j];
+            allowed = ((GPIO_BROKER_ANY_ID == rule->uid) || ((int64_t)cred->uid == rule->uid)) &&
+                      ((GPIO_BROKER_ANY_ID == rule->gid) || ((int64_t)cred->gid == rule->gid)) && (rule->chip) &&
+                      (0 == strcmp(rule->chip, request->chip)) && (request->gpio_nums[i] >= rule->first) &&
+                      (request->gpio_nums[i] <= rule->last);
+        }
+
+        if (!allowed)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  发送应答, 成功时附带文件描述符
+ * @param  sock : 输入参数, 客户端套接字
+ * @param  error: 输入参数, 0表示成功, 否则为errno
+ * @param  fd   : 输入参数, 传递的文件描述符, 失败时忽略
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_broker_send_reply(const int sock, const int error, const int fd)
+{
+    gpio_broker_reply_t reply = {0};
+    struct iovec iov = {0};
+    struct msghdr msg = {0};
+    struct cmsghdr *cmsg = NULL;
+    union
+    {
+        char buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+
+    reply.magic = GPIO_BROKER_MAGIC;
+    reply.error = error;
+    iov.iov_base = &reply;
+    iov.iov_len = sizeof(reply);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (0 == error)
+    {
+        memset(&control, 0, sizeof(control));
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    return sizeof(reply) == sendmsg(sock, &msg, MSG_NOSIGNAL);
+}
+
+/**
+ * @brief  处理一个客户端连接
+ * @param  broker: 输入参数, 代理
+ * @param  sock  : 输入参数, 客户端套接字
+ */
+static void gpio_broker_handle(gpio_broker_t *broker, const int sock)
+{
+    gpio_broker_request_t request = {0};
+    struct ucred cred = {0};
+    socklen_t len = sizeof(cred);
+    struct timeval tv = {0};
+    gpio_group_config_t config = {0};
+    gpio_edge_e line_edges[GPIO_GROUP_MAX_NUM] = {0};
+    gpio_group_t group = {0};
+    int error = 0;
+
+    tv.tv_sec = GPIO_BROKER_CLIENT_TIMEOUT_MS / 1000;
+    tv.tv_usec = (GPIO_BROKER_CLIENT_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    // 身份由内核提供, 不信任请求中的任何身份信息
+    if ((0 != getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &len)) ||
+        (sizeof(request) != recv(sock, &request, sizeof(request), 0)) || (GPIO_BROKER_MAGIC != request.magic) ||
+        (0 == request.num) || (request.num > GPIO_GROUP_MAX_NUM) ||
+        ((E_GPIO_IN != request.direction) && (E_GPIO_OUT != request.direction)))
+    {
+        broker->stats.errors++;
+        gpio_broker_send_reply(sock, EINVAL, -1);
+
+        return;
+    }
+
+    request.chip[sizeof(request.chip) - 1] = '\0';
+    request.consumer[sizeof(request.consumer) - 1] = '\0';
+    if (!gpio_broker_check_policy(broker, &request, &cred))
+    {
+        broker->stats.denied++;
+        gpio_broker_send_reply(sock, EACCES, -1);
+
+        return;
+    }
+
+    for (uint8_t i = 0; i < request.num; i++)
+    {
+        line_edges[i] = (gpio_edge_e)(request.line_edges[i] & E_GPIO_BOTH);
+    }
+
+    config.chip = request.chip;
+    config.backend = E_GPIO_BACKEND_CDEV_V2;
+    config.consumer = ('\0' != request.consumer[0]) ? request.consumer : NULL;
+    config.direction = (gpio_direction_e)request.direction;
+    config.init_values = request.init_values;
+    config.line_edges = line_edges;
+    config.event_buffer_size = request.event_buffer_size;
+    if (!gpio_group_open(&group, request.gpio_nums, request.num, &config))
+    {
+        error = (0 != errno) ? errno : EIO;
+        broker->stats.errors++;
+        gpio_broker_send_reply(sock, error, -1);
+
+        return;
+    }
+
+    // 传递后关闭代理的副本, GPIO由客户端持有的文件描述符保持申请
+    if (gpio_broker_send_reply(sock, 0, group.req_fd))
+    {
+        broker->stats.granted++;
+    }
+    else
+    {
+        broker->stats.errors++;
+    }
+
+    gpio_group_close(&group);
+}
+
+/**
+ * @brief  初始化代理: 创建并监听Unix套接字
+ * @param  broker: 输出参数, 代理
+ * @param  config: 输入参数, 代理配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_broker_init(gpio_broker_t *broker, const gpio_broker_config_t *config)
+{
+    struct sockaddr_un addr = {0};
+    int err = 0;
+
+    if ((!broker) || (!config) || (!config->path) || (strlen(config->path) >= sizeof(addr.sun_path)) ||
+        (config->rule_num > GPIO_BROKER_MAX_RULES))
+    {
+        return false;
+    }
+
+    memset(broker, 0, sizeof(gpio_broker_t));
+    broker->config = *config;
+    broker->wake_fd = -1;
+    broker->listen_fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (broker->listen_fd < 0)
+    {
+        return false;
+    }
+
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", config->path);
+    unlink(config->path);
+    if ((0 != bind(broker->listen_fd, (struct sockaddr *)&addr, sizeof(addr))) ||
+        ((0 != config->mode) && (0 != chmod(config->path, config->mode))) || (0 != listen(broker->listen_fd, 16)))
+    {
+        err = errno;
+        close(broker->listen_fd);
+        broker->listen_fd = -1;
+        errno = err;
+
+        return false;
+    }
+
+    broker->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (broker->wake_fd < 0)
+    {
+        err = errno;
+        gpio_broker_deinit(broker);
+        errno = err;
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  销毁代理: 关闭并删除Unix套接字, 已传递的文件描述符不受影响
+ * @param  broker: 输入参数, 代理
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_broker_deinit(gpio_broker_t *broker)
+{
+    if ((!broker) || (broker->listen_fd < 0))
+    {
+        return false;
+    }
+
+    close(broker->listen_fd);
+    broker->listen_fd = -1;
+    unlink(broker->config.path);
+    if (broker->wake_fd >= 0)
+    {
+        close(broker->wake_fd);
+        broker->wake_fd = -1;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  处理一个客户端: 由SO_PEERCRED获取客户端身份, 按策略检查请求, 以uAPI v2申请GPIO后
+ *         用SCM_RIGHTS传递line request文件描述符, 代理随即关闭自己的副本
+ * @note   之后客户端直接对文件描述符ioctl, 不再经过代理; 客户端关闭文件描述符时GPIO被释放
+ * @param  broker    : 输入参数, 代理
+ * @param  timeout_ms: 输入参数, 等待客户端连接的超时时间, 单位: ms, 小于0表示一直等待
+ * @return 成功: 处理的客户端个数(0为超时)
+ *         失败: -1
+ */
+int gpio_broker_serve_once(gpio_broker_t *broker, const int timeout_ms)
+{
+    struct pollfd fds[2] = {0};
+    uint64_t wake = 0;
+    int ret = -1;
+    int sock = -1;
+
+    if ((!broker) || (broker->listen_fd < 0))
+    {
+        return -1;
+    }
+
+    fds[0].fd = broker->listen_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = broker->wake_fd;
+    fds[1].events = POLLIN;
+    ret = poll(fds, 2, timeout_ms);
+    if (ret <= 0)
+    {
+        return ((ret < 0) && (EINTR != errno)) ? -1 : 0;
+    }
+
+    if (fds[1].revents & POLLIN)
+    {
+        // 只用于唤醒, 读取失败说明已被读走
+        if (sizeof(wake) != read(broker->wake_fd, &wake, sizeof(wake)))
+        {
+        }
+    }
+
+    if (!(fds[0].revents & POLLIN))
+    {
+        return 0;
+    }
+
+    sock = accept4(broker->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (sock < 0)
+    {
+        // 客户端在accept之前断开
+        return ((EAGAIN == errno) || (ECONNABORTED == errno) || (EINTR == errno)) ? 0 : -1;
+    }
+
+    gpio_broker_handle(broker, sock);
+    close(sock);
+
+    return 1;
+}
+
+/**
+ * @brief  循环处理客户端, 直到调用gpio_broker_stop
+ * @param  broker: 输入参数, 代理
+ * @return true : 正常停止
+ * @return false: 失败
+ */
+bool gpio_broker_run(gpio_broker_t *broker)
+{
+    if (!broker)
+    {
+        return false;
+    }
+
+    broker->stop = false;
+    while (!broker->stop)
+    {
+        if (gpio_broker_serve_once(broker, -1) < 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  停止代理循环(可在其他线程或信号处理函数中调用)
+ * @param  broker: 输入参数, 代理
+ */
+void gpio_broker_stop(gpio_broker_t *broker)
+{
+    uint64_t wake = 1;
+
+    if (!broker)
+    {
+        return;
+    }
+
+    broker->stop = true;
+
+    // eventfd计数溢出时写入失败, 此时已有待处理的唤醒, 无需处理
+    if (sizeof(wake) != write(broker->wake_fd, &wake, sizeof(wake)))
+    {
+    }
+}
+
+/**
+ * @brief  通过代理打开GPIO组(客户端, 不需要GPIO芯片的访问权限)
+ * @note   config中的方向、边沿、初始电平、事件缓冲区大小和使用者标签随请求发送, 后端固定为uAPI v2;
+ *         被拒绝时errno为EACCES
+ * @param  group    : 输出参数, 打开的GPIO组
+ * @param  path     : 输入参数, 代理的Unix套接字路径
+ * @param  chip     : 输入参数, GPIO芯片设备路径
+ * @param  gpio_nums: 输入参数, 芯片内偏移
+ * @param  num      : 输入参数, GPIO数量, 取值范围[1, GPIO_GROUP_MAX_NUM]
+ * @param  config   : 输入参数, GPIO组配置(chip、backend、adopt_fd和request_fd被忽略)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_broker_open_group(gpio_group_t *group, const char *path, const char *chip, const uint16_t *gpio_nums,
+                            const uint8_t num, const gpio_group_config_t *config)
+{
+    gpio_broker_request_t request = {0};
+    gpio_broker_reply_t reply = {0};
+    gpio_group_config_t group_config = {0};
+    struct sockaddr_un addr = {0};
+    struct iovec iov = {0};
+    struct msghdr msg = {0};
+    struct cmsghdr *cmsg = NULL;
+    union
+    {
+        char buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr align;
+    } control;
+    int sock = -1;
+    int fd = -1;
+    int err = 0;
+
+    if ((!group) || (!path) || (strlen(path) >= sizeof(addr.sun_path)) || (!chip) ||
+        (strlen(chip) >= sizeof(request.chip)) || (!gpio_nums) || (0 == num) || (num > GPIO_GROUP_MAX_NUM) ||
+        (!config))
+    {
+        return false;
+    }
+
+    request.magic = GPIO_BROKER_MAGIC;
+    snprintf(request.chip, sizeof(request.chip), "%s", chip);
+    if (config->consumer)
+    {
+        snprintf(request.consumer, sizeof(request.consumer), "%s", config->consumer);
+    }
+
+    request.num = num;
+    request.direction = (uint8_t)config->direction;
+    for (uint8_t i = 0; i < num; i++)
+    {
+        request.gpio_nums[i] = gpio_nums[i];
+        if (E_GPIO_IN == config->direction)
+        {
+            request.line_edges[i] = (uint8_t)(config->line_edges ? config->line_edges[i] : config->edge);
+        }
+    }
+
+    request.init_values = config->init_values;
+    request.event_buffer_size = config->event_buffer_size;
+
+    sock = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (sock < 0)
+    {
+        return false;
+    }
+
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    if ((0 != connect(sock, (struct sockaddr *)&addr, sizeof(addr))) ||
+        (sizeof(request) != send(sock, &request, sizeof(request), MSG_NOSIGNAL)))
+    {
+        err = errno;
+        close(sock);
+        errno = err;
+
+        return false;
+    }
+
+    memset(&control, 0, sizeof(control));
+    iov.iov_base = &reply;
+    iov.iov_len = sizeof(reply);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+    if (sizeof(reply) != recvmsg(sock, &msg, MSG_CMSG_CLOEXEC))
+    {
+        err = (0 != errno) ? errno : EPROTO;
+        close(sock);
+        errno = err;
+
+        return false;
+    }
+
+    close(sock);
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if ((SOL_SOCKET == cmsg->cmsg_level) && (SCM_RIGHTS == cmsg->cmsg_type) &&
+            (CMSG_LEN(sizeof(int)) == cmsg->cmsg_len))
+        {
+            memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+        }
+    }
+
+    if ((GPIO_BROKER_MAGIC != reply.magic) || (0 != reply.error) || (fd < 0))
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+
+        errno = (0 != reply.error) ? reply.error : EPROTO;
+
+        return false;
+    }
+
+    // 接管传递来的line request, 之后的操作直接ioctl
+    group_config = *config;
+    group_config.chip = NULL;
+    group_config.backend = E_GPIO_BACKEND_CDEV_V2;
+    group_config.adopt_fd = true;
+    group_config.request_fd = fd;
+
+    return gpio_group_open(group, gpio_nums, num, &group_config);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file      : gpio_broker.h
+ * @brief     : GPIO文件描述符代理(特权进程按策略申请GPIO并传递文件描述符)头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 18:36:54
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        去掉无法强制的输出权限, 规则只按主组ID匹配
+ *
+ */
+
+#ifndef __GPIO_BROKER_H
+#define __GPIO_BROKER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include "./gpio_group.h"
+
+// 芯片路径最大长度
+#define GPIO_BROKER_CHIP_MAX_LEN 32
+
+// 最大策略规则个数
+#define GPIO_BROKER_MAX_RULES 32
+
+// 等待客户端请求的超时时间, 单位: ms, 防止连接后不发送请求的客户端阻塞代理
+#define GPIO_BROKER_CLIENT_TIMEOUT_MS 1000
+
+// 任意用户/组
+#define GPIO_BROKER_ANY_ID ((int64_t)-1)
+
+// 策略规则: 匹配的用户或组可以申请芯片上一段偏移范围内的GPIO
+// 客户端拿到line request文件描述符后可以用GPIO_V2_LINE_SET_CONFIG_IOCTL任意修改方向、边沿和偏置,
+// 代理无法限制, 因此规则只控制能否申请, 被允许的GPIO可以完全控制(包括作为输出)
+typedef struct
+{
+    // 用户ID和组ID(SO_PEERCRED得到的客户端有效ID), GPIO_BROKER_ANY_ID表示任意;
+    // gid只与客户端的主组ID比较, 不检查附加组
+    int64_t uid;
+    int64_t gid;
+    // GPIO芯片设备路径, 如"/dev/gpiochip0"
+    const char *chip;
+    // 芯片内偏移范围[first, last]
+    uint16_t first;
+    uint16_t last;
+} gpio_broker_rule_t;
+
+// 代理配置
+typedef struct
+{
+    // Unix套接字路径, 启动时删除已存在的同名文件
+    const char *path;
+    // 套接字文件权限, 如0666允许所有用户连接, 0表示不修改
+    mode_t mode;
+    // 策略规则, 请求的每个GPIO都需要被一条匹配的规则允许
+    gpio_broker_rule_t rules[GPIO_BROKER_MAX_RULES];
+    uint8_t rule_num;
+} gpio_broker_config_t;
+
+// 代理统计
+typedef struct
+{
+    // 已传递文件描述符的请求个数
+    uint64_t granted;
+    // 被策略拒绝的请求个数
+    uint64_t denied;
+    // 格式错误、申请GPIO失败或通信失败的请求个数
+    uint64_t errors;
+} gpio_broker_stats_t;
+
+// GPIO文件描述符代理
+typedef struct
+{
+    gpio_broker_config_t config;
+    int listen_fd;
+    // 停止时唤醒等待的eventfd
+    int wake_fd;
+    volatile bool stop;
+    gpio_broker_stats_t stats;
+} gpio_broker_t;
+
+/**
+ * @brief  初始化代理: 创建并监听Unix套接字
+ * @param  broker: 输出参数, 代理
+ * @param  config: 输入参数, 代理配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_broker_init(gpio_broker_t *broker, const gpio_broker_config_t *config);
+
+/**
+ * @brief  销毁代理: 关闭并删除Unix套接字, 已传递的文件描述符不受影响
+ * @param  broker: 输入参数, 代理
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_broker_deinit(gpio_broker_t *broker);
+
+/**
+ * @brief  处理一个客户端: 由SO_PEERCRED获取客户端身份, 按策略检查请求, 以uAPI v2申请GPIO后
+ *         用SCM_RIGHTS传递line request文件描述符, 代理随即关闭自己的副本
+ * @note   之后客户端直接对文件描述符ioctl, 不再经过代理; 客户端关闭文件描述符时GPIO被释放
+ * @param  broker    : 输入参数, 代理
+ * @param  timeout_ms: 输入参数, 等待客户端连接的超时时间, 单位: ms, 小于0表示一直等待
+ * @return 成功: 处理的客户端个数(0为超时)
+ *         失败: -1
+ */
+int gpio_broker_serve_once(gpio_broker_t *broker, const int timeout_ms);
+
+/**
+ * @brief  循环处理客户端, 直到调用gpio_broker_stop
+ * @param  broker: 输入参数, 代理
+ * @return true : 正常停止
+ * @return false: 失败
+ */
+bool gpio_broker_run(gpio_broker_t *broker);
+
+/**
+ * @brief  停止代理循环(可在其他线程或信号处理函数中调用)
+ * @param  broker: 输入参数, 代理
+ */
+void gpio_broker_stop(gpio_broker_t *broker);
+
+/**
+ * @brief  通过代理打开GPIO组(客户端, 不需要GPIO芯片的访问权限)
+ * @note   config中的方向、边沿、初始电平、事件缓冲区大小和使用者标签随请求发送, 后端固定为uAPI v2;
+ *         被拒绝时errno为EACCES
+ * @param  group    : 输出参数, 打开的GPIO组
+ * @param  path     : 输入参数, 代理的Unix套接字路径
+ * @param  chip     : 输入参数, GPIO芯片设备路径
+ * @param  gpio_nums: 输入参数, 芯片内偏移
+ * @param  num      : 输入参数, GPIO数量, 取值范围[1, GPIO_GROUP_MAX_NUM]
+ * @param  config   : 输入参数, GPIO组配置(chip、backend、adopt_fd和request_fd被忽略)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_broker_open_group(gpio_group_t *group, const char *path, const char *chip, const uint16_t *gpio_nums,
+                            const uint8_t num, const gpio_group_config_t *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_BROKER_H
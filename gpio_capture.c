@@ -0,0 +1,219 @@
+/**
+ * @file      : gpio_capture.c
+ * @brief     : GPIO输入捕获-比较输出引擎源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 15:58:40
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-19 huenrong        检查事件时间戳是否为CLOCK_MONOTONIC
+ *              2026-10-19 huenrong        显式识别CLOCK_REALTIME时间戳, 结束边沿作为屏障动作, 统计安排失败
+ *
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "./gpio_capture.h"
+
+/**
+ * @brief  初始化捕获-比较引擎
+ * @param  capture: 输出参数, 捕获-比较引擎
+ * @param  timer  : 输入参数, 已启动的定时引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_capture_init(gpio_capture_t *capture, gpio_timer_t *timer)
+{
+    if ((!capture) || (!timer))
+    {
+        return false;
+    }
+
+    memset(capture, 0, sizeof(gpio_capture_t));
+    capture->timer = timer;
+
+    return true;
+}
+
+/**
+ * @brief  添加捕获-比较通道
+ * @param  capture: 输入参数, 捕获-比较引擎
+ * @param  channel: 输入参数, 通道配置, width_ns不为0时需大于定时引擎的合并窗口
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_capture_add_channel(gpio_capture_t *capture, const gpio_capture_channel_t *channel)
+{
+    uint8_t index = 0;
+
+    if ((!capture) || (!channel) || (capture->channel_num >= GPIO_CAPTURE_MAX_CHANNELS))
+    {
+        return -1;
+    }
+
+    if ((!channel->input_group) || (channel->input_index >= channel->input_group->num) ||
+        (E_GPIO_NONE == channel->edge) || (!channel->output_group) ||
+        (channel->output_index >= channel->output_group->num))
+    {
+        return -1;
+    }
+
+    // 不大于合并窗口的宽度低于定时引擎的调度粒度, 无法保证
+    if ((0 != channel->width_ns) && (channel->width_ns <= capture->timer->merge_ns))
+    {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    index = capture->channel_num;
+    capture->channels[index] = *channel;
+    memset(&capture->stats[index], 0, sizeof(gpio_capture_stats_t));
+    capture->stats[index].min_error_ns = INT64_MAX;
+    capture->stats[index].max_error_ns = INT64_MIN;
+    capture->slots[index].capture = capture;
+    capture->slots[index].index = index;
+    capture->channel_num++;
+
+    return index;
+}
+
+/**
+ * @brief  通道输出完成, 统计偏差并回调
+ * @param  timer   : 输入参数, 定时引擎
+ * @param  action  : 输入参数, 已执行的定时动作
+ * @param  error_ns: 输入参数, 实际输出时刻与计划输出时刻的偏差, 单位: ns
+ * @param  arg     : 输入参数, 通道上下文
+ */
+static void gpio_capture_fired(gpio_timer_t *timer, const gpio_timer_action_t *action, const int64_t error_ns,
+                               void *arg)
+{
+    gpio_capture_slot_t *slot = (gpio_capture_slot_t *)arg;
+    gpio_capture_channel_t *channel = &slot->capture->channels[slot->index];
+    gpio_capture_stats_t *stats = &slot->capture->stats[slot->index];
+
+    (void)timer;
+
+    stats->fired++;
+    stats->abs_error_sum_ns += (uint64_t)((error_ns < 0) ? -error_ns : error_ns);
+    if (error_ns < stats->min_error_ns)
+    {
+        stats->min_error_ns = error_ns;
+    }
+
+    if (error_ns > stats->max_error_ns)
+    {
+        stats->max_error_ns = error_ns;
+    }
+
+    if (channel->callback)
+    {
+        channel->callback(slot->index, action->deadline_ns - channel->offset_ns, action->deadline_ns, error_ns,
+                          channel->arg);
+    }
+}
+
+/**
+ * @brief  处理输入边沿事件, 匹配的通道按事件内核时间戳加延时安排输出
+ * @note   可直接作为gpio_loop的回调函数, arg为捕获-比较引擎; uAPI v1后端的时间戳接近CLOCK_REALTIME时
+ *         (Linux 5.7之前)换算为CLOCK_MONOTONIC并计入clock_mismatch, 其他时间戳保持不变, 积压的事件计入late
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 捕获-比较引擎
+ */
+void gpio_capture_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_capture_t *capture = (gpio_capture_t *)arg;
+    gpio_capture_channel_t *channel = NULL;
+    gpio_timer_action_t action = {0};
+    uint64_t bit = 0;
+    uint64_t now_ns = 0;
+    uint64_t realtime_ns = 0;
+    uint64_t capture_ns = 0;
+    uint32_t start_id = 0;
+    bool mismatch = false;
+    struct timespec ts = {0};
+
+    if ((!capture) || (!group) || (!event))
+    {
+        return;
+    }
+
+    // Linux 5.7之前uAPI v1的时间戳是CLOCK_REALTIME: 时间戳离哪个时钟的当前时间更近就是哪个时钟,
+    // 两个时钟相差开机以来的时间, 不会混淆; CLOCK_REALTIME的时间戳按两个时钟的当前差值换算
+    capture_ns = event->timestamp_ns;
+    if (E_GPIO_BACKEND_CDEV_V1 == group->backend)
+    {
+        now_ns = gpio_timer_now_ns();
+        clock_gettime(CLOCK_REALTIME, &ts);
+        realtime_ns = ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+        if ((realtime_ns > now_ns) && (capture_ns > now_ns + (realtime_ns - now_ns) / 2))
+        {
+            capture_ns -= realtime_ns - now_ns;
+            mismatch = true;
+        }
+    }
+
+    for (uint8_t i = 0; i < capture->channel_num; i++)
+    {
+        channel = &capture->channels[i];
+        if ((group != channel->input_group) || (event->index != channel->input_index) ||
+            (!(event->edge & channel->edge)))
+        {
+            continue;
+        }
+
+        // 截止时刻以内核时间戳为基准, 与定时引擎同一时钟, 不受事件读取延迟影响
+        if (mismatch)
+        {
+            capture->stats[i].clock_mismatch++;
+        }
+
+        bit = 1ULL << channel->output_index;
+        action.deadline_ns = capture_ns + channel->offset_ns;
+        action.group = channel->output_group;
+        action.mask = bit;
+        action.values = (E_GPIO_HIGH == channel->level) ? bit : 0;
+        action.callback = gpio_capture_fired;
+        action.arg = &capture->slots[i];
+        if (action.deadline_ns < gpio_timer_now_ns())
+        {
+            capture->stats[i].late++;
+        }
+
+        start_id = gpio_timer_schedule(capture->timer, &action);
+        if (0 == start_id)
+        {
+            capture->stats[i].schedule_failed++;
+
+            continue;
+        }
+
+        if (0 == channel->width_ns)
+        {
+            continue;
+        }
+
+        // 结束边沿与起始边沿是同一GPIO, 作为屏障动作不与起始边沿合并成一次输出
+        action.deadline_ns += channel->width_ns;
+        action.values ^= bit;
+        action.barrier = true;
+        action.callback = NULL;
+        action.arg = NULL;
+        if (0 != gpio_timer_schedule(capture->timer, &action))
+        {
+            continue;
+        }
+
+        // 没有结束边沿时不能输出起始边沿, 否则输出一直保持; 已经输出时立即恢复
+        capture->stats[i].schedule_failed++;
+        if (!gpio_timer_cancel(capture->timer, start_id))
+        {
+            gpio_group_set_values(channel->output_group, bit, action.values);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/**
+ * @file      : gpio_capture.h
+ * @brief     : GPIO输入捕获-比较输出引擎头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 15:58:40
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-19 huenrong        检查事件时间戳是否为CLOCK_MONOTONIC
+ *              2026-10-19 huenrong        显式识别CLOCK_REALTIME时间戳, 结束边沿作为屏障动作, 统计安排失败
+ *
+ */
+
+#ifndef __GPIO_CAPTURE_H
+#define __GPIO_CAPTURE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+#include "./gpio_timer.h"
+
+// 捕获-比较引擎最多的通道数
+#define GPIO_CAPTURE_MAX_CHANNELS 16
+
+/**
+ * @brief  通道输出完成回调函数, 在定时线程中调用
+ * @param  channel    : 输入参数, 通道序号
+ * @param  capture_ns : 输入参数, 输入边沿的内核时间戳, 单位: ns
+ * @param  deadline_ns: 输入参数, 计划输出时刻, 单位: ns
+ * @param  error_ns   : 输入参数, 实际输出时刻与计划输出时刻的偏差, 单位: ns, 正数表示滞后
+ * @param  arg        : 输入参数, 通道配置中的用户参数
+ */
+typedef void (*gpio_capture_callback_t)(const uint8_t channel, const uint64_t capture_ns,
+                                        const uint64_t deadline_ns, const int64_t error_ns, void *arg);
+
+// 捕获-比较通道配置: 输入边沿后offset_ns输出level, 再经过width_ns恢复
+typedef struct
+{
+    // 输入GPIO组(需检测边沿)
+    gpio_group_t *input_group;
+    // 输入GPIO组内序号
+    uint8_t input_index;
+    // 触发边沿
+    gpio_edge_e edge;
+    // 输出GPIO组(只由定时线程写入)
+    gpio_group_t *output_group;
+    // 输出GPIO组内序号
+    uint8_t output_index;
+    // 输出电平
+    gpio_value_e level;
+    // 输入边沿到输出的延时, 单位: ns
+    uint64_t offset_ns;
+    // 输出脉冲宽度, 单位: ns, 0表示输出后保持, 不恢复; 不为0时需大于定时引擎的合并窗口
+    uint64_t width_ns;
+    // 输出完成回调函数, 可以为NULL
+    gpio_capture_callback_t callback;
+    // 用户参数
+    void *arg;
+} gpio_capture_channel_t;
+
+// 通道统计
+typedef struct
+{
+    // 已输出次数
+    uint64_t fired;
+    // 截止时刻已过才收到输入事件的次数(仍立即输出)
+    uint64_t late;
+    // 时间戳为CLOCK_REALTIME(Linux 5.7之前的uAPI v1)、换算为CLOCK_MONOTONIC的次数
+    uint64_t clock_mismatch;
+    // 定时引擎已满、未能安排输出的次数(该次输入不输出)
+    uint64_t schedule_failed;
+    // 最小/最大偏差, 单位: ns
+    int64_t min_error_ns;
+    int64_t max_error_ns;
+    // 偏差绝对值累计, 单位: ns
+    uint64_t abs_error_sum_ns;
+} gpio_capture_stats_t;
+
+typedef struct gpio_capture gpio_capture_t;
+
+// 通道在定时回调中的上下文
+typedef struct
+{
+    gpio_capture_t *capture;
+    uint8_t index;
+} gpio_capture_slot_t;
+
+// 捕获-比较引擎
+struct gpio_capture
+{
+    // 执行输出的定时引擎
+    gpio_timer_t *timer;
+    gpio_capture_channel_t channels[GPIO_CAPTURE_MAX_CHANNELS];
+    gpio_capture_stats_t stats[GPIO_CAPTURE_MAX_CHANNELS];
+    gpio_capture_slot_t slots[GPIO_CAPTURE_MAX_CHANNELS];
+    uint8_t channel_num;
+};
+
+/**
+ * @brief  初始化捕获-比较引擎
+ * @param  capture: 输出参数, 捕获-比较引擎
+ * @param  timer  : 输入参数, 已启动的定时引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_capture_init(gpio_capture_t *capture, gpio_timer_t *timer);
+
+/**
+ * @brief  添加捕获-比较通道
+ * @param  capture: 输入参数, 捕获-比较引擎
+ * @param  channel: 输入参数, 通道配置, width_ns不为0时需大于定时引擎的合并窗口
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_capture_add_channel(gpio_capture_t *capture, const gpio_capture_channel_t *channel);
+
+/**
+ * @brief  处理输入边沿事件, 匹配的通道按事件内核时间戳加延时安排输出
+ * @note   可直接作为gpio_loop的回调函数, arg为捕获-比较引擎; uAPI v1后端的时间戳接近CLOCK_REALTIME时
+ *         (Linux 5.7之前)换算为CLOCK_MONOTONIC并计入clock_mismatch, 其他时间戳保持不变, 积压的事件计入late
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 捕获-比较引擎
+ */
+void gpio_capture_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_CAPTURE_H
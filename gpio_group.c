@@ -0,0 +1,1381 @@
+/**
+ * @file      : gpio_group.c
+ * @brief     : GPIO组(持久句柄, 批量操作)源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 09:12:40
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-18 huenrong        增加GPIO字符设备(uAPI v2/v1)后端
+ *              2026-10-18 huenrong        支持逐个GPIO配置边沿, 增加事件丢失检测
+ *              2026-10-18 huenrong        一次read()批量读取多个事件
+ *              2026-10-18 huenrong        增加纳秒超时的边沿等待接口
+ *              2026-10-18 huenrong        支持逐个GPIO切换方向, 增加虚拟后端
+ *              2026-10-19 huenrong        uAPI v2后端检测边沿的GPIO可以临时切换为输出
+ *              2026-10-19 huenrong        uAPI v2后端可以接管已申请的line request文件描述符
+ *              2026-10-19 huenrong        sysfs后端切换为输出时同时写入电平, 避免毛刺
+ *              2026-10-19 huenrong        接管line request文件描述符改为由adopt_fd显式指定
+ *
+ */
+
+// 使用ppoll需要定义_GNU_SOURCE
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#include "./gpio_group.h"
+
+// gpio路径
+#define SYS_GPIO_DIR "/sys/class/gpio"
+
+// 命令buf最大长度
+#define CMD_BUF_MAX_LEN 60
+
+// 默认使用者标签
+#define GPIO_GROUP_DEFAULT_CONSUMER "linux_gpio"
+
+// 批量读取缓冲区对齐(缓存行大小)
+#define GPIO_GROUP_EVENT_BUF_ALIGN 64
+
+// 每次read()最少读取的事件个数
+#define GPIO_GROUP_EVENT_BATCH_MIN 1
+
+/**
+ * @brief  获取CLOCK_MONOTONIC当前时间
+ * @return 当前时间, 单位: ns
+ */
+static uint64_t gpio_group_now_ns(void)
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  读取一个value文件描述符的电平值
+ * @param  value: 输出参数, 电平值
+ * @param  fd   : 输入参数, value文件描述符
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_read_fd(gpio_value_e *value, const int fd)
+{
+    char ch = 0;
+
+    // 使用pread从头读取, 省去lseek
+    if (1 != pread(fd, &ch, 1, 0))
+    {
+        return false;
+    }
+
+    switch (ch)
+    {
+    case '0':
+    {
+        *value = E_GPIO_LOW;
+
+        break;
+    }
+
+    case '1':
+    {
+        *value = E_GPIO_HIGH;
+
+        break;
+    }
+
+    default:
+    {
+        return false;
+    }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  查找芯片内偏移在组内的序号
+ * @param  group : 输入参数, GPIO组
+ * @param  offset: 输入参数, 芯片内偏移
+ * @return 成功: 组内序号
+ *         失败: -1
+ */
+static int gpio_group_find_index(const gpio_group_t *group, const uint32_t offset)
+{
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        if (offset == group->gpio_nums[i])
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief  获取组内GPIO的触发边沿
+ * @param  group: 输入参数, GPIO组
+ * @param  index: 输入参数, 组内序号
+ * @return 触发边沿
+ */
+static gpio_edge_e gpio_group_line_edge(const gpio_group_t *group, const uint8_t index)
+{
+    int edge = E_GPIO_NONE;
+
+    if (group->rising_mask & (1ULL << index))
+    {
+        edge |= E_GPIO_RISING;
+    }
+
+    if (group->falling_mask & (1ULL << index))
+    {
+        edge |= E_GPIO_FALLING;
+    }
+
+    return (gpio_edge_e)edge;
+}
+
+/**
+ * @brief  使用sysfs后端打开GPIO组
+ * @param  group : 输入输出参数, GPIO组, 已填写GPIO编号
+ * @param  config: 输入参数, GPIO组配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_open_sysfs(gpio_group_t *group, const gpio_group_config_t *config)
+{
+    char cmd_buf[CMD_BUF_MAX_LEN] = {0};
+    gpio_value_e value = E_GPIO_LOW;
+
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        if (!gpio_export(group->gpio_nums[i]))
+        {
+            return false;
+        }
+
+        // 输出GPIO在切换方向时同时设置初始电平, 避免先输出低电平产生毛刺
+        if (!((E_GPIO_OUT == config->direction)
+                  ? gpio_set_output(group->gpio_nums[i], ((config->init_values >> i) & 1) ? E_GPIO_HIGH : E_GPIO_LOW)
+                  : gpio_set_direction(group->gpio_nums[i], config->direction)))
+        {
+            return false;
+        }
+
+        if (E_GPIO_IN == config->direction)
+        {
+            if (!gpio_set_edge(group->gpio_nums[i], gpio_group_line_edge(group, i)))
+            {
+                return false;
+            }
+        }
+
+        // 打开文件: /sys/class/gpio/gpiox/value, 保持到关闭GPIO组
+        memset(cmd_buf, 0, sizeof(cmd_buf));
+        snprintf(cmd_buf, sizeof(cmd_buf), "%s/gpio%d/value", SYS_GPIO_DIR, group->gpio_nums[i]);
+        group->value_fds[i] =
+            open(cmd_buf, ((E_GPIO_OUT == config->direction) ? O_RDWR : O_RDONLY) | O_NONBLOCK | O_CLOEXEC);
+        if (group->value_fds[i] < 0)
+        {
+            return false;
+        }
+
+        // 输入GPIO先读一次, 清除打开后默认挂起的POLLPRI
+        if (E_GPIO_IN == config->direction)
+        {
+            if (!gpio_group_read_fd(&value, group->value_fds[i]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  按方向和边沿生成uAPI v2的line config, 默认输入, 输出和各种边沿分别一个属性
+ * @param  config     : 输出参数, line config
+ * @param  group      : 输入参数, GPIO组
+ * @param  output_mask: 输入参数, 输出GPIO掩码
+ * @param  values     : 输入参数, 输出电平值
+ */
+static void gpio_group_fill_v2_config(struct gpio_v2_line_config *config, const gpio_group_t *group,
+                                      const uint64_t output_mask, const uint64_t values)
+{
+    struct gpio_v2_line_config_attribute *attr = NULL;
+    uint64_t mask = 0;
+
+    memset(config, 0, sizeof(struct gpio_v2_line_config));
+    config->flags = GPIO_V2_LINE_FLAG_INPUT;
+
+    // 边沿相同的GPIO共用一个属性, 一个请求内可以混合不同边沿
+    for (int edge = E_GPIO_RISING; edge <= E_GPIO_BOTH; edge++)
+    {
+        mask = ((edge & E_GPIO_RISING) ? group->rising_mask : ~group->rising_mask) &
+               ((edge & E_GPIO_FALLING) ? group->falling_mask : ~group->falling_mask) & ~output_mask;
+        if (0 == mask)
+        {
+            continue;
+        }
+
+        attr = &config->attrs[config->num_attrs++];
+        attr->attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+        attr->attr.flags = GPIO_V2_LINE_FLAG_INPUT;
+        if (edge & E_GPIO_RISING)
+        {
+            attr->attr.flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+        }
+
+        if (edge & E_GPIO_FALLING)
+        {
+            attr->attr.flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+        }
+
+        attr->mask = mask;
+    }
+
+    if (0 == output_mask)
+    {
+        return;
+    }
+
+    attr = &config->attrs[config->num_attrs++];
+    attr->attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+    attr->attr.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+    attr->mask = output_mask;
+
+    attr = &config->attrs[config->num_attrs++];
+    attr->attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+    attr->attr.values = values;
+    attr->mask = output_mask;
+}
+
+/**
+ * @brief  使用GPIO字符设备uAPI v2后端打开GPIO组, 全部GPIO在一个line request中
+ * @param  group  : 输入输出参数, GPIO组, 已填写芯片内偏移
+ * @param  chip_fd: 输入参数, GPIO芯片文件描述符
+ * @param  config : 输入参数, GPIO组配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_open_cdev_v2(gpio_group_t *group, const int chip_fd, const gpio_group_config_t *config)
+{
+    struct gpio_v2_line_request req = {0};
+
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        req.offsets[i] = group->gpio_nums[i];
+    }
+
+    req.num_lines = group->num;
+    snprintf(req.consumer, sizeof(req.consumer), "%s",
+             config->consumer ? config->consumer : GPIO_GROUP_DEFAULT_CONSUMER);
+    gpio_group_fill_v2_config(&req.config, group, group->output_mask, config->init_values);
+    if (E_GPIO_IN == config->direction)
+    {
+        req.event_buffer_size = config->event_buffer_size;
+    }
+
+    if (-1 == ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req))
+    {
+        return false;
+    }
+
+    group->req_fd = req.fd;
+    group->values = config->init_values;
+
+    return true;
+}
+
+/**
+ * @brief  使用GPIO字符设备uAPI v1后端打开GPIO组
+ * @note   v1的边沿事件只能逐个GPIO申请, 因此带边沿的输入组每个GPIO一个文件描述符
+ *         (检测边沿的为事件文件描述符, 其余为单独的line handle), 其余情况全部GPIO在一个line handle中
+ * @param  group  : 输入输出参数, GPIO组, 已填写芯片内偏移
+ * @param  chip_fd: 输入参数, GPIO芯片文件描述符
+ * @param  config : 输入参数, GPIO组配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_open_cdev_v1(gpio_group_t *group, const int chip_fd, const gpio_group_config_t *config)
+{
+    struct gpiohandle_request handle_req = {0};
+    struct gpioevent_request event_req = {0};
+    const char *consumer = config->consumer ? config->consumer : GPIO_GROUP_DEFAULT_CONSUMER;
+
+    if ((E_GPIO_IN == config->direction) && (E_GPIO_NONE != group->edge))
+    {
+        for (uint8_t i = 0; i < group->num; i++)
+        {
+            // 不检测边沿的GPIO单独申请line handle, 用于获取电平
+            if (E_GPIO_NONE == gpio_group_line_edge(group, i))
+            {
+                memset(&handle_req, 0, sizeof(handle_req));
+                handle_req.lineoffsets[0] = group->gpio_nums[i];
+                handle_req.lines = 1;
+                handle_req.flags = GPIOHANDLE_REQUEST_INPUT;
+                snprintf(handle_req.consumer_label, sizeof(handle_req.consumer_label), "%s", consumer);
+                if (-1 == ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &handle_req))
+                {
+                    return false;
+                }
+
+                group->value_fds[i] = handle_req.fd;
+
+                continue;
+            }
+
+            memset(&event_req, 0, sizeof(event_req));
+            event_req.lineoffset = group->gpio_nums[i];
+            event_req.handleflags = GPIOHANDLE_REQUEST_INPUT;
+            event_req.eventflags = 0;
+            if (group->rising_mask & (1ULL << i))
+            {
+                event_req.eventflags |= GPIOEVENT_REQUEST_RISING_EDGE;
+            }
+
+            if (group->falling_mask & (1ULL << i))
+            {
+                event_req.eventflags |= GPIOEVENT_REQUEST_FALLING_EDGE;
+            }
+
+            snprintf(event_req.consumer_label, sizeof(event_req.consumer_label), "%s", consumer);
+            if (-1 == ioctl(chip_fd, GPIO_GET_LINEEVENT_IOCTL, &event_req))
+            {
+                return false;
+            }
+
+            group->value_fds[i] = event_req.fd;
+        }
+
+        return true;
+    }
+
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        handle_req.lineoffsets[i] = group->gpio_nums[i];
+        handle_req.default_values[i] = (config->init_values >> i) & 1;
+    }
+
+    handle_req.lines = group->num;
+    handle_req.flags = (E_GPIO_OUT == config->direction) ? GPIOHANDLE_REQUEST_OUTPUT : GPIOHANDLE_REQUEST_INPUT;
+    snprintf(handle_req.consumer_label, sizeof(handle_req.consumer_label), "%s", consumer);
+    if (-1 == ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &handle_req))
+    {
+        return false;
+    }
+
+    group->req_fd = handle_req.fd;
+    group->values = config->init_values;
+
+    return true;
+}
+
+/**
+ * @brief  使用GPIO字符设备后端打开GPIO组, 自动选择时优先v2, 内核不支持v2时回退到v1
+ * @param  group : 输入输出参数, GPIO组, 已填写芯片内偏移
+ * @param  config: 输入参数, GPIO组配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_open_cdev(gpio_group_t *group, const gpio_group_config_t *config)
+{
+    int chip_fd = -1;
+    bool ret = false;
+
+    chip_fd = open(config->chip, O_RDWR | O_CLOEXEC);
+    if (chip_fd < 0)
+    {
+        return false;
+    }
+
+    if ((E_GPIO_BACKEND_AUTO == config->backend) || (E_GPIO_BACKEND_CDEV_V2 == config->backend))
+    {
+        group->backend = E_GPIO_BACKEND_CDEV_V2;
+        ret = gpio_group_open_cdev_v2(group, chip_fd, config);
+
+        // 5.10之前的内核不认识v2的ioctl, 返回ENOTTY或EINVAL
+        if ((!ret) && (E_GPIO_BACKEND_AUTO == config->backend) && ((ENOTTY == errno) || (EINVAL == errno)))
+        {
+            group->backend = E_GPIO_BACKEND_CDEV_V1;
+            ret = gpio_group_open_cdev_v1(group, chip_fd, config);
+        }
+    }
+    else if (E_GPIO_BACKEND_CDEV_V1 == config->backend)
+    {
+        group->backend = E_GPIO_BACKEND_CDEV_V1;
+        ret = gpio_group_open_cdev_v1(group, chip_fd, config);
+    }
+
+    // line request/handle持有独立的文件描述符, 芯片文件描述符不再需要
+    close(chip_fd);
+
+    return ret;
+}
+
+/**
+ * @brief  准备字符设备后端的事件读取: 事件文件描述符设为非阻塞, 分配按缓存行对齐的批量读取缓冲区
+ * @param  group: 输入参数, GPIO组
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_prepare_events(gpio_group_t *group)
+{
+    gpio_group_event_fd_t fds[GPIO_GROUP_MAX_NUM] = {0};
+    uint8_t num = gpio_group_get_event_fds(fds, group);
+    int flags = 0;
+
+    for (uint8_t i = 0; i < num; i++)
+    {
+        flags = fcntl(fds[i].fd, F_GETFL);
+        if ((-1 == flags) || (-1 == fcntl(fds[i].fd, F_SETFL, flags | O_NONBLOCK)))
+        {
+            return false;
+        }
+    }
+
+    // v2事件比v1大, 按v2分配, 两种后端共用
+    if (0 != posix_memalign(&group->event_buf, GPIO_GROUP_EVENT_BUF_ALIGN,
+                            GPIO_GROUP_EVENT_BATCH_MAX * sizeof(struct gpio_v2_line_event)))
+    {
+        group->event_buf = NULL;
+
+        return false;
+    }
+
+    group->batch_size = GPIO_GROUP_EVENT_BATCH_MIN;
+
+    return true;
+}
+
+/**
+ * @brief  打开GPIO组: 按配置选择后端并申请GPIO, 设置方向/边沿, 保持文件描述符
+ * @note   字符设备后端一次申请全部GPIO, 批量设置/获取只需一次ioctl
+ * @param  group    : 输出参数, 打开的GPIO组
+ * @param  gpio_nums: 输入参数, 组内GPIO编号, sysfs后端为全局编号, 字符设备后端为芯片内偏移
+ * @param  num      : 输入参数, 组内GPIO数量, 取值范围[1, GPIO_GROUP_MAX_NUM]
+ * @param  config   : 输入参数, GPIO组配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_open(gpio_group_t *group, const uint16_t *gpio_nums, const uint8_t num,
+                     const gpio_group_config_t *config)
+{
+    bool ret = false;
+    int err = 0;
+    gpio_edge_e edge = E_GPIO_NONE;
+
+    if ((!group) || (!gpio_nums) || (!config) || (0 == num) || (num > GPIO_GROUP_MAX_NUM))
+    {
+        return false;
+    }
+
+    memset(group, 0, sizeof(gpio_group_t));
+    group->num = num;
+    group->req_fd = -1;
+    group->direction = config->direction;
+    if (E_GPIO_OUT == config->direction)
+    {
+        group->output_mask = (GPIO_GROUP_MAX_NUM == num) ? UINT64_MAX : ((1ULL << num) - 1);
+    }
+
+    for (uint8_t i = 0; i < num; i++)
+    {
+        group->gpio_nums[i] = gpio_nums[i];
+        group->value_fds[i] = -1;
+
+        if (E_GPIO_IN == config->direction)
+        {
+            edge = config->line_edges ? config->line_edges[i] : config->edge;
+            if (edge & E_GPIO_RISING)
+            {
+                group->rising_mask |= (1ULL << i);
+            }
+
+            if (edge & E_GPIO_FALLING)
+            {
+                group->falling_mask |= (1ULL << i);
+            }
+        }
+    }
+
+    group->edge = (gpio_edge_e)(((0 != group->rising_mask) ? E_GPIO_RISING : E_GPIO_NONE) |
+                                ((0 != group->falling_mask) ? E_GPIO_FALLING : E_GPIO_NONE));
+
+    if (E_GPIO_BACKEND_VIRTUAL == config->backend)
+    {
+        // 虚拟后端不支持边沿事件
+        group->backend = E_GPIO_BACKEND_VIRTUAL;
+        group->ops = config->ops;
+        group->ops_arg = config->ops_arg;
+        group->values = config->init_values;
+        ret = ((config->ops) && (config->ops->set_values) && (config->ops->get_values) &&
+               (E_GPIO_NONE == group->edge));
+        if ((ret) && (0 != group->output_mask))
+        {
+            ret = config->ops->set_values(config->ops_arg, group->output_mask, config->init_values);
+        }
+    }
+    else if (config->adopt_fd)
+    {
+        // 接管已申请的line request, 不再访问GPIO芯片
+        ret = ((E_GPIO_BACKEND_CDEV_V2 == config->backend) && (config->request_fd >= 0));
+        if (ret)
+        {
+            group->backend = E_GPIO_BACKEND_CDEV_V2;
+            group->req_fd = config->request_fd;
+            group->values = config->init_values;
+        }
+        else
+        {
+            errno = EINVAL;
+        }
+    }
+    else if (config->chip)
+    {
+        ret = gpio_group_open_cdev(group, config);
+    }
+    else if ((E_GPIO_BACKEND_AUTO == config->backend) || (E_GPIO_BACKEND_SYSFS == config->backend))
+    {
+        group->backend = E_GPIO_BACKEND_SYSFS;
+        ret = gpio_group_open_sysfs(group, config);
+        if ((ret) && (E_GPIO_OUT == config->direction))
+        {
+            // 强制写入全部初始电平
+            group->values = ~config->init_values;
+            ret = gpio_group_set_values(group, UINT64_MAX, config->init_values);
+        }
+    }
+
+    // 检测边沿的字符设备后端: 事件文件描述符设为非阻塞, 并分配批量读取缓冲区
+    if ((ret) && ((E_GPIO_BACKEND_CDEV_V2 == group->backend) || (E_GPIO_BACKEND_CDEV_V1 == group->backend)) &&
+        (E_GPIO_NONE != group->edge))
+    {
+        ret = gpio_group_prepare_events(group);
+    }
+
+    if (!ret)
+    {
+        err = errno;
+        gpio_group_close(group);
+        errno = err;
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  关闭GPIO组
+ * @param  group: 输入参数, 待关闭的GPIO组
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_close(gpio_group_t *group)
+{
+    bool result = true;
+
+    if (!group)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        if (group->value_fds[i] >= 0)
+        {
+            if (0 != close(group->value_fds[i]))
+            {
+                result = false;
+            }
+
+            group->value_fds[i] = -1;
+        }
+    }
+
+    if (group->req_fd >= 0)
+    {
+        if (0 != close(group->req_fd))
+        {
+            result = false;
+        }
+
+        group->req_fd = -1;
+    }
+
+    free(group->event_buf);
+    group->event_buf = NULL;
+
+    group->num = 0;
+
+    return result;
+}
+
+/**
+ * @brief  切换sysfs后端一个GPIO的方向, value文件按新方向重新打开
+ * @param  group    : 输入参数, GPIO组
+ * @param  index    : 输入参数, 组内序号
+ * @param  direction: 输入参数, 目标方向
+ * @param  value    : 输入参数, 切换为输出时的电平值
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_set_sysfs_direction(gpio_group_t *group, const uint8_t index, const gpio_direction_e direction,
+                                           const bool value)
+{
+    char cmd_buf[CMD_BUF_MAX_LEN] = {0};
+
+    // 输出时方向和电平一次写入, 避免先输出低电平产生毛刺
+    if (!((E_GPIO_OUT == direction) ? gpio_set_output(group->gpio_nums[index], value ? E_GPIO_HIGH : E_GPIO_LOW)
+                                    : gpio_set_direction(group->gpio_nums[index], direction)))
+    {
+        return false;
+    }
+
+    close(group->value_fds[index]);
+    snprintf(cmd_buf, sizeof(cmd_buf), "%s/gpio%d/value", SYS_GPIO_DIR, group->gpio_nums[index]);
+    group->value_fds[index] =
+        open(cmd_buf, ((E_GPIO_OUT == direction) ? O_RDWR : O_RDONLY) | O_NONBLOCK | O_CLOEXEC);
+    if (group->value_fds[index] < 0)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  切换GPIO方向(如双向数据线), 不重新申请GPIO
+ * @note   uAPI v2后端一次ioctl(GPIO_V2_LINE_SET_CONFIG_IOCTL)完成; uAPI v1后端只能整组切换;
+ *         uAPI v2后端检测边沿的GPIO为输出时暂停边沿检测, 切换回输入时恢复, 其他后端不能切换为输出
+ * @param  group    : 输入参数, GPIO组
+ * @param  mask     : 输入参数, 待切换的GPIO掩码, bit i对应组内第i个GPIO
+ * @param  direction: 输入参数, 目标方向
+ * @param  values   : 输入参数, 切换为输出时的电平值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_set_direction(gpio_group_t *group, const uint64_t mask, const gpio_direction_e direction,
+                              const uint64_t values)
+{
+    uint64_t all = 0;
+    uint64_t lines = 0;
+    uint64_t output_mask = 0;
+    uint64_t new_values = 0;
+    struct gpio_v2_line_config v2_config = {0};
+    struct gpiohandle_config v1_config = {0};
+
+    if ((!group) || (0 == group->num))
+    {
+        return false;
+    }
+
+    all = (GPIO_GROUP_MAX_NUM == group->num) ? UINT64_MAX : ((1ULL << group->num) - 1);
+    lines = mask & all;
+    output_mask = (E_GPIO_OUT == direction) ? (group->output_mask | lines) : (group->output_mask & ~lines);
+    new_values = (group->values & ~lines) | (values & lines);
+    if (output_mask == group->output_mask)
+    {
+        return true;
+    }
+
+    // 检测边沿的GPIO只有uAPI v2可以作为输出(同一次配置中去掉边沿标志)
+    if ((E_GPIO_BACKEND_CDEV_V2 != group->backend) && (output_mask & (group->rising_mask | group->falling_mask)))
+    {
+        errno = EINVAL;
+
+        return false;
+    }
+
+    switch (group->backend)
+    {
+    case E_GPIO_BACKEND_CDEV_V2:
+    {
+        gpio_group_fill_v2_config(&v2_config, group, output_mask, new_values);
+        if (-1 == ioctl(group->req_fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &v2_config))
+        {
+            return false;
+        }
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_CDEV_V1:
+    {
+        // v1的line handle配置作用于全部GPIO
+        if ((group->req_fd < 0) || ((0 != output_mask) && (all != output_mask)))
+        {
+            errno = ENOTSUP;
+
+            return false;
+        }
+
+        v1_config.flags = (0 != output_mask) ? GPIOHANDLE_REQUEST_OUTPUT : GPIOHANDLE_REQUEST_INPUT;
+        for (uint8_t i = 0; i < group->num; i++)
+        {
+            v1_config.default_values[i] = (new_values >> i) & 1;
+        }
+
+        if (-1 == ioctl(group->req_fd, GPIOHANDLE_SET_CONFIG_IOCTL, &v1_config))
+        {
+            return false;
+        }
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_SYSFS:
+    {
+        for (uint8_t i = 0; i < group->num; i++)
+        {
+            if (((output_mask ^ group->output_mask) & (1ULL << i)) &&
+                (!gpio_group_set_sysfs_direction(group, i, direction, (new_values >> i) & 1)))
+            {
+                return false;
+            }
+        }
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_VIRTUAL:
+    {
+        if ((group->ops->set_direction) && (!group->ops->set_direction(group->ops_arg, output_mask)))
+        {
+            return false;
+        }
+
+        if ((E_GPIO_OUT == direction) && (!group->ops->set_values(group->ops_arg, lines, new_values)))
+        {
+            return false;
+        }
+
+        break;
+    }
+
+    default:
+    {
+        return false;
+    }
+    }
+
+    group->output_mask = output_mask;
+    group->values = new_values;
+
+    return true;
+}
+
+/**
+ * @brief  批量设置GPIO组输出电平值, 掩码中的输入GPIO被忽略
+ * @param  group : 输入参数, GPIO组
+ * @param  mask  : 输入参数, 待设置的GPIO掩码, bit i对应组内第i个GPIO
+ * @param  values: 输入参数, 待设置的电平值, bit i对应组内第i个GPIO
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_set_values(gpio_group_t *group, const uint64_t mask, const uint64_t values)
+{
+    uint64_t changed = 0;
+    struct gpio_v2_line_values v2_values = {0};
+    struct gpiohandle_data v1_data = {0};
+
+    if ((!group) || (0 == group->output_mask))
+    {
+        return false;
+    }
+
+    // 只写入电平有变化的输出GPIO
+    changed = (group->values ^ values) & mask & group->output_mask;
+    if (0 == changed)
+    {
+        return true;
+    }
+
+    switch (group->backend)
+    {
+    case E_GPIO_BACKEND_CDEV_V2:
+    {
+        v2_values.mask = changed;
+        v2_values.bits = values;
+        if (-1 == ioctl(group->req_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &v2_values))
+        {
+            return false;
+        }
+
+        group->values ^= changed;
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_CDEV_V1:
+    {
+        // v1每次设置全部GPIO, 未变化的GPIO沿用上次输出的电平
+        for (uint8_t i = 0; i < group->num; i++)
+        {
+            v1_data.values[i] = ((group->values ^ changed) >> i) & 1;
+        }
+
+        if (-1 == ioctl(group->req_fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &v1_data))
+        {
+            return false;
+        }
+
+        group->values ^= changed;
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_VIRTUAL:
+    {
+        if (!group->ops->set_values(group->ops_arg, changed, values))
+        {
+            return false;
+        }
+
+        group->values ^= changed;
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_SYSFS:
+    {
+        for (uint8_t i = 0; i < group->num; i++)
+        {
+            if (!(changed & (1ULL << i)))
+            {
+                continue;
+            }
+
+            if (1 != pwrite(group->value_fds[i], ((values >> i) & 1) ? "1" : "0", 1, 0))
+            {
+                return false;
+            }
+
+            group->values ^= (1ULL << i);
+        }
+
+        break;
+    }
+
+    default:
+    {
+        return false;
+    }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  批量获取GPIO组电平值
+ * @param  values: 输出参数, 获取到的电平值, bit i对应组内第i个GPIO, 未在掩码中的位为0
+ * @param  group : 输入参数, GPIO组
+ * @param  mask  : 输入参数, 待获取的GPIO掩码, bit i对应组内第i个GPIO
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_get_values(uint64_t *values, gpio_group_t *group, const uint64_t mask)
+{
+    uint64_t result = 0;
+    gpio_value_e value = E_GPIO_LOW;
+    struct gpio_v2_line_values v2_values = {0};
+    struct gpiohandle_data v1_data = {0};
+
+    if ((!values) || (!group))
+    {
+        return false;
+    }
+
+    switch (group->backend)
+    {
+    case E_GPIO_BACKEND_CDEV_V2:
+    {
+        v2_values.mask = mask;
+        if (-1 == ioctl(group->req_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &v2_values))
+        {
+            return false;
+        }
+
+        result = v2_values.bits & mask;
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_CDEV_V1:
+    {
+        // 全部GPIO在一个line handle中时一次获取
+        if (group->req_fd >= 0)
+        {
+            if (-1 == ioctl(group->req_fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &v1_data))
+            {
+                return false;
+            }
+
+            for (uint8_t i = 0; i < group->num; i++)
+            {
+                if ((mask & (1ULL << i)) && (v1_data.values[i]))
+                {
+                    result |= (1ULL << i);
+                }
+            }
+
+            break;
+        }
+
+        // 每个GPIO一个事件文件描述符时逐个获取
+        for (uint8_t i = 0; i < group->num; i++)
+        {
+            if (!(mask & (1ULL << i)))
+            {
+                continue;
+            }
+
+            if (-1 == ioctl(group->value_fds[i], GPIOHANDLE_GET_LINE_VALUES_IOCTL, &v1_data))
+            {
+                return false;
+            }
+
+            if (v1_data.values[0])
+            {
+                result |= (1ULL << i);
+            }
+        }
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_VIRTUAL:
+    {
+        if (!group->ops->get_values(group->ops_arg, mask, &result))
+        {
+            return false;
+        }
+
+        result &= mask;
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_SYSFS:
+    {
+        for (uint8_t i = 0; i < group->num; i++)
+        {
+            if (!(mask & (1ULL << i)))
+            {
+                continue;
+            }
+
+            if (!gpio_group_read_fd(&value, group->value_fds[i]))
+            {
+                return false;
+            }
+
+            if (E_GPIO_HIGH == value)
+            {
+                result |= (1ULL << i);
+            }
+        }
+
+        break;
+    }
+
+    default:
+    {
+        return false;
+    }
+    }
+
+    *values = result;
+
+    return true;
+}
+
+/**
+ * @brief  根据一次读取的突发大小调整每次read()读取的事件个数
+ * @param  group: 输入参数, GPIO组
+ * @param  burst: 输入参数, 本次读取到的事件个数
+ */
+static void gpio_group_adapt_batch(gpio_group_t *group, const uint32_t burst)
+{
+    uint32_t target = 0;
+    uint32_t batch = GPIO_GROUP_EVENT_BATCH_MIN;
+
+    // 突发大小的指数滑动平均(新值权重1/8), 放大16倍保存
+    group->burst_avg_x16 = group->burst_avg_x16 - (group->burst_avg_x16 >> 3) + (burst << 1);
+
+    // 每次读取平均突发大小的2倍, 向上取2的幂
+    target = group->burst_avg_x16 >> 3;
+    while ((batch < target) && (batch < GPIO_GROUP_EVENT_BATCH_MAX))
+    {
+        batch <<= 1;
+    }
+
+    group->batch_size = batch;
+}
+
+/**
+ * @brief  转换uAPI v2事件, 并根据序号统计丢失的事件
+ * @param  event: 输出参数, 边沿事件
+ * @param  group: 输入参数, GPIO组
+ * @param  raw  : 输入参数, 内核事件
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_group_convert_v2_event(gpio_event_t *event, gpio_group_t *group,
+                                        const struct gpio_v2_line_event *raw)
+{
+    int index = gpio_group_find_index(group, raw->offset);
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    event->index = (uint8_t)index;
+    event->edge = (GPIO_V2_LINE_EVENT_RISING_EDGE == raw->id) ? E_GPIO_RISING : E_GPIO_FALLING;
+    event->timestamp_ns = raw->timestamp_ns;
+    event->seqno = raw->seqno;
+    event->line_seqno = raw->line_seqno;
+
+    // 序号从1开始连续递增, 出现间隔说明内核事件缓冲区溢出丢弃了事件
+    event->lost = raw->line_seqno - group->line_seqnos[index] - 1;
+    event->count = 1;
+    group->line_seqnos[index] = raw->line_seqno;
+    group->lost_count += raw->seqno - group->last_seqno - 1;
+    group->last_seqno = raw->seqno;
+
+    return true;
+}
+
+/**
+ * @brief  获取GPIO组的事件文件描述符, 用于poll/epoll
+ * @param  fds  : 输出参数, 事件文件描述符, 至少GPIO_GROUP_MAX_NUM个元素
+ * @param  group: 输入参数, GPIO组
+ * @return 事件文件描述符个数, 未检测边沿时为0
+ */
+uint8_t gpio_group_get_event_fds(gpio_group_event_fd_t *fds, const gpio_group_t *group)
+{
+    uint8_t num = 0;
+
+    if ((!fds) || (!group) || (E_GPIO_IN != group->direction) || (E_GPIO_NONE == group->edge))
+    {
+        return 0;
+    }
+
+    // v2的全部边沿事件都在一个line request文件描述符上
+    if (E_GPIO_BACKEND_CDEV_V2 == group->backend)
+    {
+        fds[0].fd = group->req_fd;
+        fds[0].index = 0;
+        fds[0].events = POLLIN;
+
+        return 1;
+    }
+
+    // sysfs和v1每个检测边沿的GPIO一个文件描述符, sysfs的边沿通过POLLPRI通知
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        if (E_GPIO_NONE != gpio_group_line_edge(group, i))
+        {
+            fds[num].fd = group->value_fds[i];
+            fds[num].index = i;
+            fds[num].events = (E_GPIO_BACKEND_SYSFS == group->backend) ? (POLLPRI | POLLERR) : POLLIN;
+            num++;
+        }
+    }
+
+    return num;
+}
+
+/**
+ * @brief  从就绪的事件文件描述符批量读取边沿事件
+ * @param  events: 输出参数, 边沿事件, 至少max个元素
+ * @param  max   : 输入参数, 最多读取的事件个数
+ * @param  group : 输入参数, GPIO组
+ * @param  fd    : 输入参数, 就绪的事件文件描述符(由gpio_group_get_event_fds获取)
+ * @return 成功: 读取到的事件个数, 没有待读取的事件时为0
+ *         失败: -1
+ */
+int gpio_group_read_events(gpio_event_t *events, const uint32_t max, gpio_group_t *group,
+                           const gpio_group_event_fd_t *fd)
+{
+    ssize_t len = 0;
+    uint32_t count = 0;
+    uint32_t batch = 0;
+    uint32_t got = 0;
+    gpio_value_e value = E_GPIO_LOW;
+    const struct gpio_v2_line_event *v2_events = NULL;
+    const struct gpioevent_data *v1_events = NULL;
+
+    if ((!events) || (!group) || (!fd) || (0 == max))
+    {
+        return -1;
+    }
+
+    switch (group->backend)
+    {
+    case E_GPIO_BACKEND_CDEV_V2:
+    case E_GPIO_BACKEND_CDEV_V1:
+    {
+        // 一次read()读取多个事件, 读满说明内核中可能还有事件, 继续读取
+        while (count < max)
+        {
+            batch = (max - count < group->batch_size) ? (max - count) : group->batch_size;
+            if (E_GPIO_BACKEND_CDEV_V2 == group->backend)
+            {
+                len = read(fd->fd, group->event_buf, batch * sizeof(struct gpio_v2_line_event));
+            }
+            else
+            {
+                len = read(fd->fd, group->event_buf, batch * sizeof(struct gpioevent_data));
+            }
+
+            if (len < 0)
+            {
+                if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+                {
+                    break;
+                }
+
+                return -1;
+            }
+
+            group->read_count++;
+            if (E_GPIO_BACKEND_CDEV_V2 == group->backend)
+            {
+                v2_events = (const struct gpio_v2_line_event *)group->event_buf;
+                got = (uint32_t)len / sizeof(struct gpio_v2_line_event);
+                for (uint32_t i = 0; i < got; i++)
+                {
+                    if (gpio_group_convert_v2_event(&events[count], group, &v2_events[i]))
+                    {
+                        count++;
+                    }
+                }
+            }
+            else
+            {
+                v1_events = (const struct gpioevent_data *)group->event_buf;
+                got = (uint32_t)len / sizeof(struct gpioevent_data);
+                for (uint32_t i = 0; i < got; i++)
+                {
+                    events[count].index = fd->index;
+                    events[count].edge =
+                        (GPIOEVENT_EVENT_RISING_EDGE == v1_events[i].id) ? E_GPIO_RISING : E_GPIO_FALLING;
+                    events[count].timestamp_ns = v1_events[i].timestamp;
+                    events[count].seqno = 0;
+                    events[count].line_seqno = 0;
+                    events[count].lost = 0;
+                    events[count].count = 1;
+                    count++;
+                }
+            }
+
+            if (got < batch)
+            {
+                break;
+            }
+
+            // 本次读满, 突发比预期大, 直接加大后续读取个数
+            if (group->batch_size < GPIO_GROUP_EVENT_BATCH_MAX)
+            {
+                group->batch_size <<= 1;
+            }
+        }
+
+        gpio_group_adapt_batch(group, count);
+
+        break;
+    }
+
+    case E_GPIO_BACKEND_SYSFS:
+    {
+        // sysfs没有内核时间戳, 在读取时打上时间戳
+        events[0].timestamp_ns = gpio_group_now_ns();
+        if (!gpio_group_read_fd(&value, fd->fd))
+        {
+            return -1;
+        }
+
+        group->read_count++;
+        events[0].index = fd->index;
+        events[0].edge = (E_GPIO_HIGH == value) ? E_GPIO_RISING : E_GPIO_FALLING;
+        events[0].seqno = 0;
+        events[0].line_seqno = 0;
+        events[0].lost = 0;
+        events[0].count = 1;
+        count = 1;
+
+        break;
+    }
+
+    default:
+    {
+        return -1;
+    }
+    }
+
+    group->event_count += count;
+
+    return (int)count;
+}
+
+/**
+ * @brief  等待GPIO组内任意GPIO产生边沿事件
+ * @param  event     : 输出参数, 边沿事件
+ * @param  group     : 输入参数, GPIO组
+ * @param  timeout_ms: 输入参数, 超时时间, 单位: ms, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_group_wait_event(gpio_event_t *event, gpio_group_t *group, const int timeout_ms)
+{
+    return gpio_group_wait_any(event, group, UINT64_MAX, E_GPIO_BOTH,
+                               (timeout_ms < 0) ? -1 : ((int64_t)timeout_ms * 1000000LL));
+}
+
+/**
+ * @brief  等待掩码中任意一个GPIO产生指定边沿, 返回最先到达的事件
+ * @note   使用ppoll, 超时精度为纳秒; 等待期间读到的不匹配事件(其他GPIO或其他边沿)被丢弃
+ * @param  event     : 输出参数, 边沿事件(含时间戳)
+ * @param  group     : 输入参数, GPIO组
+ * @param  mask      : 输入参数, 等待的GPIO掩码, bit i对应组内第i个GPIO
+ * @param  edge      : 输入参数, 等待的边沿, E_GPIO_RISING/E_GPIO_FALLING/E_GPIO_BOTH
+ * @param  timeout_ns: 输入参数, 超时时间, 单位: ns, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_group_wait_any(gpio_event_t *event, gpio_group_t *group, const uint64_t mask, const gpio_edge_e edge,
+                         const int64_t timeout_ns)
+{
+    int ret = -1;
+    gpio_group_event_fd_t all_fds[GPIO_GROUP_MAX_NUM] = {0};
+    gpio_group_event_fd_t event_fds[GPIO_GROUP_MAX_NUM] = {0};
+    struct pollfd fds[GPIO_GROUP_MAX_NUM] = {0};
+    uint8_t all_num = 0;
+    nfds_t nfds = 0;
+    int64_t deadline_ns = 0;
+    int64_t remain_ns = 0;
+    struct timespec ts = {0};
+    gpio_event_t tmp = {0};
+
+    if ((!event) || (!group) || (E_GPIO_NONE == edge))
+    {
+        return false;
+    }
+
+    // v2只有一个文件描述符; sysfs和v1只等待掩码中的GPIO
+    all_num = gpio_group_get_event_fds(all_fds, group);
+    for (uint8_t i = 0; i < all_num; i++)
+    {
+        if ((E_GPIO_BACKEND_CDEV_V2 == group->backend) || (mask & (1ULL << all_fds[i].index)))
+        {
+            event_fds[nfds] = all_fds[i];
+            fds[nfds].fd = all_fds[i].fd;
+            fds[nfds].events = all_fds[i].events;
+            nfds++;
+        }
+    }
+
+    if (0 == nfds)
+    {
+        return false;
+    }
+
+    deadline_ns = (int64_t)gpio_group_now_ns() + timeout_ns;
+    while (true)
+    {
+        if (timeout_ns >= 0)
+        {
+            remain_ns = deadline_ns - (int64_t)gpio_group_now_ns();
+            if (remain_ns < 0)
+            {
+                remain_ns = 0;
+            }
+
+            ts.tv_sec = remain_ns / 1000000000LL;
+            ts.tv_nsec = remain_ns % 1000000000LL;
+        }
+
+        ret = ppoll(fds, nfds, (timeout_ns >= 0) ? &ts : NULL, NULL);
+        if (0 == ret)
+        {
+            errno = ETIMEDOUT;
+
+            return false;
+        }
+        else if (ret < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        for (nfds_t i = 0; i < nfds; i++)
+        {
+            if (!(fds[i].revents & fds[i].events))
+            {
+                continue;
+            }
+
+            // 逐个读取, 读到匹配的事件立即返回, 其余事件留在内核中
+            do
+            {
+                ret = gpio_group_read_events(&tmp, 1, group, &event_fds[i]);
+                if (ret < 0)
+                {
+                    return false;
+                }
+
+                if ((1 == ret) && (mask & (1ULL << tmp.index)) && (tmp.edge & edge))
+                {
+                    *event = tmp;
+
+                    return true;
+                }
+            } while ((1 == ret) && (E_GPIO_BACKEND_SYSFS != group->backend));
+        }
+    }
+}
+
+/**
+ * @brief  等待组内一个GPIO产生指定边沿
+ * @param  event     : 输出参数, 边沿事件(含时间戳)
+ * @param  group     : 输入参数, GPIO组
+ * @param  index     : 输入参数, 组内序号
+ * @param  edge      : 输入参数, 等待的边沿, E_GPIO_RISING/E_GPIO_FALLING/E_GPIO_BOTH
+ * @param  timeout_ns: 输入参数, 超时时间, 单位: ns, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_group_wait_edge(gpio_event_t *event, gpio_group_t *group, const uint8_t index, const gpio_edge_e edge,
+                          const int64_t timeout_ns)
+{
+    if ((!group) || (index >= group->num))
+    {
+        return false;
+    }
+
+    return gpio_group_wait_any(event, group, 1ULL << index, edge, timeout_ns);
+}
@@ -0,0 +1,272 @@
+/**
+ * @file      : gpio_group.h
+ * @brief     : GPIO组(持久句柄, 批量操作)头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 09:12:40
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-18 huenrong        增加GPIO字符设备(uAPI v2/v1)后端
+ *              2026-10-18 huenrong        支持逐个GPIO配置边沿, 增加事件丢失检测
+ *              2026-10-18 huenrong        一次read()批量读取多个事件
+ *              2026-10-18 huenrong        增加纳秒超时的边沿等待接口
+ *              2026-10-18 huenrong        支持逐个GPIO切换方向, 增加虚拟后端
+ *              2026-10-19 huenrong        uAPI v2后端检测边沿的GPIO可以临时切换为输出
+ *              2026-10-19 huenrong        uAPI v2后端可以接管已申请的line request文件描述符
+ *              2026-10-19 huenrong        接管line request文件描述符改为由adopt_fd显式指定
+ *
+ */
+
+#ifndef __GPIO_GROUP_H
+#define __GPIO_GROUP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio.h"
+
+// 一个GPIO组最多包含的GPIO数量(按位操作, 与uint64_t位宽一致)
+#define GPIO_GROUP_MAX_NUM 64
+
+// 每次read()最多读取的事件个数
+#define GPIO_GROUP_EVENT_BATCH_MAX 64
+
+// GPIO组后端
+typedef enum
+{
+    // 自动选择: 指定了GPIO芯片时优先uAPI v2, 内核不支持时回退到uAPI v1; 未指定时使用sysfs
+    E_GPIO_BACKEND_AUTO = 0,
+    // sysfs(/sys/class/gpio), 每个GPIO单独读写
+    E_GPIO_BACKEND_SYSFS = 1,
+    // GPIO字符设备uAPI v2(Linux 5.10+)
+    E_GPIO_BACKEND_CDEV_V2 = 2,
+    // GPIO字符设备uAPI v1(Linux 4.8+)
+    E_GPIO_BACKEND_CDEV_V1 = 3,
+    // 虚拟后端: 电平读写由回调函数实现, 用于协议仿真和基准测试, 不支持边沿事件
+    E_GPIO_BACKEND_VIRTUAL = 4,
+} gpio_backend_e;
+
+// 虚拟后端的回调函数, arg为配置中的ops_arg
+typedef struct
+{
+    // 设置输出电平, mask为输出GPIO中电平有变化的GPIO
+    bool (*set_values)(void *arg, const uint64_t mask, const uint64_t values);
+    // 获取电平
+    bool (*get_values)(void *arg, const uint64_t mask, uint64_t *values);
+    // 方向变化通知, output_mask为变化后的全部输出GPIO, 可以为NULL
+    bool (*set_direction)(void *arg, const uint64_t output_mask);
+} gpio_group_ops_t;
+
+// GPIO组配置
+typedef struct
+{
+    // GPIO芯片设备路径, 如"/dev/gpiochip0", 为NULL时使用sysfs后端
+    const char *chip;
+    // 后端, 一般使用E_GPIO_BACKEND_AUTO
+    gpio_backend_e backend;
+    // 申请GPIO时的使用者标签, 为NULL时使用"linux_gpio"
+    const char *consumer;
+    // GPIO方向, 组内所有GPIO相同
+    gpio_direction_e direction;
+    // 输出初始电平, bit i对应组内第i个GPIO, 仅输出方向有效
+    uint64_t init_values;
+    // 触发边沿, 仅输入方向有效
+    gpio_edge_e edge;
+    // 各GPIO的触发边沿(num个元素), 为NULL时全部使用edge, 仅输入方向有效
+    const gpio_edge_e *line_edges;
+    // 内核事件缓冲区大小(事件个数), 0表示使用内核默认值(16 * GPIO数量), 仅uAPI v2后端有效
+    uint32_t event_buffer_size;
+    // 虚拟后端的回调函数和参数, 仅E_GPIO_BACKEND_VIRTUAL有效
+    const gpio_group_ops_t *ops;
+    void *ops_arg;
+    // 为true时接管request_fd, 不访问GPIO芯片(chip被忽略), backend必须为E_GPIO_BACKEND_CDEV_V2
+    bool adopt_fd;
+    // 已申请的uAPI v2 line request文件描述符(如由代理进程传递), 仅adopt_fd为true时有效;
+    // 方向、边沿和初始电平必须与申请时相同, 打开后由GPIO组关闭
+    int request_fd;
+} gpio_group_config_t;
+
+// GPIO组, 打开后保持文件描述符, 后续操作不再重复open/close
+typedef struct
+{
+    // 实际使用的后端
+    gpio_backend_e backend;
+    // 组内GPIO数量
+    uint8_t num;
+    // 组内GPIO编号, sysfs后端为全局编号, 字符设备后端为芯片内偏移
+    uint16_t gpio_nums[GPIO_GROUP_MAX_NUM];
+    // sysfs后端: 各GPIO的value文件描述符; uAPI v1后端: 各GPIO的事件文件描述符
+    int value_fds[GPIO_GROUP_MAX_NUM];
+    // 字符设备后端的请求文件描述符(v2为line request, v1为line handle)
+    int req_fd;
+    // 打开时的GPIO方向
+    gpio_direction_e direction;
+    // 当前为输出方向的GPIO掩码, 可由gpio_group_set_direction逐个切换
+    uint64_t output_mask;
+    // 虚拟后端的回调函数和参数
+    const gpio_group_ops_t *ops;
+    void *ops_arg;
+    // 触发边沿, 各GPIO边沿的并集
+    gpio_edge_e edge;
+    // 检测上升沿的GPIO掩码
+    uint64_t rising_mask;
+    // 检测下降沿的GPIO掩码
+    uint64_t falling_mask;
+    // 最近一次输出的电平值, 用于跳过未变化的GPIO
+    uint64_t values;
+    // 最近一次事件的请求序号(uAPI v2)
+    uint32_t last_seqno;
+    // 各GPIO最近一次事件的序号(uAPI v2)
+    uint32_t line_seqnos[GPIO_GROUP_MAX_NUM];
+    // 已读取的事件总数
+    uint64_t event_count;
+    // 因内核事件缓冲区溢出丢失的事件总数(uAPI v2, 由序号间隔得出)
+    uint64_t lost_count;
+    // 读取事件的read()调用次数
+    uint64_t read_count;
+    // 事件批量读取缓冲区, 按缓存行对齐, 打开时分配(仅字符设备后端)
+    void *event_buf;
+    // 当前每次read()读取的事件个数, 根据突发大小自适应, 范围[1, GPIO_GROUP_EVENT_BATCH_MAX]
+    uint32_t batch_size;
+    // 每次读取突发大小的滑动平均值, 放大16倍保存
+    uint32_t burst_avg_x16;
+} gpio_group_t;
+
+// GPIO组的事件文件描述符
+typedef struct
+{
+    // 文件描述符
+    int fd;
+    // 对应的组内序号(sysfs和uAPI v1后端每个GPIO一个文件描述符), uAPI v2后端为0
+    uint8_t index;
+    // poll/epoll需要等待的事件(POLLIN或POLLPRI)
+    short events;
+} gpio_group_event_fd_t;
+
+/**
+ * @brief  打开GPIO组: 按配置选择后端并申请GPIO, 设置方向/边沿, 保持文件描述符
+ * @note   字符设备后端一次申请全部GPIO, 批量设置/获取只需一次ioctl;
+ *         uAPI v2后端全部GPIO(最多64个)的边沿事件由同一个文件描述符上报
+ * @param  group    : 输出参数, 打开的GPIO组
+ * @param  gpio_nums: 输入参数, 组内GPIO编号, sysfs后端为全局编号, 字符设备后端为芯片内偏移
+ * @param  num      : 输入参数, 组内GPIO数量, 取值范围[1, GPIO_GROUP_MAX_NUM]
+ * @param  config   : 输入参数, GPIO组配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_open(gpio_group_t *group, const uint16_t *gpio_nums, const uint8_t num,
+                     const gpio_group_config_t *config);
+
+/**
+ * @brief  关闭GPIO组
+ * @param  group: 输入参数, 待关闭的GPIO组
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_close(gpio_group_t *group);
+
+/**
+ * @brief  切换GPIO方向(如双向数据线), 不重新申请GPIO
+ * @note   uAPI v2后端一次ioctl(GPIO_V2_LINE_SET_CONFIG_IOCTL)完成; uAPI v1后端只能整组切换;
+ *         uAPI v2后端检测边沿的GPIO为输出时暂停边沿检测, 切换回输入时恢复, 其他后端不能切换为输出
+ * @param  group    : 输入参数, GPIO组
+ * @param  mask     : 输入参数, 待切换的GPIO掩码, bit i对应组内第i个GPIO
+ * @param  direction: 输入参数, 目标方向
+ * @param  values   : 输入参数, 切换为输出时的电平值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_set_direction(gpio_group_t *group, const uint64_t mask, const gpio_direction_e direction,
+                              const uint64_t values);
+
+/**
+ * @brief  批量设置GPIO组输出电平值, 掩码中的输入GPIO被忽略
+ * @param  group : 输入参数, GPIO组
+ * @param  mask  : 输入参数, 待设置的GPIO掩码, bit i对应组内第i个GPIO
+ * @param  values: 输入参数, 待设置的电平值, bit i对应组内第i个GPIO
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_set_values(gpio_group_t *group, const uint64_t mask, const uint64_t values);
+
+/**
+ * @brief  批量获取GPIO组电平值
+ * @param  values: 输出参数, 获取到的电平值, bit i对应组内第i个GPIO, 未在掩码中的位为0
+ * @param  group : 输入参数, GPIO组
+ * @param  mask  : 输入参数, 待获取的GPIO掩码, bit i对应组内第i个GPIO
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_group_get_values(uint64_t *values, gpio_group_t *group, const uint64_t mask);
+
+/**
+ * @brief  获取GPIO组的事件文件描述符, 用于poll/epoll
+ * @param  fds  : 输出参数, 事件文件描述符, 至少GPIO_GROUP_MAX_NUM个元素
+ * @param  group: 输入参数, GPIO组
+ * @return 事件文件描述符个数, 未检测边沿时为0
+ */
+uint8_t gpio_group_get_event_fds(gpio_group_event_fd_t *fds, const gpio_group_t *group);
+
+/**
+ * @brief  从就绪的事件文件描述符批量读取边沿事件
+ * @note   字符设备后端一次read()读取多个事件到复用的对齐缓冲区, 每次读取的个数根据突发大小自适应,
+ *         直到读完内核中的事件或读满max个; sysfs后端每次读取一个事件
+ * @param  events: 输出参数, 边沿事件, 至少max个元素
+ * @param  max   : 输入参数, 最多读取的事件个数
+ * @param  group : 输入参数, GPIO组
+ * @param  fd    : 输入参数, 就绪的事件文件描述符(由gpio_group_get_event_fds获取)
+ * @return 成功: 读取到的事件个数, 没有待读取的事件时为0
+ *         失败: -1
+ */
+int gpio_group_read_events(gpio_event_t *events, const uint32_t max, gpio_group_t *group,
+                           const gpio_group_event_fd_t *fd);
+
+/**
+ * @brief  等待GPIO组内任意GPIO产生边沿事件
+ * @param  event     : 输出参数, 边沿事件
+ * @param  group     : 输入参数, GPIO组
+ * @param  timeout_ms: 输入参数, 超时时间, 单位: ms, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_group_wait_event(gpio_event_t *event, gpio_group_t *group, const int timeout_ms);
+
+/**
+ * @brief  等待掩码中任意一个GPIO产生指定边沿, 返回最先到达的事件
+ * @note   使用ppoll, 超时精度为纳秒; 等待期间读到的不匹配事件(其他GPIO或其他边沿)被丢弃
+ * @param  event     : 输出参数, 边沿事件(含时间戳)
+ * @param  group     : 输入参数, GPIO组
+ * @param  mask      : 输入参数, 等待的GPIO掩码, bit i对应组内第i个GPIO
+ * @param  edge      : 输入参数, 等待的边沿, E_GPIO_RISING/E_GPIO_FALLING/E_GPIO_BOTH
+ * @param  timeout_ns: 输入参数, 超时时间, 单位: ns, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_group_wait_any(gpio_event_t *event, gpio_group_t *group, const uint64_t mask, const gpio_edge_e edge,
+                         const int64_t timeout_ns);
+
+/**
+ * @brief  等待组内一个GPIO产生指定边沿
+ * @param  event     : 输出参数, 边沿事件(含时间戳)
+ * @param  group     : 输入参数, GPIO组
+ * @param  index     : 输入参数, 组内序号
+ * @param  edge      : 输入参数, 等待的边沿, E_GPIO_RISING/E_GPIO_FALLING/E_GPIO_BOTH
+ * @param  timeout_ns: 输入参数, 超时时间, 单位: ns, 小于0表示一直等待
+ * @return true : 成功
+ * @return false: 失败或超时(超时时errno为ETIMEDOUT)
+ */
+bool gpio_group_wait_edge(gpio_event_t *event, gpio_group_t *group, const uint8_t index, const gpio_edge_e edge,
+                          const int64_t timeout_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_GROUP_H
@@ -0,0 +1,400 @@
+/**
+ * @file      : gpio_jtag.c
+ * @brief     : GPIO模拟JTAG(TAP控制器)源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 18:34:51
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "./gpio_jtag.h"
+
+// TAP状态转移表: [当前状态][TMS]
+static const gpio_jtag_state_e g_gpio_jtag_next[E_GPIO_JTAG_STATE_NUM][2] = {
+    [E_GPIO_JTAG_RESET] = {E_GPIO_JTAG_IDLE, E_GPIO_JTAG_RESET},
+    [E_GPIO_JTAG_IDLE] = {E_GPIO_JTAG_IDLE, E_GPIO_JTAG_DRSELECT},
+    [E_GPIO_JTAG_DRSELECT] = {E_GPIO_JTAG_DRCAPTURE, E_GPIO_JTAG_IRSELECT},
+    [E_GPIO_JTAG_DRCAPTURE] = {E_GPIO_JTAG_DRSHIFT, E_GPIO_JTAG_DREXIT1},
+    [E_GPIO_JTAG_DRSHIFT] = {E_GPIO_JTAG_DRSHIFT, E_GPIO_JTAG_DREXIT1},
+    [E_GPIO_JTAG_DREXIT1] = {E_GPIO_JTAG_DRPAUSE, E_GPIO_JTAG_DRUPDATE},
+    [E_GPIO_JTAG_DRPAUSE] = {E_GPIO_JTAG_DRPAUSE, E_GPIO_JTAG_DREXIT2},
+    [E_GPIO_JTAG_DREXIT2] = {E_GPIO_JTAG_DRSHIFT, E_GPIO_JTAG_DRUPDATE},
+    [E_GPIO_JTAG_DRUPDATE] = {E_GPIO_JTAG_IDLE, E_GPIO_JTAG_DRSELECT},
+    [E_GPIO_JTAG_IRSELECT] = {E_GPIO_JTAG_IRCAPTURE, E_GPIO_JTAG_RESET},
+    [E_GPIO_JTAG_IRCAPTURE] = {E_GPIO_JTAG_IRSHIFT, E_GPIO_JTAG_IREXIT1},
+    [E_GPIO_JTAG_IRSHIFT] = {E_GPIO_JTAG_IRSHIFT, E_GPIO_JTAG_IREXIT1},
+    [E_GPIO_JTAG_IREXIT1] = {E_GPIO_JTAG_IRPAUSE, E_GPIO_JTAG_IRUPDATE},
+    [E_GPIO_JTAG_IRPAUSE] = {E_GPIO_JTAG_IRPAUSE, E_GPIO_JTAG_IREXIT2},
+    [E_GPIO_JTAG_IREXIT2] = {E_GPIO_JTAG_IRSHIFT, E_GPIO_JTAG_IRUPDATE},
+    [E_GPIO_JTAG_IRUPDATE] = {E_GPIO_JTAG_IDLE, E_GPIO_JTAG_DRSELECT},
+};
+
+/**
+ * @brief  编译一个TCK时钟: TCK下降沿同时输出TMS/TDI(一次批量设置), 可选采样TDO, 再输出TCK上升沿
+ * @param  jtag  : 输入参数, JTAG引擎
+ * @param  tms   : 输入参数, TMS电平
+ * @param  tdi   : 输入参数, TDI电平
+ * @param  sample: 输入参数, 是否在上升沿之前采样TDO
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_jtag_clock(gpio_jtag_t *jtag, const bool tms, const bool tdi, const bool sample)
+{
+    uint64_t values = 0;
+
+    if (tms)
+    {
+        values |= (1ULL << jtag->config.tms);
+    }
+
+    if (tdi)
+    {
+        values |= (1ULL << jtag->config.tdi);
+    }
+
+    if (gpio_pattern_append(&jtag->pattern, values, sample) < 0)
+    {
+        return false;
+    }
+
+    if (gpio_pattern_append(&jtag->pattern, values | (1ULL << jtag->config.tck), false) < 0)
+    {
+        return false;
+    }
+
+    jtag->state = g_gpio_jtag_next[jtag->state][tms ? 1 : 0];
+
+    return true;
+}
+
+/**
+ * @brief  队列过大时执行, 限制波形缓冲区大小
+ * @param  jtag: 输入参数, JTAG引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_jtag_check_flush(gpio_jtag_t *jtag)
+{
+    if ((jtag->pattern.num / 2 >= GPIO_JTAG_FLUSH_CLOCKS) || (jtag->capture_num >= GPIO_JTAG_MAX_CAPTURES))
+    {
+        return gpio_jtag_flush(jtag);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  初始化JTAG引擎, TCK输出低电平
+ * @param  jtag  : 输出参数, JTAG引擎
+ * @param  config: 输入参数, JTAG配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_init(gpio_jtag_t *jtag, const gpio_jtag_config_t *config)
+{
+    uint64_t mask = 0;
+
+    if ((!jtag) || (!config) || (!config->output) || (!config->input))
+    {
+        return false;
+    }
+
+    if ((config->tck >= config->output->num) || (config->tms >= config->output->num) ||
+        (config->tdi >= config->output->num) || (config->tdo >= config->input->num))
+    {
+        return false;
+    }
+
+    memset(jtag, 0, sizeof(gpio_jtag_t));
+    jtag->config = *config;
+    jtag->state = E_GPIO_JTAG_RESET;
+    mask = (1ULL << config->tck) | (1ULL << config->tms) | (1ULL << config->tdi);
+    if (!gpio_pattern_init(&jtag->pattern, mask, 0))
+    {
+        return false;
+    }
+
+    if (!gpio_group_set_values(config->output, (1ULL << config->tck), 0))
+    {
+        gpio_pattern_deinit(&jtag->pattern);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  释放JTAG引擎(不关闭GPIO组)
+ * @param  jtag: 输入参数, JTAG引擎
+ */
+void gpio_jtag_deinit(gpio_jtag_t *jtag)
+{
+    if (!jtag)
+    {
+        return;
+    }
+
+    gpio_pattern_deinit(&jtag->pattern);
+    free(jtag->samples);
+    jtag->samples = NULL;
+    jtag->samples_size = 0;
+}
+
+/**
+ * @brief  编译: TMS保持高电平5个时钟, 进入Test-Logic-Reset
+ * @param  jtag: 输入参数, JTAG引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_reset(gpio_jtag_t *jtag)
+{
+    if (!jtag)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        if (!gpio_jtag_clock(jtag, true, false, false))
+        {
+            return false;
+        }
+    }
+
+    jtag->state = E_GPIO_JTAG_RESET;
+
+    return gpio_jtag_check_flush(jtag);
+}
+
+/**
+ * @brief  编译: 按最短TMS路径转到指定状态
+ * @param  jtag : 输入参数, JTAG引擎
+ * @param  state: 输入参数, 目标状态
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_goto_state(gpio_jtag_t *jtag, const gpio_jtag_state_e state)
+{
+    uint8_t prev[E_GPIO_JTAG_STATE_NUM] = {0};
+    uint8_t prev_tms[E_GPIO_JTAG_STATE_NUM] = {0};
+    bool visited[E_GPIO_JTAG_STATE_NUM] = {0};
+    uint8_t queue[E_GPIO_JTAG_STATE_NUM] = {0};
+    uint8_t path[E_GPIO_JTAG_STATE_NUM] = {0};
+    uint8_t head = 0;
+    uint8_t tail = 0;
+    uint8_t len = 0;
+    uint8_t cur = 0;
+    uint8_t next = 0;
+
+    if ((!jtag) || (state >= E_GPIO_JTAG_STATE_NUM))
+    {
+        return false;
+    }
+
+    if (state == jtag->state)
+    {
+        return true;
+    }
+
+    // 16个状态上广度优先搜索最短TMS序列
+    queue[tail++] = jtag->state;
+    visited[jtag->state] = true;
+    while ((head < tail) && (!visited[state]))
+    {
+        cur = queue[head++];
+        for (uint8_t tms = 0; tms < 2; tms++)
+        {
+            next = g_gpio_jtag_next[cur][tms];
+            if (visited[next])
+            {
+                continue;
+            }
+
+            visited[next] = true;
+            prev[next] = cur;
+            prev_tms[next] = tms;
+            queue[tail++] = next;
+        }
+    }
+
+    for (cur = state; cur != jtag->state; cur = prev[cur])
+    {
+        path[len++] = prev_tms[cur];
+    }
+
+    while (len > 0)
+    {
+        if (!gpio_jtag_clock(jtag, (0 != path[--len]), false, false))
+        {
+            return false;
+        }
+    }
+
+    return gpio_jtag_check_flush(jtag);
+}
+
+/**
+ * @brief  编译: 在当前状态输出指定个数的时钟, TMS保持(Run-Test/Idle和Pause状态下使用)
+ * @param  jtag  : 输入参数, JTAG引擎
+ * @param  clocks: 输入参数, 时钟个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_clocks(gpio_jtag_t *jtag, const uint32_t clocks)
+{
+    bool tms = false;
+
+    if (!jtag)
+    {
+        return false;
+    }
+
+    // Test-Logic-Reset保持需要TMS为1, 其他稳定状态为0
+    tms = (E_GPIO_JTAG_RESET == jtag->state);
+    for (uint32_t i = 0; i < clocks; i++)
+    {
+        if (!gpio_jtag_clock(jtag, tms, false, false))
+        {
+            return false;
+        }
+
+        if (!gpio_jtag_check_flush(jtag))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  编译: 移位指令寄存器或数据寄存器, LSB优先, 最后一位同时离开Shift状态
+ * @param  jtag     : 输入参数, JTAG引擎
+ * @param  tdo      : 输出参数, TDO采样结果, 至少(bits + 7) / 8字节, 为NULL时不采样; 执行(gpio_jtag_flush)后有效
+ * @param  tdi      : 输入参数, TDI数据, 至少(bits + 7) / 8字节, 为NULL时全部为0
+ * @param  bits     : 输入参数, 位数
+ * @param  ir       : 输入参数, true: 指令寄存器, false: 数据寄存器
+ * @param  end_state: 输入参数, 移位后的稳定状态(Run-Test/Idle、Pause等)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_shift(gpio_jtag_t *jtag, uint8_t *tdo, const uint8_t *tdi, const uint32_t bits, const bool ir,
+                     const gpio_jtag_state_e end_state)
+{
+    gpio_jtag_capture_t *capture = NULL;
+    bool bit = false;
+
+    if ((!jtag) || (0 == bits))
+    {
+        return false;
+    }
+
+    // 捕获个数已满时先执行, 保证本次移位的采样在同一个波形中
+    if ((tdo) && (jtag->capture_num >= GPIO_JTAG_MAX_CAPTURES) && (!gpio_jtag_flush(jtag)))
+    {
+        return false;
+    }
+
+    if (!gpio_jtag_goto_state(jtag, ir ? E_GPIO_JTAG_IRSHIFT : E_GPIO_JTAG_DRSHIFT))
+    {
+        return false;
+    }
+
+    if (tdo)
+    {
+        capture = &jtag->captures[jtag->capture_num++];
+        capture->dest = tdo;
+        capture->offset = jtag->pattern.sample_num;
+        capture->bits = bits;
+    }
+
+    for (uint32_t i = 0; i < bits; i++)
+    {
+        bit = (tdi) && (tdi[i / 8] & (1U << (i % 8)));
+
+        // 最后一位TMS为1, 移位的同时进入Exit1
+        if (!gpio_jtag_clock(jtag, (bits - 1 == i), bit, (NULL != tdo)))
+        {
+            return false;
+        }
+    }
+
+    if (!gpio_jtag_goto_state(jtag, end_state))
+    {
+        return false;
+    }
+
+    return gpio_jtag_check_flush(jtag);
+}
+
+/**
+ * @brief  执行已编译的波形, 并把TDO采样结果复制到各自的缓冲区
+ * @param  jtag: 输入参数, JTAG引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_flush(gpio_jtag_t *jtag)
+{
+    uint32_t size = 0;
+    uint8_t *samples = NULL;
+    gpio_jtag_capture_t *capture = NULL;
+    uint32_t bit = 0;
+    bool ret = false;
+
+    if (!jtag)
+    {
+        return false;
+    }
+
+    if (0 == jtag->pattern.num)
+    {
+        return true;
+    }
+
+    size = (jtag->pattern.sample_num + 7) / 8;
+    if (size > jtag->samples_size)
+    {
+        samples = realloc(jtag->samples, size);
+        if (!samples)
+        {
+            return false;
+        }
+
+        jtag->samples = samples;
+        jtag->samples_size = size;
+    }
+
+    ret = gpio_pattern_play(jtag->samples, &jtag->pattern, jtag->config.output, jtag->config.input,
+                            jtag->config.tdo, jtag->config.half_period_ns);
+    if (ret)
+    {
+        for (uint8_t i = 0; i < jtag->capture_num; i++)
+        {
+            capture = &jtag->captures[i];
+            memset(capture->dest, 0, (capture->bits + 7) / 8);
+            for (uint32_t j = 0; j < capture->bits; j++)
+            {
+                bit = capture->offset + j;
+                if (jtag->samples[bit / 8] & (1U << (bit % 8)))
+                {
+                    capture->dest[j / 8] |= (uint8_t)(1U << (j % 8));
+                }
+            }
+        }
+
+        jtag->clock_count += jtag->pattern.num / 2;
+    }
+
+    gpio_pattern_clear(&jtag->pattern);
+    jtag->capture_num = 0;
+
+    return ret;
+}
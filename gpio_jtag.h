@@ -0,0 +1,168 @@
+/**
+ * @file      : gpio_jtag.h
+ * @brief     : GPIO模拟JTAG(TAP控制器)头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 18:34:51
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_JTAG_H
+#define __GPIO_JTAG_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+#include "./gpio_pattern.h"
+
+// 一次执行最多的TDO捕获个数, 超出时自动执行
+#define GPIO_JTAG_MAX_CAPTURES 64
+
+// 队列中的时钟个数超过该值时自动执行, 限制波形缓冲区大小
+#define GPIO_JTAG_FLUSH_CLOCKS 65536
+
+// TAP控制器状态
+typedef enum
+{
+    E_GPIO_JTAG_RESET = 0,
+    E_GPIO_JTAG_IDLE = 1,
+    E_GPIO_JTAG_DRSELECT = 2,
+    E_GPIO_JTAG_DRCAPTURE = 3,
+    E_GPIO_JTAG_DRSHIFT = 4,
+    E_GPIO_JTAG_DREXIT1 = 5,
+    E_GPIO_JTAG_DRPAUSE = 6,
+    E_GPIO_JTAG_DREXIT2 = 7,
+    E_GPIO_JTAG_DRUPDATE = 8,
+    E_GPIO_JTAG_IRSELECT = 9,
+    E_GPIO_JTAG_IRCAPTURE = 10,
+    E_GPIO_JTAG_IRSHIFT = 11,
+    E_GPIO_JTAG_IREXIT1 = 12,
+    E_GPIO_JTAG_IRPAUSE = 13,
+    E_GPIO_JTAG_IREXIT2 = 14,
+    E_GPIO_JTAG_IRUPDATE = 15,
+    // 状态个数
+    E_GPIO_JTAG_STATE_NUM = 16,
+} gpio_jtag_state_e;
+
+// JTAG配置
+typedef struct
+{
+    // 输出GPIO组(包含TCK/TMS/TDI)
+    gpio_group_t *output;
+    // TCK/TMS/TDI在输出GPIO组内的序号
+    uint8_t tck;
+    uint8_t tms;
+    uint8_t tdi;
+    // 输入GPIO组(包含TDO)
+    gpio_group_t *input;
+    // TDO在输入GPIO组内的序号
+    uint8_t tdo;
+    // TCK半周期, 单位: ns, 0表示以最快速度输出
+    uint64_t half_period_ns;
+} gpio_jtag_config_t;
+
+// TDO捕获: 执行后把采样结果复制到调用者的缓冲区
+typedef struct
+{
+    uint8_t *dest;
+    // 在本次波形采样结果中的起始位置
+    uint32_t offset;
+    uint32_t bits;
+} gpio_jtag_capture_t;
+
+// JTAG引擎: 移位操作先编译到波形缓冲区, 执行时TCK下降沿和TMS/TDI变化合并为一次批量设置, 只在需要TDO时读取
+typedef struct
+{
+    gpio_jtag_config_t config;
+    // 编译到队列末尾时的TAP状态
+    gpio_jtag_state_e state;
+    // 待执行的波形
+    gpio_pattern_t pattern;
+    // 待执行的TDO捕获
+    gpio_jtag_capture_t captures[GPIO_JTAG_MAX_CAPTURES];
+    uint8_t capture_num;
+    // 采样结果缓冲区
+    uint8_t *samples;
+    uint32_t samples_size;
+    // 已执行的TCK时钟个数
+    uint64_t clock_count;
+} gpio_jtag_t;
+
+/**
+ * @brief  初始化JTAG引擎, TCK输出低电平
+ * @param  jtag  : 输出参数, JTAG引擎
+ * @param  config: 输入参数, JTAG配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_init(gpio_jtag_t *jtag, const gpio_jtag_config_t *config);
+
+/**
+ * @brief  释放JTAG引擎(不关闭GPIO组)
+ * @param  jtag: 输入参数, JTAG引擎
+ */
+void gpio_jtag_deinit(gpio_jtag_t *jtag);
+
+/**
+ * @brief  编译: TMS保持高电平5个时钟, 进入Test-Logic-Reset
+ * @param  jtag: 输入参数, JTAG引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_reset(gpio_jtag_t *jtag);
+
+/**
+ * @brief  编译: 按最短TMS路径转到指定状态
+ * @param  jtag : 输入参数, JTAG引擎
+ * @param  state: 输入参数, 目标状态
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_goto_state(gpio_jtag_t *jtag, const gpio_jtag_state_e state);
+
+/**
+ * @brief  编译: 在当前状态输出指定个数的时钟, TMS保持(Run-Test/Idle和Pause状态下使用)
+ * @param  jtag  : 输入参数, JTAG引擎
+ * @param  clocks: 输入参数, 时钟个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_clocks(gpio_jtag_t *jtag, const uint32_t clocks);
+
+/**
+ * @brief  编译: 移位指令寄存器或数据寄存器, LSB优先, 最后一位同时离开Shift状态
+ * @param  jtag     : 输入参数, JTAG引擎
+ * @param  tdo      : 输出参数, TDO采样结果, 至少(bits + 7) / 8字节, 为NULL时不采样; 执行(gpio_jtag_flush)后有效
+ * @param  tdi      : 输入参数, TDI数据, 至少(bits + 7) / 8字节, 为NULL时全部为0
+ * @param  bits     : 输入参数, 位数
+ * @param  ir       : 输入参数, true: 指令寄存器, false: 数据寄存器
+ * @param  end_state: 输入参数, 移位后的稳定状态(Run-Test/Idle、Pause等)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_shift(gpio_jtag_t *jtag, uint8_t *tdo, const uint8_t *tdi, const uint32_t bits, const bool ir,
+                     const gpio_jtag_state_e end_state);
+
+/**
+ * @brief  执行已编译的波形, 并把TDO采样结果复制到各自的缓冲区
+ * @param  jtag: 输入参数, JTAG引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_jtag_flush(gpio_jtag_t *jtag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_JTAG_H
@@ -0,0 +1,714 @@
+/**
+ * @file      : gpio_loop.c
+ * @brief     : GPIO事件循环源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 12:20:16
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-18 huenrong        增加逐个GPIO的事件限流/合并策略
+ *              2026-10-18 huenrong        增加按优先级分发事件
+ *              2026-10-19 huenrong        增加读取时立即执行的事件钩子
+ *              2026-10-19 huenrong        只按高优先级队列限制读取, 其他队列满时丢弃并计数, 先读取含高优先级GPIO的文件描述符
+ *              2026-10-19 huenrong        设置了钩子的事件源不受队列空间限制, 每次读满
+ *
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "./gpio_loop.h"
+
+// 一次epoll_wait最多返回的就绪文件描述符个数
+#define GPIO_LOOP_MAX_READY 64
+
+// 唤醒eventfd在epoll中的标识
+#define GPIO_LOOP_WAKE_TAG UINT64_MAX
+
+// 分发顺序, 从高到低
+static const gpio_priority_e gpio_loop_dispatch_order[E_GPIO_PRIORITY_NUM] = {
+    E_GPIO_PRIORITY_HIGH,
+    E_GPIO_PRIORITY_NORMAL,
+    E_GPIO_PRIORITY_LOW,
+};
+
+/**
+ * @brief  初始化事件循环
+ * @param  loop: 输出参数, 事件循环
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_init(gpio_loop_t *loop)
+{
+    struct epoll_event ev = {0};
+
+    if (!loop)
+    {
+        return false;
+    }
+
+    memset(loop, 0, sizeof(gpio_loop_t));
+    loop->wake_fd = -1;
+    loop->budget = GPIO_LOOP_DEFAULT_BUDGET;
+    loop->min_quota = GPIO_LOOP_DEFAULT_MIN_QUOTA;
+
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_fd < 0)
+    {
+        return false;
+    }
+
+    loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (loop->wake_fd < 0)
+    {
+        gpio_loop_deinit(loop);
+
+        return false;
+    }
+
+    ev.events = EPOLLIN;
+    ev.data.u64 = GPIO_LOOP_WAKE_TAG;
+    if (-1 == epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &ev))
+    {
+        gpio_loop_deinit(loop);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  销毁事件循环(不关闭已注册的GPIO组)
+ * @param  loop: 输入参数, 事件循环
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_deinit(gpio_loop_t *loop)
+{
+    bool result = true;
+
+    if (!loop)
+    {
+        return false;
+    }
+
+    if (loop->wake_fd >= 0)
+    {
+        if (0 != close(loop->wake_fd))
+        {
+            result = false;
+        }
+
+        loop->wake_fd = -1;
+    }
+
+    if (loop->epoll_fd >= 0)
+    {
+        if (0 != close(loop->epoll_fd))
+        {
+            result = false;
+        }
+
+        loop->epoll_fd = -1;
+    }
+
+    loop->source_num = 0;
+
+    return result;
+}
+
+/**
+ * @brief  注册GPIO组到事件循环
+ * @param  loop    : 输入参数, 事件循环
+ * @param  group   : 输入参数, 已打开且检测边沿的GPIO组
+ * @param  callback: 输入参数, 事件回调函数
+ * @param  arg     : 输入参数, 传给回调函数的用户参数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_add(gpio_loop_t *loop, gpio_group_t *group, const gpio_loop_callback_t callback, void *arg)
+{
+    gpio_loop_source_t *source = NULL;
+    struct epoll_event ev = {0};
+
+    if ((!loop) || (!group) || (!callback) || (loop->source_num >= GPIO_LOOP_MAX_GROUPS))
+    {
+        return false;
+    }
+
+    source = &loop->sources[loop->source_num];
+    memset(source, 0, sizeof(gpio_loop_source_t));
+    source->group = group;
+    source->callback = callback;
+    source->arg = arg;
+    for (uint8_t i = 0; i < GPIO_GROUP_MAX_NUM; i++)
+    {
+        source->lines[i].pending = -1;
+    }
+
+    source->fd_num = gpio_group_get_event_fds(source->fds, group);
+    if (0 == source->fd_num)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < source->fd_num; i++)
+    {
+        ev.events = (uint32_t)source->fds[i].events;
+        // 高位为事件源序号, 低8位为事件文件描述符序号
+        ev.data.u64 = ((uint64_t)loop->source_num << 8) | i;
+        if (-1 == epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, source->fds[i].fd, &ev))
+        {
+            for (uint8_t j = 0; j < i; j++)
+            {
+                epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, source->fds[j].fd, NULL);
+            }
+
+            return false;
+        }
+    }
+
+    loop->source_num++;
+
+    return true;
+}
+
+/**
+ * @brief  查找GPIO组对应的事件源
+ * @param  loop : 输入参数, 事件循环
+ * @param  group: 输入参数, GPIO组
+ * @return 成功: 事件源
+ *         失败: NULL
+ */
+static gpio_loop_source_t *gpio_loop_find_source(const gpio_loop_t *loop, const gpio_group_t *group)
+{
+    for (uint8_t i = 0; i < loop->source_num; i++)
+    {
+        if (group == loop->sources[i].group)
+        {
+            return (gpio_loop_source_t *)&loop->sources[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief  设置GPIO组的事件钩子, 用于换相等必须在读取事件时立即输出的场合
+ * @note   钩子处理过的事件不占用优先级队列, 也不受分发预算限制; 设置了钩子的组每次都按GPIO_LOOP_DRAIN_MAX读取,
+ *         不受队列空间限制, 钩子未处理的事件在队列满时丢弃并计入该GPIO的丢弃数
+ * @param  loop : 输入参数, 事件循环
+ * @param  group: 输入参数, 已注册的GPIO组
+ * @param  hook : 输入参数, 事件钩子, 为NULL时取消
+ * @param  arg  : 输入参数, 传给钩子的用户参数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_hook(gpio_loop_t *loop, const gpio_group_t *group, const gpio_loop_hook_t hook, void *arg)
+{
+    gpio_loop_source_t *source = NULL;
+
+    if ((!loop) || (!group))
+    {
+        return false;
+    }
+
+    source = gpio_loop_find_source(loop, group);
+    if (!source)
+    {
+        return false;
+    }
+
+    source->hook = hook;
+    source->hook_arg = arg;
+
+    return true;
+}
+
+/**
+ * @brief  设置GPIO的事件处理策略, 默认为E_GPIO_POLICY_ALL
+ * @param  loop  : 输入参数, 事件循环
+ * @param  group : 输入参数, 已注册的GPIO组
+ * @param  index : 输入参数, 组内序号
+ * @param  policy: 输入参数, 事件处理策略
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_policy(gpio_loop_t *loop, const gpio_group_t *group, const uint8_t index,
+                          const gpio_loop_policy_t *policy)
+{
+    gpio_loop_source_t *source = NULL;
+
+    if ((!loop) || (!group) || (!policy) || (index >= group->num))
+    {
+        return false;
+    }
+
+    if ((E_GPIO_POLICY_RATE_LIMIT == policy->type) && ((0 == policy->max_events) || (0 == policy->window_ns)))
+    {
+        return false;
+    }
+
+    source = gpio_loop_find_source(loop, group);
+    if (!source)
+    {
+        return false;
+    }
+
+    source->lines[index].policy = *policy;
+    source->lines[index].window_start_ns = 0;
+    source->lines[index].window_count = 0;
+
+    return true;
+}
+
+/**
+ * @brief  设置GPIO的事件优先级, 默认为E_GPIO_PRIORITY_NORMAL
+ * @param  loop    : 输入参数, 事件循环
+ * @param  group   : 输入参数, 已注册的GPIO组
+ * @param  index   : 输入参数, 组内序号
+ * @param  priority: 输入参数, 事件优先级
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_priority(gpio_loop_t *loop, const gpio_group_t *group, const uint8_t index,
+                            const gpio_priority_e priority)
+{
+    gpio_loop_source_t *source = NULL;
+
+    if ((!loop) || (!group) || (index >= group->num) || (priority >= E_GPIO_PRIORITY_NUM))
+    {
+        return false;
+    }
+
+    source = gpio_loop_find_source(loop, group);
+    if (!source)
+    {
+        return false;
+    }
+
+    source->lines[index].priority = priority;
+
+    return true;
+}
+
+/**
+ * @brief  设置每轮分发的预算
+ * @note   每轮先分发全部高优先级事件, 普通和低优先级共享budget个, 但每个优先级至少分发min_quota个,
+ *         未分发完的事件留在队列中, 下一轮检查新的高优先级事件后再继续
+ * @param  loop     : 输入参数, 事件循环
+ * @param  budget   : 输入参数, 每轮最多分发的非高优先级事件个数, 0表示不限制
+ * @param  min_quota: 输入参数, 每轮每个非高优先级至少分发的事件个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_budget(gpio_loop_t *loop, const uint32_t budget, const uint32_t min_quota)
+{
+    if ((!loop) || ((0 != budget) && (0 == min_quota)))
+    {
+        return false;
+    }
+
+    loop->budget = budget;
+    loop->min_quota = min_quota;
+
+    return true;
+}
+
+/**
+ * @brief  获取GPIO被策略丢弃/合并或因优先级队列满而丢弃的事件总数
+ * @param  dropped: 输出参数, 事件总数
+ * @param  loop   : 输入参数, 事件循环
+ * @param  group  : 输入参数, 已注册的GPIO组
+ * @param  index  : 输入参数, 组内序号
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_get_dropped(uint64_t *dropped, const gpio_loop_t *loop, const gpio_group_t *group,
+                           const uint8_t index)
+{
+    gpio_loop_source_t *source = NULL;
+
+    if ((!dropped) || (!loop) || (!group) || (index >= group->num))
+    {
+        return false;
+    }
+
+    source = gpio_loop_find_source(loop, group);
+    if (!source)
+    {
+        return false;
+    }
+
+    *dropped = source->lines[index].dropped;
+
+    return true;
+}
+
+/**
+ * @brief  把一次读取到的事件依次交给钩子, 原地保留钩子未处理的事件
+ * @param  source: 输入参数, 事件源
+ * @param  events: 输入输出参数, 事件缓冲区, 未处理的事件依次保存在前面
+ * @param  count : 输入参数, 读取到的事件个数
+ * @return 未处理的事件个数
+ */
+static int gpio_loop_apply_hook(gpio_loop_source_t *source, gpio_event_t *events, const int count)
+{
+    int out = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (!source->hook(source->group, &events[i], source->hook_arg))
+        {
+            events[out++] = events[i];
+        }
+    }
+
+    return out;
+}
+
+/**
+ * @brief  按各GPIO的策略原地过滤一次读取到的事件
+ * @param  source: 输入参数, 事件源
+ * @param  events: 输入输出参数, 事件缓冲区, 过滤后的事件依次保存在前面
+ * @param  count : 输入参数, 读取到的事件个数
+ * @return 过滤后需要回调的事件个数
+ */
+static int gpio_loop_apply_policy(gpio_loop_source_t *source, gpio_event_t *events, const int count)
+{
+    int out = 0;
+    gpio_loop_line_t *line = NULL;
+    gpio_event_t *merged = NULL;
+
+    for (int i = 0; i < count; i++)
+    {
+        line = &source->lines[events[i].index];
+        switch (line->policy.type)
+        {
+        case E_GPIO_POLICY_RATE_LIMIT:
+        {
+            if (events[i].timestamp_ns - line->window_start_ns >= line->policy.window_ns)
+            {
+                line->window_start_ns = events[i].timestamp_ns;
+                line->window_count = 0;
+            }
+
+            if (line->window_count >= line->policy.max_events)
+            {
+                line->dropped += events[i].count;
+
+                continue;
+            }
+
+            line->window_count++;
+            events[out++] = events[i];
+
+            break;
+        }
+
+        case E_GPIO_POLICY_COALESCE:
+        case E_GPIO_POLICY_SUMMARY:
+        {
+            if (line->pending < 0)
+            {
+                line->pending = out;
+                events[out++] = events[i];
+
+                break;
+            }
+
+            // 合并到本次读取中该GPIO的第一个事件位置, 保留最新的边沿和时间戳
+            merged = &events[line->pending];
+            merged->edge = events[i].edge;
+            merged->timestamp_ns = events[i].timestamp_ns;
+            merged->seqno = events[i].seqno;
+            merged->line_seqno = events[i].line_seqno;
+            merged->lost += events[i].lost;
+            merged->count += events[i].count;
+            if (E_GPIO_POLICY_COALESCE == line->policy.type)
+            {
+                line->dropped += events[i].count;
+            }
+
+            break;
+        }
+
+        default:
+        {
+            events[out++] = events[i];
+
+            break;
+        }
+        }
+    }
+
+    // 清除本次读取的合并位置
+    for (int i = 0; i < out; i++)
+    {
+        source->lines[events[i].index].pending = -1;
+    }
+
+    return out;
+}
+
+/**
+ * @brief  文件描述符上是否有高优先级的GPIO
+ * @param  source: 输入参数, 事件源
+ * @param  fd    : 输入参数, 事件文件描述符
+ * @return true : 有
+ * @return false: 没有
+ */
+static bool gpio_loop_fd_has_high(const gpio_loop_source_t *source, const gpio_group_event_fd_t *fd)
+{
+    // v2的全部GPIO共用一个文件描述符
+    if (E_GPIO_BACKEND_CDEV_V2 != source->group->backend)
+    {
+        return (E_GPIO_PRIORITY_HIGH == source->lines[fd->index].priority);
+    }
+
+    for (uint8_t i = 0; i < source->group->num; i++)
+    {
+        if (E_GPIO_PRIORITY_HIGH == source->lines[i].priority)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  把事件放入对应优先级队列的尾部, 队列满时丢弃并计入该GPIO的丢弃数
+ * @param  loop  : 输入参数, 事件循环
+ * @param  source: 输入参数, 事件源
+ * @param  event : 输入参数, 边沿事件
+ */
+static void gpio_loop_enqueue(gpio_loop_t *loop, gpio_loop_source_t *source, const gpio_event_t *event)
+{
+    gpio_loop_line_t *line = &source->lines[event->index];
+    gpio_loop_queue_t *queue = &loop->queues[line->priority];
+    gpio_loop_entry_t *entry = NULL;
+
+    if (queue->count >= GPIO_LOOP_QUEUE_MAX)
+    {
+        line->dropped += event->count;
+
+        return;
+    }
+
+    entry = &queue->entries[(queue->head + queue->count) % GPIO_LOOP_QUEUE_MAX];
+    entry->source = source;
+    entry->event = *event;
+    queue->count++;
+}
+
+/**
+ * @brief  是否有待分发的事件
+ * @param  loop: 输入参数, 事件循环
+ * @return true : 有
+ * @return false: 没有
+ */
+static bool gpio_loop_has_pending(const gpio_loop_t *loop)
+{
+    for (int i = 0; i < E_GPIO_PRIORITY_NUM; i++)
+    {
+        if (0 != loop->queues[i].count)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  从优先级队列头部分发事件
+ * @param  queue: 输入参数, 优先级队列
+ * @param  max  : 输入参数, 最多分发的事件个数
+ * @return 分发的事件个数
+ */
+static uint32_t gpio_loop_dispatch_queue(gpio_loop_queue_t *queue, const uint32_t max)
+{
+    uint32_t count = 0;
+    gpio_loop_entry_t *entry = NULL;
+
+    while ((count < max) && (queue->count > 0))
+    {
+        entry = &queue->entries[queue->head];
+        queue->head = (queue->head + 1) % GPIO_LOOP_QUEUE_MAX;
+        queue->count--;
+        count++;
+
+        entry->source->callback(entry->source->group, &entry->event, entry->source->arg);
+    }
+
+    return count;
+}
+
+/**
+ * @brief  等待并处理一次事件: 先读含高优先级GPIO的就绪文件描述符, 再读其他的, 事件先交给钩子,
+ *         其余按策略过滤后放入各优先级队列, 再从高到低按预算分发
+ * @note   只有高优先级队列的剩余空间限制读取(每轮全部分发, 不会一直满), 普通和低优先级队列满时
+ *         丢弃事件并计入该GPIO的丢弃数, 不会因为积压阻塞同一文件描述符上的高优先级事件;
+ *         设置了钩子的组不受队列空间限制
+ * @param  loop      : 输入参数, 事件循环
+ * @param  timeout_ms: 输入参数, 超时时间, 单位: ms, 小于0表示一直等待; 队列中有积压时不等待
+ * @return 成功: 本次处理的事件个数, 超时为0
+ *         失败: -1
+ */
+int gpio_loop_run_once(gpio_loop_t *loop, const int timeout_ms)
+{
+    struct epoll_event ready[GPIO_LOOP_MAX_READY];
+    int ready_num = 0;
+    int count = 0;
+    uint32_t space = 0;
+    bool high = false;
+    uint32_t total = 0;
+    uint32_t budget = 0;
+    uint32_t quota = 0;
+    uint32_t sent = 0;
+    uint64_t wake = 0;
+    gpio_loop_source_t *source = NULL;
+    const gpio_group_event_fd_t *fd = NULL;
+    gpio_loop_queue_t *queue = NULL;
+
+    if (!loop)
+    {
+        return -1;
+    }
+
+    ready_num = epoll_wait(loop->epoll_fd, ready, GPIO_LOOP_MAX_READY, gpio_loop_has_pending(loop) ? 0 : timeout_ms);
+    if (ready_num < 0)
+    {
+        return (EINTR == errno) ? 0 : -1;
+    }
+
+    // 先读完所有就绪文件描述符, 再统一按优先级分发; 第一遍只读含高优先级GPIO的文件描述符
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int i = 0; i < ready_num; i++)
+        {
+            if (GPIO_LOOP_WAKE_TAG == ready[i].data.u64)
+            {
+                // 清除唤醒计数, EAGAIN说明计数已被清除
+                if ((0 == pass) && (sizeof(wake) != read(loop->wake_fd, &wake, sizeof(wake))) && (EAGAIN != errno))
+                {
+                    return -1;
+                }
+
+                continue;
+            }
+
+            source = &loop->sources[ready[i].data.u64 >> 8];
+            fd = &source->fds[ready[i].data.u64 & 0xFF];
+            high = gpio_loop_fd_has_high(source, fd);
+            if ((0 == pass) != high)
+            {
+                continue;
+            }
+
+            // 高优先级队列空间不足时剩余的文件描述符留到下一轮(epoll为水平触发, 不会丢失);
+            // 钩子在读取时立即处理事件, 不等待队列空间
+            space = GPIO_LOOP_QUEUE_MAX - loop->queues[E_GPIO_PRIORITY_HIGH].count;
+            if (source->hook)
+            {
+                space = GPIO_LOOP_DRAIN_MAX;
+            }
+            else if (0 == space)
+            {
+                continue;
+            }
+
+            count = gpio_group_read_events(loop->events, (space < GPIO_LOOP_DRAIN_MAX) ? space : GPIO_LOOP_DRAIN_MAX,
+                                           source->group, fd);
+            if (count < 0)
+            {
+                return -1;
+            }
+
+            if (source->hook)
+            {
+                count = gpio_loop_apply_hook(source, loop->events, count);
+            }
+
+            count = gpio_loop_apply_policy(source, loop->events, count);
+            for (int j = 0; j < count; j++)
+            {
+                gpio_loop_enqueue(loop, source, &loop->events[j]);
+            }
+        }
+    }
+
+    // 高优先级全部分发, 其余按预算分发, 每个优先级至少min_quota个防止饿死
+    budget = loop->budget;
+    for (int i = 0; i < E_GPIO_PRIORITY_NUM; i++)
+    {
+        queue = &loop->queues[gpio_loop_dispatch_order[i]];
+        if ((E_GPIO_PRIORITY_HIGH == gpio_loop_dispatch_order[i]) || (0 == loop->budget))
+        {
+            total += gpio_loop_dispatch_queue(queue, UINT32_MAX);
+
+            continue;
+        }
+
+        quota = (budget > loop->min_quota) ? budget : loop->min_quota;
+        sent = gpio_loop_dispatch_queue(queue, quota);
+        budget = (sent < budget) ? (budget - sent) : 0;
+        total += sent;
+    }
+
+    return (int)total;
+}
+
+/**
+ * @brief  运行事件循环, 直到调用gpio_loop_stop
+ * @param  loop: 输入参数, 事件循环
+ * @return true : 正常停止
+ * @return false: 失败
+ */
+bool gpio_loop_run(gpio_loop_t *loop)
+{
+    if (!loop)
+    {
+        return false;
+    }
+
+    loop->stop = false;
+    while (!loop->stop)
+    {
+        if (gpio_loop_run_once(loop, -1) < 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  停止事件循环, 可在回调或其他线程中调用
+ * @param  loop: 输入参数, 事件循环
+ */
+void gpio_loop_stop(gpio_loop_t *loop)
+{
+    uint64_t wake = 1;
+
+    if (!loop)
+    {
+        return;
+    }
+
+    loop->stop = true;
+
+    // eventfd计数溢出时写入失败, 此时已有待处理的唤醒, 无需处理
+    if (sizeof(wake) != write(loop->wake_fd, &wake, sizeof(wake)))
+    {
+        return;
+    }
+}
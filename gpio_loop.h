@@ -0,0 +1,288 @@
+/**
+ * @file      : gpio_loop.h
+ * @brief     : GPIO事件循环头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 12:20:16
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-18 huenrong        增加逐个GPIO的事件限流/合并策略
+ *              2026-10-18 huenrong        增加按优先级分发事件
+ *              2026-10-19 huenrong        普通和低优先级队列满时丢弃并计数
+ *              2026-10-19 huenrong        设置了钩子的事件源不受队列空间限制
+ *
+ */
+
+#ifndef __GPIO_LOOP_H
+#define __GPIO_LOOP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+
+// 一个事件循环最多注册的GPIO组数量
+#define GPIO_LOOP_MAX_GROUPS 16
+
+// 每个就绪文件描述符一次最多读取的事件个数
+#define GPIO_LOOP_DRAIN_MAX 256
+
+// 每个优先级队列最多缓存的事件个数, 普通和低优先级队列满时新事件被丢弃并计入丢弃数
+#define GPIO_LOOP_QUEUE_MAX 512
+
+// 默认每轮最多分发的非高优先级事件个数
+#define GPIO_LOOP_DEFAULT_BUDGET 64
+
+// 默认每轮每个非高优先级至少分发的事件个数(防饿死)
+#define GPIO_LOOP_DEFAULT_MIN_QUOTA 8
+
+// 事件优先级
+typedef enum
+{
+    // 普通优先级(默认)
+    E_GPIO_PRIORITY_NORMAL = 0,
+    // 高优先级, 每轮全部先于其他优先级分发, 不受分发预算限制
+    E_GPIO_PRIORITY_HIGH = 1,
+    // 低优先级
+    E_GPIO_PRIORITY_LOW = 2,
+    // 优先级个数
+    E_GPIO_PRIORITY_NUM = 3,
+} gpio_priority_e;
+
+// 事件处理策略, 在读取事件后、回调之前执行
+typedef enum
+{
+    // 全部回调
+    E_GPIO_POLICY_ALL = 0,
+    // 合并: 每次读取中同一GPIO只回调最新的状态, 被合并的事件计入丢弃数
+    E_GPIO_POLICY_COALESCE = 1,
+    // 限流: 每个时间窗口最多回调max_events个事件, 超出的丢弃并计数
+    E_GPIO_POLICY_RATE_LIMIT = 2,
+    // 汇总: 每次读取中同一GPIO只回调一次, count为事件个数, 时间戳和边沿为最后一个事件
+    E_GPIO_POLICY_SUMMARY = 3,
+} gpio_policy_e;
+
+// 事件处理策略配置
+typedef struct
+{
+    gpio_policy_e type;
+    // 每个时间窗口最多回调的事件个数, 仅E_GPIO_POLICY_RATE_LIMIT有效
+    uint32_t max_events;
+    // 时间窗口, 单位: ns, 仅E_GPIO_POLICY_RATE_LIMIT有效
+    uint64_t window_ns;
+} gpio_loop_policy_t;
+
+// 单个GPIO的策略状态
+typedef struct
+{
+    gpio_loop_policy_t policy;
+    // 当前时间窗口起始时间, 单位: ns
+    uint64_t window_start_ns;
+    // 当前时间窗口已回调的事件个数
+    uint32_t window_count;
+    // 本次读取中该GPIO待回调事件在缓冲区中的位置, -1表示无
+    int32_t pending;
+    // 被策略丢弃/合并或因优先级队列满而丢弃的事件总数
+    uint64_t dropped;
+    // 事件优先级
+    gpio_priority_e priority;
+} gpio_loop_line_t;
+
+/**
+ * @brief  事件回调函数
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 注册时传入的用户参数
+ */
+typedef void (*gpio_loop_callback_t)(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+/**
+ * @brief  事件钩子函数, 读取事件后立即在事件循环线程中调用, 早于策略、优先级队列和回调, 应尽快返回
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件(未经策略合并)
+ * @param  arg  : 输入参数, 设置钩子时传入的用户参数
+ * @return true : 事件已处理, 不再进入队列和回调
+ * @return false: 事件继续按策略进入队列
+ */
+typedef bool (*gpio_loop_hook_t)(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+// 事件源(注册到事件循环的GPIO组)
+typedef struct
+{
+    gpio_group_t *group;
+    gpio_loop_callback_t callback;
+    void *arg;
+    // 事件钩子, 可以为NULL
+    gpio_loop_hook_t hook;
+    void *hook_arg;
+    // 组的事件文件描述符
+    gpio_group_event_fd_t fds[GPIO_GROUP_MAX_NUM];
+    uint8_t fd_num;
+    // 组内各GPIO的策略状态
+    gpio_loop_line_t lines[GPIO_GROUP_MAX_NUM];
+} gpio_loop_source_t;
+
+// 优先级队列中的事件
+typedef struct
+{
+    gpio_loop_source_t *source;
+    gpio_event_t event;
+} gpio_loop_entry_t;
+
+// 优先级队列(环形缓冲区)
+typedef struct
+{
+    gpio_loop_entry_t entries[GPIO_LOOP_QUEUE_MAX];
+    uint32_t head;
+    uint32_t count;
+} gpio_loop_queue_t;
+
+// GPIO事件循环, 结构体较大, 建议定义为全局或静态变量
+typedef struct
+{
+    // epoll文件描述符
+    int epoll_fd;
+    // 用于唤醒/停止事件循环的eventfd
+    int wake_fd;
+    // 停止标志
+    volatile bool stop;
+    // 已注册的事件源
+    gpio_loop_source_t sources[GPIO_LOOP_MAX_GROUPS];
+    uint8_t source_num;
+    // 事件读取缓冲区, 复用以避免每次分配
+    gpio_event_t events[GPIO_LOOP_DRAIN_MAX];
+    // 各优先级的待分发事件队列
+    gpio_loop_queue_t queues[E_GPIO_PRIORITY_NUM];
+    // 每轮最多分发的非高优先级事件个数, 0表示不限制
+    uint32_t budget;
+    // 每轮每个非高优先级至少分发的事件个数
+    uint32_t min_quota;
+} gpio_loop_t;
+
+/**
+ * @brief  初始化事件循环
+ * @param  loop: 输出参数, 事件循环
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_init(gpio_loop_t *loop);
+
+/**
+ * @brief  销毁事件循环(不关闭已注册的GPIO组)
+ * @param  loop: 输入参数, 事件循环
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_deinit(gpio_loop_t *loop);
+
+/**
+ * @brief  注册GPIO组到事件循环
+ * @param  loop    : 输入参数, 事件循环
+ * @param  group   : 输入参数, 已打开且检测边沿的GPIO组
+ * @param  callback: 输入参数, 事件回调函数
+ * @param  arg     : 输入参数, 传给回调函数的用户参数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_add(gpio_loop_t *loop, gpio_group_t *group, const gpio_loop_callback_t callback, void *arg);
+
+/**
+ * @brief  设置GPIO组的事件钩子, 用于换相等必须在读取事件时立即输出的场合
+ * @note   钩子处理过的事件不占用优先级队列, 也不受分发预算限制; 设置了钩子的组每次都按GPIO_LOOP_DRAIN_MAX读取,
+ *         不受队列空间限制, 钩子未处理的事件在队列满时丢弃并计入该GPIO的丢弃数
+ * @param  loop : 输入参数, 事件循环
+ * @param  group: 输入参数, 已注册的GPIO组
+ * @param  hook : 输入参数, 事件钩子, 为NULL时取消
+ * @param  arg  : 输入参数, 传给钩子的用户参数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_hook(gpio_loop_t *loop, const gpio_group_t *group, const gpio_loop_hook_t hook, void *arg);
+
+/**
+ * @brief  设置GPIO的事件处理策略, 默认为E_GPIO_POLICY_ALL
+ * @param  loop  : 输入参数, 事件循环
+ * @param  group : 输入参数, 已注册的GPIO组
+ * @param  index : 输入参数, 组内序号
+ * @param  policy: 输入参数, 事件处理策略
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_policy(gpio_loop_t *loop, const gpio_group_t *group, const uint8_t index,
+                          const gpio_loop_policy_t *policy);
+
+/**
+ * @brief  设置GPIO的事件优先级, 默认为E_GPIO_PRIORITY_NORMAL
+ * @param  loop    : 输入参数, 事件循环
+ * @param  group   : 输入参数, 已注册的GPIO组
+ * @param  index   : 输入参数, 组内序号
+ * @param  priority: 输入参数, 事件优先级
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_priority(gpio_loop_t *loop, const gpio_group_t *group, const uint8_t index,
+                            const gpio_priority_e priority);
+
+/**
+ * @brief  设置每轮分发的预算
+ * @note   每轮先分发全部高优先级事件, 普通和低优先级共享budget个, 但每个优先级至少分发min_quota个,
+ *         未分发完的事件留在队列中, 下一轮检查新的高优先级事件后再继续
+ * @param  loop     : 输入参数, 事件循环
+ * @param  budget   : 输入参数, 每轮最多分发的非高优先级事件个数, 0表示不限制
+ * @param  min_quota: 输入参数, 每轮每个非高优先级至少分发的事件个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_set_budget(gpio_loop_t *loop, const uint32_t budget, const uint32_t min_quota);
+
+/**
+ * @brief  获取GPIO被策略丢弃/合并或因优先级队列满而丢弃的事件总数
+ * @param  dropped: 输出参数, 事件总数
+ * @param  loop   : 输入参数, 事件循环
+ * @param  group  : 输入参数, 已注册的GPIO组
+ * @param  index  : 输入参数, 组内序号
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_loop_get_dropped(uint64_t *dropped, const gpio_loop_t *loop, const gpio_group_t *group,
+                           const uint8_t index);
+
+/**
+ * @brief  等待并处理一次事件: 先读含高优先级GPIO的就绪文件描述符, 再读其他的, 事件先交给钩子,
+ *         其余按策略过滤后放入各优先级队列, 再从高到低按预算分发
+ * @note   只有高优先级队列的剩余空间限制读取(每轮全部分发, 不会一直满), 普通和低优先级队列满时
+ *         丢弃事件并计入该GPIO的丢弃数, 不会因为积压阻塞同一文件描述符上的高优先级事件;
+ *         设置了钩子的组不受队列空间限制
+ * @param  loop      : 输入参数, 事件循环
+ * @param  timeout_ms: 输入参数, 超时时间, 单位: ms, 小于0表示一直等待; 队列中有积压时不等待
+ * @return 成功: 本次处理的事件个数, 超时为0
+ *         失败: -1
+ */
+int gpio_loop_run_once(gpio_loop_t *loop, const int timeout_ms);
+
+/**
+ * @brief  运行事件循环, 直到调用gpio_loop_stop
+ * @param  loop: 输入参数, 事件循环
+ * @return true : 正常停止
+ * @return false: 失败
+ */
+bool gpio_loop_run(gpio_loop_t *loop);
+
+/**
+ * @brief  停止事件循环, 可在回调或其他线程中调用
+ * @param  loop: 输入参数, 事件循环
+ */
+void gpio_loop_stop(gpio_loop_t *loop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_LOOP_H
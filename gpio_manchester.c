@@ -0,0 +1,507 @@
+/**
+ * @file      : gpio_manchester.c
+ * @brief     : 曼彻斯特(双相)编码解码源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 12:08:33
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "./gpio_manchester.h"
+
+// 帧缓冲区中每帧的头部: 2字节长度 + 8字节时间戳
+#define GPIO_MANCHESTER_RECORD_HEADER 10
+
+// 边沿间隔量化: 间隔 * GPIO_MANCHESTER_QUANT / 位周期, 即以1/8位为单位
+#define GPIO_MANCHESTER_QUANT 8
+
+// 位周期跟踪的平滑系数(右移位数), 每个间隔修正1/8的偏差
+#define GPIO_MANCHESTER_TRACK_SHIFT 3
+
+// 边沿间隔分类
+#define GPIO_MANCHESTER_SHORT 0
+#define GPIO_MANCHESTER_LONG 1
+#define GPIO_MANCHESTER_INVALID 2
+#define GPIO_MANCHESTER_IDLE 3
+
+// 解码状态: 未同步、上一个边沿在位中间、上一个边沿在位边界
+#define GPIO_MANCHESTER_SYNC 0
+#define GPIO_MANCHESTER_MID 1
+#define GPIO_MANCHESTER_BOUNDARY 2
+
+// 状态转移表项: 低2位为下一状态, 其余为动作
+#define GPIO_MANCHESTER_STATE_MASK 0x03
+#define GPIO_MANCHESTER_EMIT 0x10
+#define GPIO_MANCHESTER_ERROR 0x20
+#define GPIO_MANCHESTER_END 0x40
+
+// 量化间隔到分类: 小于1/4位为毛刺, 1/4~3/4位为半位, 3/4~11/8位为整位, 超过空闲位数为空闲
+static const uint8_t gpio_manchester_class_table[GPIO_MANCHESTER_QUANT * GPIO_MANCHESTER_IDLE_BITS + 1] = {
+    GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_SHORT,   GPIO_MANCHESTER_SHORT,
+    GPIO_MANCHESTER_SHORT,   GPIO_MANCHESTER_SHORT,   GPIO_MANCHESTER_LONG,    GPIO_MANCHESTER_LONG,
+    GPIO_MANCHESTER_LONG,    GPIO_MANCHESTER_LONG,    GPIO_MANCHESTER_LONG,    GPIO_MANCHESTER_INVALID,
+    GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID,
+    GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID,
+    GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID, GPIO_MANCHESTER_INVALID,
+    GPIO_MANCHESTER_IDLE,
+};
+
+// 状态转移表[状态][间隔分类]: 位中间的边沿之间只有整位间隔, 半位间隔总是成对出现(中间经过位边界);
+// 未同步时第一个整位间隔之后的边沿一定在位中间
+static const uint8_t gpio_manchester_state_table[3][4] = {
+    {
+        GPIO_MANCHESTER_SYNC,
+        GPIO_MANCHESTER_MID | GPIO_MANCHESTER_EMIT,
+        GPIO_MANCHESTER_SYNC,
+        GPIO_MANCHESTER_SYNC | GPIO_MANCHESTER_END,
+    },
+    {
+        GPIO_MANCHESTER_BOUNDARY,
+        GPIO_MANCHESTER_MID | GPIO_MANCHESTER_EMIT,
+        GPIO_MANCHESTER_SYNC | GPIO_MANCHESTER_ERROR,
+        GPIO_MANCHESTER_SYNC | GPIO_MANCHESTER_END,
+    },
+    {
+        GPIO_MANCHESTER_MID | GPIO_MANCHESTER_EMIT,
+        GPIO_MANCHESTER_SYNC | GPIO_MANCHESTER_ERROR,
+        GPIO_MANCHESTER_SYNC | GPIO_MANCHESTER_ERROR,
+        GPIO_MANCHESTER_SYNC | GPIO_MANCHESTER_END,
+    },
+};
+
+/**
+ * @brief  写入帧缓冲区(调用者持有锁并已确认空间足够)
+ * @param  dec : 输入参数, 解码器
+ * @param  data: 输入参数, 数据
+ * @param  len : 输入参数, 长度
+ */
+static void gpio_manchester_ring_write(gpio_manchester_t *dec, const uint8_t *data, const uint32_t len)
+{
+    uint32_t pos = (dec->ring_head + dec->ring_count) % dec->config.ring_size;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        dec->ring[pos] = data[i];
+        pos = (pos + 1) % dec->config.ring_size;
+    }
+
+    dec->ring_count += len;
+}
+
+/**
+ * @brief  从帧缓冲区读出(调用者持有锁并已确认数据足够)
+ * @param  data: 输出参数, 数据, 为NULL时丢弃
+ * @param  dec : 输入参数, 解码器
+ * @param  len : 输入参数, 长度
+ */
+static void gpio_manchester_ring_read(uint8_t *data, gpio_manchester_t *dec, const uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (data)
+        {
+            data[i] = dec->ring[dec->ring_head];
+        }
+
+        dec->ring_head = (dec->ring_head + 1) % dec->config.ring_size;
+    }
+
+    dec->ring_count -= len;
+}
+
+/**
+ * @brief  结束当前帧: 有数据时放入帧缓冲区, 不完整的最后一个字节被丢弃, 然后重新等待同步
+ * @param  dec : 输入参数, 解码器
+ * @param  keep: 输入参数, 是否保留当前帧(出错时为false)
+ */
+static void gpio_manchester_end_frame(gpio_manchester_t *dec, const bool keep)
+{
+    uint8_t header[GPIO_MANCHESTER_RECORD_HEADER] = {0};
+    // 被截断的帧frame_len为GPIO_MANCHESTER_MAX_FRAME + 1
+    uint16_t len = (dec->frame_len > GPIO_MANCHESTER_MAX_FRAME) ? GPIO_MANCHESTER_MAX_FRAME : dec->frame_len;
+
+    if ((keep) && (dec->in_frame) && (0 != len))
+    {
+        header[0] = (uint8_t)(len & 0xFF);
+        header[1] = (uint8_t)(len >> 8);
+        memcpy(&header[2], &dec->frame_ns, sizeof(uint64_t));
+        pthread_mutex_lock(&dec->mutex);
+        if (dec->config.ring_size - dec->ring_count < (uint32_t)GPIO_MANCHESTER_RECORD_HEADER + len)
+        {
+            dec->stats.overflows++;
+        }
+        else
+        {
+            gpio_manchester_ring_write(dec, header, GPIO_MANCHESTER_RECORD_HEADER);
+            gpio_manchester_ring_write(dec, dec->frame, len);
+            dec->stats.frames++;
+        }
+
+        pthread_mutex_unlock(&dec->mutex);
+    }
+
+    dec->in_frame = false;
+    dec->shift = 0;
+    dec->frame_len = 0;
+    dec->byte = 0;
+    dec->bit_count = 0;
+}
+
+/**
+ * @brief  处理解码出的一位: 未找到同步字时移入同步字寄存器, 之后组装字节
+ * @param  dec         : 输入参数, 解码器
+ * @param  bit         : 输入参数, 位
+ * @param  timestamp_ns: 输入参数, 位中间边沿的时间戳, 单位: ns
+ */
+static void gpio_manchester_bit(gpio_manchester_t *dec, const uint8_t bit, const uint64_t timestamp_ns)
+{
+    const gpio_manchester_format_t *format = &dec->config.format;
+    uint32_t mask = (format->sync_bits >= 32) ? UINT32_MAX : ((1U << format->sync_bits) - 1);
+
+    dec->stats.bits++;
+    if (!dec->in_frame)
+    {
+        dec->shift = (dec->shift << 1) | bit;
+        if (0 != format->sync_bits)
+        {
+            dec->in_frame = ((dec->shift & mask) == (format->sync_word & mask));
+
+            return;
+        }
+
+        dec->in_frame = true;
+    }
+
+    if ((0 == dec->frame_len) && (0 == dec->bit_count))
+    {
+        dec->frame_ns = timestamp_ns;
+    }
+
+    dec->byte = format->msb_first ? (uint8_t)((dec->byte << 1) | bit) : (uint8_t)(dec->byte | (bit << dec->bit_count));
+    if (++dec->bit_count < 8)
+    {
+        return;
+    }
+
+    if (dec->frame_len < GPIO_MANCHESTER_MAX_FRAME)
+    {
+        dec->frame[dec->frame_len++] = dec->byte;
+    }
+    else if (GPIO_MANCHESTER_MAX_FRAME == dec->frame_len)
+    {
+        // 超出的字节丢弃, 每帧只计数一次
+        dec->stats.truncated++;
+        dec->frame_len++;
+    }
+
+    dec->byte = 0;
+    dec->bit_count = 0;
+}
+
+/**
+ * @brief  初始化曼彻斯特解码器
+ * @param  dec   : 输出参数, 解码器
+ * @param  config: 输入参数, 解码器配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_manchester_init(gpio_manchester_t *dec, const gpio_manchester_config_t *config)
+{
+    uint64_t bit = 0;
+
+    if ((!dec) || (!config) || (!config->group) || (config->index >= config->group->num) || (0 == config->bit_ns) ||
+        (config->format.sync_bits > 32))
+    {
+        return false;
+    }
+
+    bit = 1ULL << config->index;
+    if ((!(config->group->rising_mask & bit)) || (!(config->group->falling_mask & bit)))
+    {
+        return false;
+    }
+
+    memset(dec, 0, sizeof(gpio_manchester_t));
+    dec->config = *config;
+    if (0 == dec->config.ring_size)
+    {
+        dec->config.ring_size = GPIO_MANCHESTER_DEFAULT_RING_SIZE;
+    }
+
+    if (dec->config.ring_size < GPIO_MANCHESTER_RECORD_HEADER + GPIO_MANCHESTER_MAX_FRAME)
+    {
+        return false;
+    }
+
+    dec->ring = malloc(dec->config.ring_size);
+    if (!dec->ring)
+    {
+        return false;
+    }
+
+    if (0 != pthread_mutex_init(&dec->mutex, NULL))
+    {
+        free(dec->ring);
+        dec->ring = NULL;
+
+        return false;
+    }
+
+    dec->state = GPIO_MANCHESTER_SYNC;
+    dec->period_ns = config->bit_ns;
+
+    return true;
+}
+
+/**
+ * @brief  释放曼彻斯特解码器
+ * @param  dec: 输入参数, 解码器
+ */
+void gpio_manchester_deinit(gpio_manchester_t *dec)
+{
+    if ((!dec) || (!dec->ring))
+    {
+        return;
+    }
+
+    pthread_mutex_destroy(&dec->mutex);
+    free(dec->ring);
+    dec->ring = NULL;
+}
+
+/**
+ * @brief  处理边沿事件: 按与跟踪位周期的比值把边沿间隔分为半位/整位/无效/空闲, 再查状态转移表得到位
+ * @note   可直接作为gpio_loop的回调函数, arg为解码器
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 解码器
+ */
+void gpio_manchester_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_manchester_t *dec = (gpio_manchester_t *)arg;
+    uint64_t interval = 0;
+    uint64_t quant = 0;
+    uint64_t measured = 0;
+    uint8_t class = 0;
+    uint8_t entry = 0;
+
+    if ((!dec) || (!event) || (group != dec->config.group) || (event->index != dec->config.index))
+    {
+        return;
+    }
+
+    // 丢失或合并的边沿使间隔失效, 丢弃当前帧, 本边沿作为重新同步的起点
+    if ((0 != event->lost) || (event->count > 1))
+    {
+        dec->stats.lost += (0 != event->lost) ? event->lost : (event->count - 1);
+        gpio_manchester_end_frame(dec, false);
+        dec->state = GPIO_MANCHESTER_SYNC;
+        dec->last_ns = event->timestamp_ns;
+
+        return;
+    }
+
+    interval = event->timestamp_ns - dec->last_ns;
+    dec->last_ns = event->timestamp_ns;
+    quant = interval * GPIO_MANCHESTER_QUANT / dec->period_ns;
+    if (quant > GPIO_MANCHESTER_QUANT * GPIO_MANCHESTER_IDLE_BITS)
+    {
+        quant = GPIO_MANCHESTER_QUANT * GPIO_MANCHESTER_IDLE_BITS;
+    }
+
+    class = gpio_manchester_class_table[quant];
+    entry = gpio_manchester_state_table[dec->state][class];
+    dec->state = entry & GPIO_MANCHESTER_STATE_MASK;
+    if (entry & GPIO_MANCHESTER_END)
+    {
+        gpio_manchester_end_frame(dec, true);
+
+        return;
+    }
+
+    if (entry & GPIO_MANCHESTER_ERROR)
+    {
+        dec->stats.errors++;
+        gpio_manchester_end_frame(dec, false);
+
+        return;
+    }
+
+    // 跟踪位周期, 限制在标称值的1/2~2倍
+    if (GPIO_MANCHESTER_INVALID != class)
+    {
+        measured = (GPIO_MANCHESTER_SHORT == class) ? (interval * 2) : interval;
+        dec->period_ns = (uint64_t)((int64_t)dec->period_ns +
+                                    (((int64_t)measured - (int64_t)dec->period_ns) >> GPIO_MANCHESTER_TRACK_SHIFT));
+        if (dec->period_ns < dec->config.bit_ns / 2)
+        {
+            dec->period_ns = dec->config.bit_ns / 2;
+        }
+        else if (dec->period_ns > dec->config.bit_ns * 2)
+        {
+            dec->period_ns = dec->config.bit_ns * 2;
+        }
+    }
+
+    if (entry & GPIO_MANCHESTER_EMIT)
+    {
+        gpio_manchester_bit(dec,
+                            ((E_GPIO_RISING == event->edge) ? 1 : 0) ^
+                                ((E_GPIO_MANCHESTER_THOMAS == dec->config.format.convention) ? 1 : 0),
+                            event->timestamp_ns);
+    }
+}
+
+/**
+ * @brief  检查线路是否已空闲, 空闲时结束当前帧并放入帧缓冲区(最后一帧之后没有边沿时调用)
+ * @param  dec   : 输入参数, 解码器
+ * @param  now_ns: 输入参数, 当前时间(CLOCK_MONOTONIC), 单位: ns
+ */
+void gpio_manchester_flush(gpio_manchester_t *dec, const uint64_t now_ns)
+{
+    if ((!dec) || (!dec->in_frame) || (now_ns - dec->last_ns < dec->period_ns * GPIO_MANCHESTER_IDLE_BITS))
+    {
+        return;
+    }
+
+    gpio_manchester_end_frame(dec, true);
+    dec->state = GPIO_MANCHESTER_SYNC;
+}
+
+/**
+ * @brief  从帧缓冲区读取一帧
+ * @param  data        : 输出参数, 帧数据
+ * @param  timestamp_ns: 输出参数, 同步字之后第一个边沿的时间戳, 单位: ns, 可以为NULL
+ * @param  dec         : 输入参数, 解码器
+ * @param  max         : 输入参数, data的大小
+ * @return 成功: 帧长度, 没有帧时为0
+ *         失败: -1(帧长度超过max时该帧被丢弃)
+ */
+int gpio_manchester_read_frame(uint8_t *data, uint64_t *timestamp_ns, gpio_manchester_t *dec, const uint32_t max)
+{
+    uint8_t header[GPIO_MANCHESTER_RECORD_HEADER] = {0};
+    uint16_t len = 0;
+    int ret = 0;
+
+    if ((!data) || (!dec) || (!dec->ring))
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&dec->mutex);
+    if (0 == dec->ring_count)
+    {
+        pthread_mutex_unlock(&dec->mutex);
+
+        return 0;
+    }
+
+    gpio_manchester_ring_read(header, dec, GPIO_MANCHESTER_RECORD_HEADER);
+    len = (uint16_t)(header[0] | (header[1] << 8));
+    if (len > max)
+    {
+        gpio_manchester_ring_read(NULL, dec, len);
+        ret = -1;
+    }
+    else
+    {
+        gpio_manchester_ring_read(data, dec, len);
+        if (timestamp_ns)
+        {
+            memcpy(timestamp_ns, &header[2], sizeof(uint64_t));
+        }
+
+        ret = len;
+    }
+
+    pthread_mutex_unlock(&dec->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief  追加一位: 前半位和后半位各一步
+ * @param  pattern   : 输入参数, 波形
+ * @param  mask      : 输入参数, 输出GPIO掩码
+ * @param  convention: 输入参数, 编码约定
+ * @param  bit       : 输入参数, 位
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_manchester_append_bit(gpio_pattern_t *pattern, const uint64_t mask,
+                                       const gpio_manchester_convention_e convention, const uint8_t bit)
+{
+    // 位中间的跳变方向: IEEE的1为上升沿, 即后半位为高
+    uint8_t second = bit ^ ((E_GPIO_MANCHESTER_THOMAS == convention) ? 1 : 0);
+
+    return (gpio_pattern_append(pattern, second ? 0 : mask, false) >= 0) &&
+           (gpio_pattern_append(pattern, second ? mask : 0, false) >= 0);
+}
+
+/**
+ * @brief  把一帧编码追加到波形, 每半位一步, 以位周期的一半作为step_ns播放
+ * @note   波形掩码应只包含输出GPIO, 编码后追加一步空闲电平
+ * @param  pattern: 输入参数, 波形
+ * @param  index  : 输入参数, 输出GPIO在组内的序号
+ * @param  format : 输入参数, 帧格式
+ * @param  data   : 输入参数, 数据
+ * @param  len    : 输入参数, 数据长度
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_manchester_encode(gpio_pattern_t *pattern, const uint8_t index, const gpio_manchester_format_t *format,
+                            const uint8_t *data, const uint32_t len)
+{
+    uint64_t mask = 0;
+    uint8_t bit = 0;
+
+    if ((!pattern) || (index >= GPIO_GROUP_MAX_NUM) || (!format) || ((!data) && (0 != len)) ||
+        (format->sync_bits > 32))
+    {
+        return false;
+    }
+
+    mask = 1ULL << index;
+    if (!(pattern->mask & mask))
+    {
+        return false;
+    }
+
+    // 前导码: 1010..., 每个间隔都是整位, 便于解码器同步和跟踪位周期
+    for (uint8_t i = 0; i < format->preamble_bits; i++)
+    {
+        if (!gpio_manchester_append_bit(pattern, mask, format->convention, (i & 1) ? 0 : 1))
+        {
+            return false;
+        }
+    }
+
+    for (uint8_t i = format->sync_bits; i > 0; i--)
+    {
+        if (!gpio_manchester_append_bit(pattern, mask, format->convention, (format->sync_word >> (i - 1)) & 1))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            bit = format->msb_first ? ((data[i] >> (7 - j)) & 1) : ((data[i] >> j) & 1);
+            if (!gpio_manchester_append_bit(pattern, mask, format->convention, bit))
+            {
+                return false;
+            }
+        }
+    }
+
+    return gpio_pattern_append(pattern, format->idle_high ? mask : 0, false) >= 0;
+}
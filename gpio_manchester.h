@@ -0,0 +1,182 @@
+/**
+ * @file      : gpio_manchester.h
+ * @brief     : 曼彻斯特(双相)编码解码头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 12:08:33
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_MANCHESTER_H
+#define __GPIO_MANCHESTER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "./gpio_group.h"
+#include "./gpio_pattern.h"
+
+// 一帧最多的数据字节个数
+#define GPIO_MANCHESTER_MAX_FRAME 256
+
+// 默认帧缓冲区大小(字节)
+#define GPIO_MANCHESTER_DEFAULT_RING_SIZE 4096
+
+// 线路空闲超过该位数时认为一帧结束
+#define GPIO_MANCHESTER_IDLE_BITS 3
+
+// 编码约定
+typedef enum
+{
+    // IEEE 802.3: 位中间上升沿为1, 下降沿为0
+    E_GPIO_MANCHESTER_IEEE = 0,
+    // G.E. Thomas: 位中间下降沿为1, 上升沿为0
+    E_GPIO_MANCHESTER_THOMAS = 1,
+} gpio_manchester_convention_e;
+
+// 帧格式(编码和解码共用): 前导码(交替位) + 同步字 + 数据, 之后线路保持空闲电平
+typedef struct
+{
+    gpio_manchester_convention_e convention;
+    // 数据字节高位先发
+    bool msb_first;
+    // 同步字(高位先发)和位数[0, 32], 0表示位同步后直接接收数据
+    uint32_t sync_word;
+    uint8_t sync_bits;
+    // 前导码位数(从1开始交替, 只用于编码), 解码时至少需要2位才能建立位同步
+    uint8_t preamble_bits;
+    // 空闲电平为高
+    bool idle_high;
+} gpio_manchester_format_t;
+
+// 解码器配置
+typedef struct
+{
+    // 输入GPIO组(检测双边沿), 位速率较高时应增大内核事件缓冲区
+    gpio_group_t *group;
+    // 输入GPIO在组内的序号
+    uint8_t index;
+    // 标称位周期, 单位: ns
+    uint64_t bit_ns;
+    gpio_manchester_format_t format;
+    // 帧缓冲区大小(字节), 0表示使用GPIO_MANCHESTER_DEFAULT_RING_SIZE
+    uint32_t ring_size;
+} gpio_manchester_config_t;
+
+// 解码统计
+typedef struct
+{
+    // 放入帧缓冲区的帧个数
+    uint64_t frames;
+    // 解码的位数
+    uint64_t bits;
+    // 间隔无法识别(不是半位或整位)的次数, 当前帧被丢弃
+    uint64_t errors;
+    // 帧缓冲区已满丢弃的帧个数
+    uint64_t overflows;
+    // 超过GPIO_MANCHESTER_MAX_FRAME被截断的帧个数
+    uint64_t truncated;
+    // 内核丢失或事件循环合并的事件个数
+    uint64_t lost;
+} gpio_manchester_stats_t;
+
+// 曼彻斯特解码器
+typedef struct
+{
+    gpio_manchester_config_t config;
+    // 保护帧缓冲区(解码在事件循环线程, 读取可在其他线程)
+    pthread_mutex_t mutex;
+    // 帧缓冲区: 每帧为2字节长度 + 8字节时间戳 + 数据
+    uint8_t *ring;
+    uint32_t ring_head;
+    uint32_t ring_count;
+    // 解码状态(查表)
+    uint8_t state;
+    // 已找到同步字
+    bool in_frame;
+    // 上一个边沿时间戳, 单位: ns
+    uint64_t last_ns;
+    // 跟踪的位周期, 单位: ns
+    uint64_t period_ns;
+    // 同步字移位寄存器
+    uint32_t shift;
+    // 当前帧
+    uint8_t frame[GPIO_MANCHESTER_MAX_FRAME];
+    uint16_t frame_len;
+    uint64_t frame_ns;
+    uint8_t byte;
+    uint8_t bit_count;
+    gpio_manchester_stats_t stats;
+} gpio_manchester_t;
+
+/**
+ * @brief  初始化曼彻斯特解码器
+ * @param  dec   : 输出参数, 解码器
+ * @param  config: 输入参数, 解码器配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_manchester_init(gpio_manchester_t *dec, const gpio_manchester_config_t *config);
+
+/**
+ * @brief  释放曼彻斯特解码器
+ * @param  dec: 输入参数, 解码器
+ */
+void gpio_manchester_deinit(gpio_manchester_t *dec);
+
+/**
+ * @brief  处理边沿事件: 按与跟踪位周期的比值把边沿间隔分为半位/整位/无效/空闲, 再查状态转移表得到位
+ * @note   可直接作为gpio_loop的回调函数, arg为解码器
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 解码器
+ */
+void gpio_manchester_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+/**
+ * @brief  检查线路是否已空闲, 空闲时结束当前帧并放入帧缓冲区(最后一帧之后没有边沿时调用)
+ * @param  dec   : 输入参数, 解码器
+ * @param  now_ns: 输入参数, 当前时间(CLOCK_MONOTONIC), 单位: ns
+ */
+void gpio_manchester_flush(gpio_manchester_t *dec, const uint64_t now_ns);
+
+/**
+ * @brief  从帧缓冲区读取一帧
+ * @param  data        : 输出参数, 帧数据
+ * @param  timestamp_ns: 输出参数, 同步字之后第一个边沿的时间戳, 单位: ns, 可以为NULL
+ * @param  dec         : 输入参数, 解码器
+ * @param  max         : 输入参数, data的大小
+ * @return 成功: 帧长度, 没有帧时为0
+ *         失败: -1(帧长度超过max时该帧被丢弃)
+ */
+int gpio_manchester_read_frame(uint8_t *data, uint64_t *timestamp_ns, gpio_manchester_t *dec, const uint32_t max);
+
+/**
+ * @brief  把一帧编码追加到波形, 每半位一步, 以位周期的一半作为step_ns播放
+ * @note   波形掩码应只包含输出GPIO, 编码后追加一步空闲电平
+ * @param  pattern: 输入参数, 波形
+ * @param  index  : 输入参数, 输出GPIO在组内的序号
+ * @param  format : 输入参数, 帧格式
+ * @param  data   : 输入参数, 数据
+ * @param  len    : 输入参数, 数据长度
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_manchester_encode(gpio_pattern_t *pattern, const uint8_t index, const gpio_manchester_format_t *format,
+                            const uint8_t *data, const uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_MANCHESTER_H
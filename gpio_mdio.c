@@ -0,0 +1,541 @@
+/**
+ * @file      : gpio_mdio.c
+ * @brief     : GPIO模拟MDIO主机(PHY管理接口)源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 09:12:37
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_mdio.h"
+
+// 帧起始(ST)和操作码(OP), 共4位
+#define GPIO_MDIO_C22_READ 0x6
+#define GPIO_MDIO_C22_WRITE 0x5
+#define GPIO_MDIO_C45_ADDRESS 0x0
+#define GPIO_MDIO_C45_WRITE 0x1
+#define GPIO_MDIO_C45_READ 0x3
+
+// 写入帧的转换周期(10)
+#define GPIO_MDIO_TA_WRITE 0x2
+
+// 读取数据阶段的采样个数: 转换周期第2位 + 16位数据
+#define GPIO_MDIO_READ_SAMPLES 17
+
+/**
+ * @brief  追加若干位(MSB优先): MDC低电平时输出MDIO, 再输出MDC上升沿(PHY在上升沿采样)
+ * @param  mdio: 输入参数, MDIO主机
+ * @param  data: 输入参数, 数据
+ * @param  bits: 输入参数, 位数(1~32)
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_mdio_append_bits(gpio_mdio_t *mdio, const uint32_t data, const uint8_t bits)
+{
+    uint64_t mdc = 1ULL << mdio->config.mdc;
+    uint64_t dio = 0;
+
+    for (uint8_t i = bits; i > 0; i--)
+    {
+        dio = ((data >> (i - 1)) & 1) ? (1ULL << mdio->config.mdio) : 0;
+        if ((gpio_pattern_append(&mdio->pattern, dio, false) < 0) ||
+            (gpio_pattern_append(&mdio->pattern, dio | mdc, false) < 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  追加一帧中由主机驱动的部分: 前导码、ST/OP、PHY地址、寄存器/设备地址, 写入帧还包括转换周期和数据
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  st_op: 输入参数, 帧起始和操作码
+ * @param  phy  : 输入参数, PHY地址
+ * @param  reg  : 输入参数, clause 22寄存器地址或clause 45设备地址
+ * @param  write: 输入参数, 是否为写入帧(包括clause 45地址帧)
+ * @param  data : 输入参数, 写入的数据或clause 45寄存器地址
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_mdio_append_frame(gpio_mdio_t *mdio, const uint8_t st_op, const uint8_t phy, const uint8_t reg,
+                                   const bool write, const uint16_t data)
+{
+    uint8_t preamble = (mdio->suppress_mask & (1U << phy)) ? 1 : mdio->config.preamble_bits;
+    uint32_t header = ((uint32_t)st_op << 10) | ((uint32_t)phy << 5) | reg;
+
+    if ((!gpio_mdio_append_bits(mdio, UINT32_MAX, preamble)) || (!gpio_mdio_append_bits(mdio, header, 14)))
+    {
+        return false;
+    }
+
+    if ((write) && (!gpio_mdio_append_bits(mdio, ((uint32_t)GPIO_MDIO_TA_WRITE << 16) | data, 18)))
+    {
+        return false;
+    }
+
+    mdio->stats.frames++;
+
+    return true;
+}
+
+/**
+ * @brief  输出已追加的帧, 结束时MDC低电平、MDIO空闲高电平
+ * @param  mdio: 输入参数, MDIO主机
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_mdio_flush(gpio_mdio_t *mdio)
+{
+    bool ret = false;
+
+    if (0 == mdio->pattern.num)
+    {
+        return true;
+    }
+
+    ret = (gpio_pattern_append(&mdio->pattern, (1ULL << mdio->config.mdio), false) >= 0) &&
+          gpio_pattern_play(NULL, &mdio->pattern, mdio->config.group, NULL, 0, mdio->config.half_period_ns);
+    gpio_pattern_clear(&mdio->pattern);
+
+    return ret;
+}
+
+/**
+ * @brief  读取帧的数据阶段: 释放MDIO, 输出转换周期和16位数据的时钟并采样, 再恢复主机驱动
+ * @param  value: 输出参数, 读取结果, PHY无应答时为0xFFFF
+ * @param  mdio : 输入参数, MDIO主机
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_mdio_read_data(uint16_t *value, gpio_mdio_t *mdio)
+{
+    uint64_t dio = 1ULL << mdio->config.mdio;
+    uint8_t samples[(GPIO_MDIO_READ_SAMPLES + 7) / 8] = {0};
+    uint16_t result = 0;
+    bool ret = false;
+
+    if (!gpio_group_set_direction(mdio->config.group, dio, E_GPIO_IN, 0))
+    {
+        return false;
+    }
+
+    ret = gpio_pattern_play(samples, &mdio->read_pattern, mdio->config.group, mdio->config.group,
+                            mdio->config.mdio, mdio->config.half_period_ns);
+
+    // 无论是否成功都恢复为主机驱动
+    if ((!gpio_group_set_direction(mdio->config.group, dio, E_GPIO_OUT, dio)) || (!ret))
+    {
+        return false;
+    }
+
+    // PHY在转换周期第2位拉低MDIO, 否则认为无应答
+    if (samples[0] & 1)
+    {
+        mdio->stats.no_response++;
+        *value = UINT16_MAX;
+
+        return true;
+    }
+
+    for (uint8_t i = 1; i < GPIO_MDIO_READ_SAMPLES; i++)
+    {
+        result = (uint16_t)((result << 1) | ((samples[i / 8] >> (i % 8)) & 1));
+    }
+
+    *value = result;
+
+    return true;
+}
+
+/**
+ * @brief  编译读取数据阶段的固定波形
+ * @note   每位先输出MDC低电平, 再保持一步后采样(PHY在上升沿后才更新数据), 最后输出MDC上升沿;
+ *         电平未变化的步骤不产生系统调用, 只用于延时
+ * @param  mdio: 输入参数, MDIO主机
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_mdio_compile_read(gpio_mdio_t *mdio)
+{
+    uint64_t mdc = 1ULL << mdio->config.mdc;
+    uint64_t dio = 1ULL << mdio->config.mdio;
+
+    // 转换周期第1位: 主机和PHY都不驱动
+    if ((gpio_pattern_append(&mdio->read_pattern, dio, false) < 0) ||
+        (gpio_pattern_append(&mdio->read_pattern, dio | mdc, false) < 0))
+    {
+        return false;
+    }
+
+    // 转换周期第2位和16位数据
+    for (uint8_t i = 0; i < GPIO_MDIO_READ_SAMPLES; i++)
+    {
+        if ((gpio_pattern_append(&mdio->read_pattern, dio, false) < 0) ||
+            (gpio_pattern_append(&mdio->read_pattern, dio, true) < 0) ||
+            (gpio_pattern_append(&mdio->read_pattern, dio | mdc, false) < 0))
+        {
+            return false;
+        }
+    }
+
+    // 1个空闲时钟, 让PHY释放MDIO
+    if ((gpio_pattern_append(&mdio->read_pattern, dio, false) < 0) ||
+        (gpio_pattern_append(&mdio->read_pattern, dio | mdc, false) < 0) ||
+        (gpio_pattern_append(&mdio->read_pattern, dio, false) < 0))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  初始化MDIO主机, MDC输出低电平, MDIO输出高电平(空闲)
+ * @param  mdio  : 输出参数, MDIO主机
+ * @param  config: 输入参数, MDIO配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_init(gpio_mdio_t *mdio, const gpio_mdio_config_t *config)
+{
+    uint64_t mask = 0;
+
+    if ((!mdio) || (!config) || (!config->group) || (config->mdc >= config->group->num) ||
+        (config->mdio >= config->group->num) || (config->mdc == config->mdio) || (config->preamble_bits > 32))
+    {
+        return false;
+    }
+
+    memset(mdio, 0, sizeof(gpio_mdio_t));
+    mdio->config = *config;
+    if (0 == mdio->config.preamble_bits)
+    {
+        mdio->config.preamble_bits = GPIO_MDIO_DEFAULT_PREAMBLE;
+    }
+
+    mask = (1ULL << config->mdc) | (1ULL << config->mdio);
+    if (!gpio_pattern_init(&mdio->pattern, mask, 0))
+    {
+        return false;
+    }
+
+    if ((!gpio_pattern_init(&mdio->read_pattern, mask, 64)) || (!gpio_mdio_compile_read(mdio)) ||
+        (!gpio_group_set_direction(config->group, mask, E_GPIO_OUT, (1ULL << config->mdio))) ||
+        (!gpio_group_set_values(config->group, mask, (1ULL << config->mdio))))
+    {
+        gpio_mdio_deinit(mdio);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  释放MDIO主机(不关闭GPIO组)
+ * @param  mdio: 输入参数, MDIO主机
+ */
+void gpio_mdio_deinit(gpio_mdio_t *mdio)
+{
+    if (!mdio)
+    {
+        return;
+    }
+
+    gpio_pattern_deinit(&mdio->pattern);
+    gpio_pattern_deinit(&mdio->read_pattern);
+}
+
+/**
+ * @brief  设置PHY是否使用前导码抑制
+ * @param  mdio  : 输入参数, MDIO主机
+ * @param  phy   : 输入参数, PHY地址
+ * @param  enable: 输入参数, true: 只输出1位前导码, false: 输出完整前导码
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_set_preamble_suppression(gpio_mdio_t *mdio, const uint8_t phy, const bool enable)
+{
+    if ((!mdio) || (phy >= GPIO_MDIO_MAX_PHYS))
+    {
+        return false;
+    }
+
+    if (enable)
+    {
+        mdio->suppress_mask |= (1U << phy);
+    }
+    else
+    {
+        mdio->suppress_mask &= ~(1U << phy);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  读取各PHY的BMSR, 对声明支持前导码抑制的PHY启用前导码抑制
+ * @param  suppress_mask: 输出参数, 启用前导码抑制的PHY地址掩码, 可以为NULL
+ * @param  mdio         : 输入参数, MDIO主机
+ * @param  phy_mask     : 输入参数, 检测的PHY地址掩码
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_detect_preamble_suppression(uint32_t *suppress_mask, gpio_mdio_t *mdio, const uint32_t phy_mask)
+{
+    gpio_mdio_op_t ops[GPIO_MDIO_MAX_PHYS] = {0};
+    uint32_t num = 0;
+
+    if (!mdio)
+    {
+        return false;
+    }
+
+    // 检测时使用完整前导码
+    mdio->suppress_mask &= ~phy_mask;
+    for (uint8_t phy = 0; phy < GPIO_MDIO_MAX_PHYS; phy++)
+    {
+        if (phy_mask & (1U << phy))
+        {
+            ops[num].op = E_GPIO_MDIO_READ;
+            ops[num].phy = phy;
+            ops[num].reg = GPIO_MDIO_REG_BMSR;
+            num++;
+        }
+    }
+
+    if (!gpio_mdio_run(mdio, ops, num))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if ((UINT16_MAX != ops[i].value) && (ops[i].value & GPIO_MDIO_BMSR_PREAMBLE_SUPPRESSION))
+        {
+            mdio->suppress_mask |= (1U << ops[i].phy);
+        }
+    }
+
+    if (suppress_mask)
+    {
+        *suppress_mask = mdio->suppress_mask;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  批量执行MDIO操作: 连续的写入帧合并为一个波形播放, 读取时才切换MDIO方向
+ * @param  mdio: 输入参数, MDIO主机
+ * @param  ops : 输入输出参数, 操作列表, 读取结果写回value
+ * @param  num : 输入参数, 操作个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_run(gpio_mdio_t *mdio, gpio_mdio_op_t *ops, const uint32_t num)
+{
+    gpio_mdio_op_t *op = NULL;
+    uint8_t reg = 0;
+
+    if ((!mdio) || ((!ops) && (0 != num)))
+    {
+        return false;
+    }
+
+    // 先检查全部操作, 避免执行一半才发现参数错误
+    for (uint32_t i = 0; i < num; i++)
+    {
+        op = &ops[i];
+        if ((op->phy >= GPIO_MDIO_MAX_PHYS) || ((op->c45) && (op->dev >= 32)) || ((!op->c45) && (op->reg >= 32)) ||
+            ((E_GPIO_MDIO_READ != op->op) && (E_GPIO_MDIO_WRITE != op->op)))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        op = &ops[i];
+        reg = op->c45 ? op->dev : (uint8_t)op->reg;
+        if ((op->c45) && (!gpio_mdio_append_frame(mdio, GPIO_MDIO_C45_ADDRESS, op->phy, op->dev, true, op->reg)))
+        {
+            goto error;
+        }
+
+        if (E_GPIO_MDIO_WRITE == op->op)
+        {
+            if (!gpio_mdio_append_frame(mdio, op->c45 ? GPIO_MDIO_C45_WRITE : GPIO_MDIO_C22_WRITE, op->phy, reg, true,
+                                        op->value))
+            {
+                goto error;
+            }
+
+            mdio->stats.writes++;
+
+            continue;
+        }
+
+        // 读取帧: 输出之前积累的写入帧和本帧的主机驱动部分, 再读取数据
+        if ((!gpio_mdio_append_frame(mdio, op->c45 ? GPIO_MDIO_C45_READ : GPIO_MDIO_C22_READ, op->phy, reg, false,
+                                     0)) ||
+            (!gpio_pattern_play(NULL, &mdio->pattern, mdio->config.group, NULL, 0, mdio->config.half_period_ns)))
+        {
+            goto error;
+        }
+
+        gpio_pattern_clear(&mdio->pattern);
+        if (!gpio_mdio_read_data(&op->value, mdio))
+        {
+            return false;
+        }
+
+        mdio->stats.reads++;
+    }
+
+    return gpio_mdio_flush(mdio);
+
+error:
+    gpio_pattern_clear(&mdio->pattern);
+
+    return false;
+}
+
+/**
+ * @brief  clause 22读寄存器
+ * @param  value: 输出参数, 寄存器值, PHY无应答时为0xFFFF
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  phy  : 输入参数, PHY地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_read(uint16_t *value, gpio_mdio_t *mdio, const uint8_t phy, const uint8_t reg)
+{
+    gpio_mdio_op_t op = {E_GPIO_MDIO_READ, false, phy, 0, reg, 0};
+
+    if ((!value) || (!gpio_mdio_run(mdio, &op, 1)))
+    {
+        return false;
+    }
+
+    *value = op.value;
+
+    return true;
+}
+
+/**
+ * @brief  clause 22写寄存器
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  phy  : 输入参数, PHY地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_write(gpio_mdio_t *mdio, const uint8_t phy, const uint8_t reg, const uint16_t value)
+{
+    gpio_mdio_op_t op = {E_GPIO_MDIO_WRITE, false, phy, 0, reg, value};
+
+    return gpio_mdio_run(mdio, &op, 1);
+}
+
+/**
+ * @brief  clause 45读寄存器(地址帧 + 读取帧)
+ * @param  value: 输出参数, 寄存器值, PHY无应答时为0xFFFF
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  port : 输入参数, 端口地址
+ * @param  dev  : 输入参数, 设备地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_c45_read(uint16_t *value, gpio_mdio_t *mdio, const uint8_t port, const uint8_t dev,
+                        const uint16_t reg)
+{
+    gpio_mdio_op_t op = {E_GPIO_MDIO_READ, true, port, dev, reg, 0};
+
+    if ((!value) || (!gpio_mdio_run(mdio, &op, 1)))
+    {
+        return false;
+    }
+
+    *value = op.value;
+
+    return true;
+}
+
+/**
+ * @brief  clause 45写寄存器(地址帧 + 写入帧)
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  port : 输入参数, 端口地址
+ * @param  dev  : 输入参数, 设备地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_c45_write(gpio_mdio_t *mdio, const uint8_t port, const uint8_t dev, const uint16_t reg,
+                         const uint16_t value)
+{
+    gpio_mdio_op_t op = {E_GPIO_MDIO_WRITE, true, port, dev, reg, value};
+
+    return gpio_mdio_run(mdio, &op, 1);
+}
+
+/**
+ * @brief  轮询多个PHY的链路状态(批量读取BMSR)
+ * @note   BMSR链路状态位为锁存低电平, 一次读取为1表示自上次读取以来链路一直正常, 适合周期性轮询发现链路抖动
+ * @param  link_mask: 输出参数, 链路正常的PHY地址掩码
+ * @param  mdio     : 输入参数, MDIO主机
+ * @param  phy_mask : 输入参数, 轮询的PHY地址掩码
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_poll_link(uint32_t *link_mask, gpio_mdio_t *mdio, const uint32_t phy_mask)
+{
+    gpio_mdio_op_t ops[GPIO_MDIO_MAX_PHYS] = {0};
+    uint32_t num = 0;
+    uint32_t mask = 0;
+
+    if (!link_mask)
+    {
+        return false;
+    }
+
+    for (uint8_t phy = 0; phy < GPIO_MDIO_MAX_PHYS; phy++)
+    {
+        if (phy_mask & (1U << phy))
+        {
+            ops[num].op = E_GPIO_MDIO_READ;
+            ops[num].phy = phy;
+            ops[num].reg = GPIO_MDIO_REG_BMSR;
+            num++;
+        }
+    }
+
+    if (!gpio_mdio_run(mdio, ops, num))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if ((UINT16_MAX != ops[i].value) && (ops[i].value & GPIO_MDIO_BMSR_LINK))
+        {
+            mask |= (1U << ops[i].phy);
+        }
+    }
+
+    *link_mask = mask;
+
+    return true;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file      : gpio_mdio.h
+ * @brief     : GPIO模拟MDIO主机(PHY管理接口)头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 09:12:37
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_MDIO_H
+#define __GPIO_MDIO_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+#include "./gpio_pattern.h"
+
+// PHY地址个数
+#define GPIO_MDIO_MAX_PHYS 32
+
+// 默认前导码位数
+#define GPIO_MDIO_DEFAULT_PREAMBLE 32
+
+// clause 22 基本状态寄存器(BMSR)及其中的位
+#define GPIO_MDIO_REG_BMSR 0x01
+#define GPIO_MDIO_BMSR_LINK 0x0004
+#define GPIO_MDIO_BMSR_PREAMBLE_SUPPRESSION 0x0040
+
+// MDIO操作类型
+typedef enum
+{
+    E_GPIO_MDIO_READ = 0,
+    E_GPIO_MDIO_WRITE = 1,
+} gpio_mdio_op_e;
+
+// MDIO操作, 用于批量执行
+typedef struct
+{
+    gpio_mdio_op_e op;
+    // 是否为clause 45帧, clause 45读写前自动发送地址帧
+    bool c45;
+    // PHY地址(clause 45为端口地址)
+    uint8_t phy;
+    // clause 45设备地址, clause 22不使用
+    uint8_t dev;
+    // 寄存器地址, clause 22只使用低5位
+    uint16_t reg;
+    // 写入值/读取结果, PHY无应答时读取结果为0xFFFF
+    uint16_t value;
+} gpio_mdio_op_t;
+
+// MDIO配置
+typedef struct
+{
+    // GPIO组(MDC和MDIO, 打开为输出, MDIO在读取数据时切换为输入)
+    gpio_group_t *group;
+    // MDC/MDIO在GPIO组内的序号
+    uint8_t mdc;
+    uint8_t mdio;
+    // 前导码位数, 0表示使用GPIO_MDIO_DEFAULT_PREAMBLE
+    uint8_t preamble_bits;
+    // MDC半周期, 单位: ns, 0表示以最快速度输出
+    uint64_t half_period_ns;
+} gpio_mdio_config_t;
+
+// MDIO统计
+typedef struct
+{
+    // 帧个数(包括clause 45地址帧)
+    uint64_t frames;
+    // 读取次数
+    uint64_t reads;
+    // 写入次数
+    uint64_t writes;
+    // 读取时PHY未在转换周期拉低MDIO的次数
+    uint64_t no_response;
+} gpio_mdio_stats_t;
+
+// MDIO主机
+typedef struct
+{
+    gpio_mdio_config_t config;
+    // 支持前导码抑制的PHY地址掩码, 这些PHY的帧只输出1位前导码
+    uint32_t suppress_mask;
+    // 待输出的帧(MDIO由主机驱动的部分), 连续的写入帧合并后一次播放
+    gpio_pattern_t pattern;
+    // 读取数据阶段(转换周期、16位数据和1个空闲时钟)的固定波形
+    gpio_pattern_t read_pattern;
+    gpio_mdio_stats_t stats;
+} gpio_mdio_t;
+
+/**
+ * @brief  初始化MDIO主机, MDC输出低电平, MDIO输出高电平(空闲)
+ * @param  mdio  : 输出参数, MDIO主机
+ * @param  config: 输入参数, MDIO配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_init(gpio_mdio_t *mdio, const gpio_mdio_config_t *config);
+
+/**
+ * @brief  释放MDIO主机(不关闭GPIO组)
+ * @param  mdio: 输入参数, MDIO主机
+ */
+void gpio_mdio_deinit(gpio_mdio_t *mdio);
+
+/**
+ * @brief  设置PHY是否使用前导码抑制
+ * @param  mdio  : 输入参数, MDIO主机
+ * @param  phy   : 输入参数, PHY地址
+ * @param  enable: 输入参数, true: 只输出1位前导码, false: 输出完整前导码
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_set_preamble_suppression(gpio_mdio_t *mdio, const uint8_t phy, const bool enable);
+
+/**
+ * @brief  读取各PHY的BMSR, 对声明支持前导码抑制的PHY启用前导码抑制
+ * @param  suppress_mask: 输出参数, 启用前导码抑制的PHY地址掩码, 可以为NULL
+ * @param  mdio         : 输入参数, MDIO主机
+ * @param  phy_mask     : 输入参数, 检测的PHY地址掩码
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_detect_preamble_suppression(uint32_t *suppress_mask, gpio_mdio_t *mdio, const uint32_t phy_mask);
+
+/**
+ * @brief  批量执行MDIO操作: 连续的写入帧合并为一个波形播放, 读取时才切换MDIO方向
+ * @param  mdio: 输入参数, MDIO主机
+ * @param  ops : 输入输出参数, 操作列表, 读取结果写回value
+ * @param  num : 输入参数, 操作个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_run(gpio_mdio_t *mdio, gpio_mdio_op_t *ops, const uint32_t num);
+
+/**
+ * @brief  clause 22读寄存器
+ * @param  value: 输出参数, 寄存器值, PHY无应答时为0xFFFF
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  phy  : 输入参数, PHY地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_read(uint16_t *value, gpio_mdio_t *mdio, const uint8_t phy, const uint8_t reg);
+
+/**
+ * @brief  clause 22写寄存器
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  phy  : 输入参数, PHY地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_write(gpio_mdio_t *mdio, const uint8_t phy, const uint8_t reg, const uint16_t value);
+
+/**
+ * @brief  clause 45读寄存器(地址帧 + 读取帧)
+ * @param  value: 输出参数, 寄存器值, PHY无应答时为0xFFFF
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  port : 输入参数, 端口地址
+ * @param  dev  : 输入参数, 设备地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_c45_read(uint16_t *value, gpio_mdio_t *mdio, const uint8_t port, const uint8_t dev,
+                        const uint16_t reg);
+
+/**
+ * @brief  clause 45写寄存器(地址帧 + 写入帧)
+ * @param  mdio : 输入参数, MDIO主机
+ * @param  port : 输入参数, 端口地址
+ * @param  dev  : 输入参数, 设备地址
+ * @param  reg  : 输入参数, 寄存器地址
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_c45_write(gpio_mdio_t *mdio, const uint8_t port, const uint8_t dev, const uint16_t reg,
+                         const uint16_t value);
+
+/**
+ * @brief  轮询多个PHY的链路状态(批量读取BMSR)
+ * @note   BMSR链路状态位为锁存低电平, 一次读取为1表示自上次读取以来链路一直正常, 适合周期性轮询发现链路抖动
+ * @param  link_mask: 输出参数, 链路正常的PHY地址掩码
+ * @param  mdio     : 输入参数, MDIO主机
+ * @param  phy_mask : 输入参数, 轮询的PHY地址掩码
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_mdio_poll_link(uint32_t *link_mask, gpio_mdio_t *mdio, const uint32_t phy_mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_MDIO_H
@@ -0,0 +1,234 @@
+/**
+ * @file      : gpio_pattern.c
+ * @brief     : GPIO波形缓冲区与播放源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 18:12:05
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "./gpio_pattern.h"
+
+/**
+ * @brief  获取CLOCK_MONOTONIC当前时间
+ * @return 当前时间, 单位: ns
+ */
+static uint64_t gpio_pattern_now_ns(void)
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  扩容波形缓冲区
+ * @param  pattern : 输入参数, 波形
+ * @param  capacity: 输入参数, 新容量(步数)
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_pattern_reserve(gpio_pattern_t *pattern, const uint32_t capacity)
+{
+    uint64_t *steps = NULL;
+    uint8_t *sample_flags = NULL;
+    uint32_t old_bytes = (pattern->capacity + 7) / 8;
+    uint32_t new_bytes = (capacity + 7) / 8;
+
+    steps = realloc(pattern->steps, (size_t)capacity * sizeof(uint64_t));
+    if (!steps)
+    {
+        return false;
+    }
+
+    pattern->steps = steps;
+
+    sample_flags = realloc(pattern->sample_flags, new_bytes);
+    if (!sample_flags)
+    {
+        return false;
+    }
+
+    memset(sample_flags + old_bytes, 0, new_bytes - old_bytes);
+    pattern->sample_flags = sample_flags;
+    pattern->capacity = capacity;
+
+    return true;
+}
+
+/**
+ * @brief  初始化波形缓冲区
+ * @param  pattern : 输出参数, 波形
+ * @param  mask    : 输入参数, 输出GPIO掩码, bit i对应输出GPIO组内第i个GPIO
+ * @param  capacity: 输入参数, 初始容量(步数), 0表示使用GPIO_PATTERN_DEFAULT_CAPACITY, 不足时自动扩容
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pattern_init(gpio_pattern_t *pattern, const uint64_t mask, const uint32_t capacity)
+{
+    if (!pattern)
+    {
+        return false;
+    }
+
+    memset(pattern, 0, sizeof(gpio_pattern_t));
+    pattern->mask = mask;
+    if (!gpio_pattern_reserve(pattern, (0 == capacity) ? GPIO_PATTERN_DEFAULT_CAPACITY : capacity))
+    {
+        gpio_pattern_deinit(pattern);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  释放波形缓冲区
+ * @param  pattern: 输入参数, 波形
+ */
+void gpio_pattern_deinit(gpio_pattern_t *pattern)
+{
+    if (!pattern)
+    {
+        return;
+    }
+
+    free(pattern->steps);
+    free(pattern->sample_flags);
+    memset(pattern, 0, sizeof(gpio_pattern_t));
+}
+
+/**
+ * @brief  清空已编译的步骤, 保留缓冲区复用
+ * @param  pattern: 输入参数, 波形
+ */
+void gpio_pattern_clear(gpio_pattern_t *pattern)
+{
+    if ((!pattern) || (!pattern->sample_flags))
+    {
+        return;
+    }
+
+    memset(pattern->sample_flags, 0, (pattern->num + 7) / 8);
+    pattern->num = 0;
+    pattern->sample_num = 0;
+}
+
+/**
+ * @brief  追加一步
+ * @param  pattern: 输入参数, 波形
+ * @param  values : 输入参数, 输出电平值
+ * @param  sample : 输入参数, 本步输出后是否采样输入
+ * @return 成功: 本步采样的序号(不采样时为已有采样个数)
+ *         失败: -1
+ */
+int64_t gpio_pattern_append(gpio_pattern_t *pattern, const uint64_t values, const bool sample)
+{
+    if ((!pattern) || (!pattern->steps))
+    {
+        return -1;
+    }
+
+    if (pattern->num >= pattern->capacity)
+    {
+        if ((pattern->capacity > UINT32_MAX / 2) || (!gpio_pattern_reserve(pattern, pattern->capacity * 2)))
+        {
+            return -1;
+        }
+    }
+
+    pattern->steps[pattern->num] = values & pattern->mask;
+    if (sample)
+    {
+        pattern->sample_flags[pattern->num / 8] |= (uint8_t)(1U << (pattern->num % 8));
+        pattern->num++;
+
+        return pattern->sample_num++;
+    }
+
+    pattern->num++;
+
+    return pattern->sample_num;
+}
+
+/**
+ * @brief  播放波形: 逐步批量设置输出, 在标记的步骤之后采样输入, 采样值按位(LSB优先)保存
+ * @note   输出电平未变化的步骤不产生系统调用; step_ns为0时以最快速度播放,
+ *         否则每一步的时刻都以播放起始时刻为基准忙等待, 不累积误差
+ * @param  samples: 输出参数, 采样结果位图, 至少(sample_num + 7) / 8字节, 不采样时可以为NULL
+ * @param  pattern: 输入参数, 波形
+ * @param  output : 输入参数, 输出GPIO组
+ * @param  input  : 输入参数, 采样的输入GPIO组, 不采样时可以为NULL
+ * @param  index  : 输入参数, 采样的输入GPIO组内序号
+ * @param  step_ns: 输入参数, 每一步的时间, 单位: ns, 0表示不控制时间
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pattern_play(uint8_t *samples, const gpio_pattern_t *pattern, gpio_group_t *output, gpio_group_t *input,
+                       const uint8_t index, const uint64_t step_ns)
+{
+    uint64_t start_ns = 0;
+    uint64_t bit = 1ULL << index;
+    uint64_t value = 0;
+    uint32_t sample = 0;
+
+    if ((!pattern) || (!output))
+    {
+        return false;
+    }
+
+    if ((0 != pattern->sample_num) && ((!samples) || (!input) || (index >= input->num)))
+    {
+        return false;
+    }
+
+    if (samples)
+    {
+        memset(samples, 0, (pattern->sample_num + 7) / 8);
+    }
+
+    start_ns = gpio_pattern_now_ns();
+    for (uint32_t i = 0; i < pattern->num; i++)
+    {
+        if (0 != step_ns)
+        {
+            while (gpio_pattern_now_ns() < start_ns + (uint64_t)i * step_ns)
+            {
+            }
+        }
+
+        if (!gpio_group_set_values(output, pattern->mask, pattern->steps[i]))
+        {
+            return false;
+        }
+
+        if (!(pattern->sample_flags[i / 8] & (1U << (i % 8))))
+        {
+            continue;
+        }
+
+        if (!gpio_group_get_values(&value, input, bit))
+        {
+            return false;
+        }
+
+        if (value & bit)
+        {
+            samples[sample / 8] |= (uint8_t)(1U << (sample % 8));
+        }
+
+        sample++;
+    }
+
+    return true;
+}
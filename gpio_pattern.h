@@ -0,0 +1,99 @@
+/**
+ * @file      : gpio_pattern.h
+ * @brief     : GPIO波形缓冲区与播放头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 18:12:05
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_PATTERN_H
+#define __GPIO_PATTERN_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+
+// 波形缓冲区默认容量(步数)
+#define GPIO_PATTERN_DEFAULT_CAPACITY 4096
+
+// 波形: 预先编译好的输出电平序列, 每一步对输出GPIO组执行一次批量设置, 可选在该步之后采样一个输入GPIO
+typedef struct
+{
+    // 每一步的输出电平值, bit i对应输出GPIO组内第i个GPIO
+    uint64_t *steps;
+    // 采样标志位图, 第n位为1表示第n步输出后采样输入
+    uint8_t *sample_flags;
+    // 容量(步数)
+    uint32_t capacity;
+    // 已编译的步数
+    uint32_t num;
+    // 已编译的采样个数
+    uint32_t sample_num;
+    // 输出GPIO掩码
+    uint64_t mask;
+} gpio_pattern_t;
+
+/**
+ * @brief  初始化波形缓冲区
+ * @param  pattern : 输出参数, 波形
+ * @param  mask    : 输入参数, 输出GPIO掩码, bit i对应输出GPIO组内第i个GPIO
+ * @param  capacity: 输入参数, 初始容量(步数), 0表示使用GPIO_PATTERN_DEFAULT_CAPACITY, 不足时自动扩容
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pattern_init(gpio_pattern_t *pattern, const uint64_t mask, const uint32_t capacity);
+
+/**
+ * @brief  释放波形缓冲区
+ * @param  pattern: 输入参数, 波形
+ */
+void gpio_pattern_deinit(gpio_pattern_t *pattern);
+
+/**
+ * @brief  清空已编译的步骤, 保留缓冲区复用
+ * @param  pattern: 输入参数, 波形
+ */
+void gpio_pattern_clear(gpio_pattern_t *pattern);
+
+/**
+ * @brief  追加一步
+ * @param  pattern: 输入参数, 波形
+ * @param  values : 输入参数, 输出电平值
+ * @param  sample : 输入参数, 本步输出后是否采样输入
+ * @return 成功: 本步采样的序号(不采样时为已有采样个数)
+ *         失败: -1
+ */
+int64_t gpio_pattern_append(gpio_pattern_t *pattern, const uint64_t values, const bool sample);
+
+/**
+ * @brief  播放波形: 逐步批量设置输出, 在标记的步骤之后采样输入, 采样值按位(LSB优先)保存
+ * @note   输出电平未变化的步骤不产生系统调用; step_ns为0时以最快速度播放,
+ *         否则每一步的时刻都以播放起始时刻为基准忙等待, 不累积误差
+ * @param  samples: 输出参数, 采样结果位图, 至少(sample_num + 7) / 8字节, 不采样时可以为NULL
+ * @param  pattern: 输入参数, 波形
+ * @param  output : 输入参数, 输出GPIO组
+ * @param  input  : 输入参数, 采样的输入GPIO组, 不采样时可以为NULL
+ * @param  index  : 输入参数, 采样的输入GPIO组内序号
+ * @param  step_ns: 输入参数, 每一步的时间, 单位: ns, 0表示不控制时间
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pattern_play(uint8_t *samples, const gpio_pattern_t *pattern, gpio_group_t *output, gpio_group_t *input,
+                       const uint8_t index, const uint64_t step_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_PATTERN_H
@@ -0,0 +1,157 @@
+/**
+ * @file      : gpio_pdm.c
+ * @brief     : GPIO脉冲密度调制(一阶sigma-delta)输出源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 16:07:25
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_pdm.h"
+
+/**
+ * @brief  初始化脉冲密度调制输出
+ * @param  pdm: 输出参数, 脉冲密度调制输出
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_init(gpio_pdm_t *pdm)
+{
+    if (!pdm)
+    {
+        return false;
+    }
+
+    memset(pdm, 0, sizeof(gpio_pdm_t));
+
+    return true;
+}
+
+/**
+ * @brief  添加通道
+ * @param  pdm  : 输入参数, 脉冲密度调制输出
+ * @param  index: 输入参数, 输出GPIO组内序号, 不能与已有通道相同
+ * @param  level: 输入参数, 初始电平, 0 ~ GPIO_PDM_FULL_SCALE
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_pdm_add_channel(gpio_pdm_t *pdm, const uint8_t index, const uint32_t level)
+{
+    uint8_t channel = 0;
+
+    if ((!pdm) || (pdm->channel_num >= GPIO_PDM_MAX_CHANNELS) || (index >= GPIO_GROUP_MAX_NUM) ||
+        (level > GPIO_PDM_FULL_SCALE) || (pdm->mask & (1ULL << index)))
+    {
+        return -1;
+    }
+
+    channel = pdm->channel_num;
+    pdm->index[channel] = index;
+    pdm->level[channel] = level;
+    // 从半个满量程开始, 量化误差在±1/2步之内
+    pdm->accumulator[channel] = GPIO_PDM_FULL_SCALE / 2;
+    pdm->mask |= 1ULL << index;
+    pdm->channel_num++;
+
+    return channel;
+}
+
+/**
+ * @brief  设置通道电平, 下一次生成时生效
+ * @param  pdm    : 输入参数, 脉冲密度调制输出
+ * @param  channel: 输入参数, 通道序号
+ * @param  level  : 输入参数, 电平, 0 ~ GPIO_PDM_FULL_SCALE
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_set_level(gpio_pdm_t *pdm, const uint8_t channel, const uint32_t level)
+{
+    if ((!pdm) || (channel >= pdm->channel_num) || (level > GPIO_PDM_FULL_SCALE))
+    {
+        return false;
+    }
+
+    pdm->level[channel] = level;
+
+    return true;
+}
+
+/**
+ * @brief  生成脉冲密度调制位流: 每一步各通道累加电平, 溢出满量程时输出高电平并减去满量程,
+ *         所有通道的输出位合成一行追加到波形
+ * @note   波形掩码必须包含全部通道, 掩码内的其他GPIO输出低电平;
+ *         位流的平均值等于电平, 量化误差被推向高频, 经RC滤波后的分辨率远高于相同翻转频率的PWM
+ * @param  pattern: 输入参数, 波形
+ * @param  pdm    : 输入参数, 脉冲密度调制输出
+ * @param  steps  : 输入参数, 生成的步数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_render(gpio_pattern_t *pattern, gpio_pdm_t *pdm, const uint32_t steps)
+{
+    uint64_t values = 0;
+    uint32_t accumulator = 0;
+
+    if ((!pattern) || (!pdm) || ((pattern->mask & pdm->mask) != pdm->mask))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < steps; i++)
+    {
+        values = 0;
+        for (uint8_t j = 0; j < pdm->channel_num; j++)
+        {
+            // 累加器小于满量程, 加上不大于满量程的电平不会溢出uint32_t
+            accumulator = pdm->accumulator[j] + pdm->level[j];
+            if (accumulator >= GPIO_PDM_FULL_SCALE)
+            {
+                accumulator -= GPIO_PDM_FULL_SCALE;
+                values |= 1ULL << pdm->index[j];
+            }
+
+            pdm->accumulator[j] = accumulator;
+        }
+
+        if (gpio_pattern_append(pattern, values, false) < 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  清空波形后生成steps步位流并以step_ns的步长播放
+ * @note   阻塞到播放完成; 连续输出时循环调用, 累加器保证前后两段之间没有跳变
+ * @param  pattern: 输入参数, 波形(作为生成缓冲区复用)
+ * @param  pdm    : 输入参数, 脉冲密度调制输出
+ * @param  output : 输入参数, 输出GPIO组
+ * @param  steps  : 输入参数, 步数
+ * @param  step_ns: 输入参数, 每一步的时间, 单位: ns, 0表示以最快速度播放
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_play(gpio_pattern_t *pattern, gpio_pdm_t *pdm, gpio_group_t *output, const uint32_t steps,
+                   const uint64_t step_ns)
+{
+    if ((!pattern) || (!pdm) || (!output))
+    {
+        return false;
+    }
+
+    gpio_pattern_clear(pattern);
+    if (!gpio_pdm_render(pattern, pdm, steps))
+    {
+        return false;
+    }
+
+    return gpio_pattern_play(NULL, pattern, output, NULL, 0, step_ns);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file      : gpio_pdm.h
+ * @brief     : GPIO脉冲密度调制(一阶sigma-delta)输出头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 16:07:25
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_PDM_H
+#define __GPIO_PDM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+#include "./gpio_pattern.h"
+
+// 最大通道数
+#define GPIO_PDM_MAX_CHANNELS GPIO_GROUP_MAX_NUM
+
+// 满量程电平(一直为高电平)
+#define GPIO_PDM_FULL_SCALE 65536
+
+// 脉冲密度调制输出: 每一步所有通道的输出位合成一行, 追加到波形中由波形播放批量设置
+typedef struct
+{
+    // 通道对应的输出GPIO组内序号
+    uint8_t index[GPIO_PDM_MAX_CHANNELS];
+    // 通道电平, 0 ~ GPIO_PDM_FULL_SCALE, 高电平的步数占比为level / GPIO_PDM_FULL_SCALE
+    uint32_t level[GPIO_PDM_MAX_CHANNELS];
+    // 通道累加器, 跨多次生成保持, 前后两段波形的脉冲密度连续
+    uint32_t accumulator[GPIO_PDM_MAX_CHANNELS];
+    uint8_t channel_num;
+    // 全部通道的输出GPIO掩码
+    uint64_t mask;
+} gpio_pdm_t;
+
+/**
+ * @brief  初始化脉冲密度调制输出
+ * @param  pdm: 输出参数, 脉冲密度调制输出
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_init(gpio_pdm_t *pdm);
+
+/**
+ * @brief  添加通道
+ * @param  pdm  : 输入参数, 脉冲密度调制输出
+ * @param  index: 输入参数, 输出GPIO组内序号, 不能与已有通道相同
+ * @param  level: 输入参数, 初始电平, 0 ~ GPIO_PDM_FULL_SCALE
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_pdm_add_channel(gpio_pdm_t *pdm, const uint8_t index, const uint32_t level);
+
+/**
+ * @brief  设置通道电平, 下一次生成时生效
+ * @param  pdm    : 输入参数, 脉冲密度调制输出
+ * @param  channel: 输入参数, 通道序号
+ * @param  level  : 输入参数, 电平, 0 ~ GPIO_PDM_FULL_SCALE
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_set_level(gpio_pdm_t *pdm, const uint8_t channel, const uint32_t level);
+
+/**
+ * @brief  生成脉冲密度调制位流: 每一步各通道累加电平, 溢出满量程时输出高电平并减去满量程,
+ *         所有通道的输出位合成一行追加到波形
+ * @note   波形掩码必须包含全部通道, 掩码内的其他GPIO输出低电平;
+ *         位流的平均值等于电平, 量化误差被推向高频, 经RC滤波后的分辨率远高于相同翻转频率的PWM
+ * @param  pattern: 输入参数, 波形
+ * @param  pdm    : 输入参数, 脉冲密度调制输出
+ * @param  steps  : 输入参数, 生成的步数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_render(gpio_pattern_t *pattern, gpio_pdm_t *pdm, const uint32_t steps);
+
+/**
+ * @brief  清空波形后生成steps步位流并以step_ns的步长播放
+ * @note   阻塞到播放完成; 连续输出时循环调用, 累加器保证前后两段之间没有跳变
+ * @param  pattern: 输入参数, 波形(作为生成缓冲区复用)
+ * @param  pdm    : 输入参数, 脉冲密度调制输出
+ * @param  output : 输入参数, 输出GPIO组
+ * @param  steps  : 输入参数, 步数
+ * @param  step_ns: 输入参数, 每一步的时间, 单位: ns, 0表示以最快速度播放
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pdm_play(gpio_pattern_t *pattern, gpio_pdm_t *pdm, gpio_group_t *output, const uint32_t steps,
+                   const uint64_t step_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_PDM_H
@@ -0,0 +1,361 @@
+/**
+ * @file      : gpio_ps2.c
+ * @brief     : PS/2键盘/鼠标协议解码源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 11:02:45
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_ps2.h"
+
+// 一帧的位数: 起始位 + 8位数据 + 奇校验位 + 停止位
+#define GPIO_PS2_FRAME_BITS 11
+
+// 帧中的校验位和停止位(起始位不保存)
+#define GPIO_PS2_FRAME_PARITY 0x100
+#define GPIO_PS2_FRAME_STOP 0x200
+
+// 鼠标数据包第1个字节: 同步位、X/Y符号位、X/Y溢出位
+#define GPIO_PS2_MOUSE_SYNC 0x08
+#define GPIO_PS2_MOUSE_X_SIGN 0x10
+#define GPIO_PS2_MOUSE_Y_SIGN 0x20
+#define GPIO_PS2_MOUSE_OVERFLOW 0xC0
+
+// 键盘扫描码前缀
+#define GPIO_PS2_KEY_EXTENDED 0xE0
+#define GPIO_PS2_KEY_RELEASE 0xF0
+#define GPIO_PS2_KEY_PAUSE_PREFIX 0xE1
+
+// Pause序列(E1 14 77 E1 F0 14 F0 77)在E1之后的字节个数
+#define GPIO_PS2_KEY_PAUSE_BYTES 7
+
+/**
+ * @brief  CLK下降沿: 采样一位, 收满一帧后校验并回调
+ * @param  ps2         : 输入参数, PS/2解码器
+ * @param  bit         : 输入参数, DATA电平
+ * @param  timestamp_ns: 输入参数, 下降沿时间戳, 单位: ns
+ */
+static void gpio_ps2_clock(gpio_ps2_t *ps2, const uint8_t bit, const uint64_t timestamp_ns)
+{
+    uint16_t parity = 0;
+    bool gap = (timestamp_ns - ps2->last_ns > ps2->config.timeout_ns);
+
+    ps2->last_ns = timestamp_ns;
+    if (!ps2->synced)
+    {
+        if (!gap)
+        {
+            return;
+        }
+
+        ps2->synced = true;
+    }
+
+    if ((0 != ps2->bit_count) && (gap))
+    {
+        ps2->stats.timeouts++;
+        ps2->bit_count = 0;
+    }
+
+    if (0 == ps2->bit_count)
+    {
+        if (0 != bit)
+        {
+            ps2->stats.framing_errors++;
+            ps2->synced = false;
+
+            return;
+        }
+
+        ps2->frame = 0;
+        ps2->start_ns = timestamp_ns;
+        ps2->bit_count = 1;
+
+        return;
+    }
+
+    ps2->frame |= (uint16_t)(bit << (ps2->bit_count - 1));
+    if (++ps2->bit_count < GPIO_PS2_FRAME_BITS)
+    {
+        return;
+    }
+
+    ps2->bit_count = 0;
+    if (!(ps2->frame & GPIO_PS2_FRAME_STOP))
+    {
+        ps2->stats.framing_errors++;
+        ps2->synced = false;
+
+        return;
+    }
+
+    // 数据位和校验位中1的个数为奇数
+    for (uint16_t value = ps2->frame & (GPIO_PS2_FRAME_PARITY | 0xFF); 0 != value; value >>= 1)
+    {
+        parity ^= (value & 1);
+    }
+
+    if (0 == parity)
+    {
+        ps2->stats.parity_errors++;
+        ps2->synced = false;
+
+        return;
+    }
+
+    ps2->stats.frames++;
+    if (ps2->config.callback)
+    {
+        ps2->config.callback((uint8_t)ps2->frame, ps2->start_ns, ps2->config.arg);
+    }
+}
+
+/**
+ * @brief  打开PS/2使用的GPIO组: CLK(序号0)检测下降沿, DATA(序号1)检测双边沿, 在同一个请求中并使用较大的内核事件缓冲区
+ * @param  group: 输出参数, GPIO组
+ * @param  chip : 输入参数, GPIO芯片设备路径, 为NULL时使用sysfs后端(DATA在事件回调中读取)
+ * @param  clk  : 输入参数, CLK的GPIO编号(字符设备为芯片内偏移)
+ * @param  data : 输入参数, DATA的GPIO编号(字符设备为芯片内偏移)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_ps2_open_group(gpio_group_t *group, const char *chip, const uint16_t clk, const uint16_t data)
+{
+    static const gpio_edge_e line_edges[2] = {E_GPIO_FALLING, E_GPIO_BOTH};
+    gpio_group_config_t config = {0};
+    uint16_t gpio_nums[2] = {clk, data};
+
+    config.chip = chip;
+    config.consumer = "ps2";
+    config.direction = E_GPIO_IN;
+    config.line_edges = line_edges;
+    config.event_buffer_size = GPIO_PS2_EVENT_BUFFER_SIZE;
+
+    return gpio_group_open(group, gpio_nums, 2, &config);
+}
+
+/**
+ * @brief  初始化PS/2解码器, 读取DATA初始电平
+ * @param  ps2   : 输出参数, PS/2解码器
+ * @param  config: 输入参数, PS/2解码器配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_ps2_init(gpio_ps2_t *ps2, const gpio_ps2_config_t *config)
+{
+    uint64_t data = 0;
+    uint64_t values = 0;
+
+    if ((!ps2) || (!config) || (!config->group) || (config->clk >= config->group->num) ||
+        (config->data >= config->group->num) || (config->clk == config->data))
+    {
+        return false;
+    }
+
+    if (!(config->group->falling_mask & (1ULL << config->clk)))
+    {
+        return false;
+    }
+
+    memset(ps2, 0, sizeof(gpio_ps2_t));
+    ps2->config = *config;
+    if (0 == ps2->config.timeout_ns)
+    {
+        ps2->config.timeout_ns = GPIO_PS2_DEFAULT_TIMEOUT_NS;
+    }
+
+    // 只有uAPI v2的同一请求内事件按内核顺序排列, 其他后端每个GPIO的事件各自排队, 只能在CLK事件回调中读取DATA
+    data = 1ULL << config->data;
+    ps2->track_data = (E_GPIO_BACKEND_CDEV_V2 == config->group->backend) && (config->group->rising_mask & data) &&
+                      (config->group->falling_mask & data);
+    if (!gpio_group_get_values(&values, config->group, data))
+    {
+        return false;
+    }
+
+    ps2->data_level = (values & data) ? 1 : 0;
+
+    return true;
+}
+
+/**
+ * @brief  处理边沿事件: DATA边沿更新电平, CLK下降沿采样一位, 收满11位后校验并回调
+ * @note   可直接作为gpio_loop的回调函数, arg为PS/2解码器; 事件有丢失或被合并时丢弃当前帧
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, PS/2解码器
+ */
+void gpio_ps2_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_ps2_t *ps2 = (gpio_ps2_t *)arg;
+    uint64_t values = 0;
+    uint8_t bit = 0;
+
+    if ((!ps2) || (!event) || (group != ps2->config.group))
+    {
+        return;
+    }
+
+    // 丢失或合并的边沿无法恢复, 丢弃当前帧, 等待帧间隔重新同步
+    if ((0 != event->lost) || (event->count > 1))
+    {
+        ps2->stats.lost += (0 != event->lost) ? event->lost : (event->count - 1);
+        ps2->bit_count = 0;
+        ps2->synced = false;
+    }
+
+    if (event->index == ps2->config.data)
+    {
+        ps2->data_level = (E_GPIO_RISING == event->edge) ? 1 : 0;
+
+        return;
+    }
+
+    if ((event->index != ps2->config.clk) || (E_GPIO_FALLING != event->edge))
+    {
+        return;
+    }
+
+    bit = ps2->data_level;
+    if (!ps2->track_data)
+    {
+        if (!gpio_group_get_values(&values, group, (1ULL << ps2->config.data)))
+        {
+            ps2->bit_count = 0;
+            ps2->synced = false;
+
+            return;
+        }
+
+        bit = (values >> ps2->config.data) & 1;
+    }
+
+    gpio_ps2_clock(ps2, bit, event->timestamp_ns);
+}
+
+/**
+ * @brief  组装鼠标数据包
+ * @param  packet      : 输出参数, 完整的数据包
+ * @param  mouse       : 输入参数, 组装状态
+ * @param  byte        : 输入参数, 接收到的字节
+ * @param  timestamp_ns: 输入参数, 字节时间戳, 单位: ns
+ * @return true : 组装出一个完整的数据包
+ * @return false: 数据包未完整
+ */
+bool gpio_ps2_mouse_feed(gpio_ps2_mouse_packet_t *packet, gpio_ps2_mouse_t *mouse, const uint8_t byte,
+                         const uint64_t timestamp_ns)
+{
+    if ((!packet) || (!mouse))
+    {
+        return false;
+    }
+
+    // 间隔过长说明中间丢了字节, 从新的数据包开始
+    if ((0 != mouse->num) && (timestamp_ns - mouse->last_ns > GPIO_PS2_PACKET_GAP_NS))
+    {
+        mouse->dropped += mouse->num;
+        mouse->num = 0;
+    }
+
+    mouse->last_ns = timestamp_ns;
+    if (0 == mouse->num)
+    {
+        if (!(byte & GPIO_PS2_MOUSE_SYNC))
+        {
+            mouse->dropped++;
+
+            return false;
+        }
+
+        mouse->first_ns = timestamp_ns;
+    }
+
+    mouse->bytes[mouse->num++] = byte;
+    if (mouse->num < 3)
+    {
+        return false;
+    }
+
+    mouse->num = 0;
+    packet->buttons = mouse->bytes[0] & 0x07;
+    packet->dx = (int16_t)(mouse->bytes[1] - ((mouse->bytes[0] & GPIO_PS2_MOUSE_X_SIGN) ? 256 : 0));
+    packet->dy = (int16_t)(mouse->bytes[2] - ((mouse->bytes[0] & GPIO_PS2_MOUSE_Y_SIGN) ? 256 : 0));
+    packet->overflow = mouse->bytes[0] & GPIO_PS2_MOUSE_OVERFLOW;
+    packet->timestamp_ns = mouse->first_ns;
+
+    return true;
+}
+
+/**
+ * @brief  解码键盘扫描码(集2)
+ * @param  code    : 输出参数, 按键码, 扩展键为0xE000 | 扫描码, Pause键为GPIO_PS2_KEY_PAUSE
+ * @param  released: 输出参数, 是否为松开
+ * @param  keyboard: 输入参数, 解码状态
+ * @param  byte    : 输入参数, 接收到的字节
+ * @return true : 解码出一个按键
+ * @return false: 前缀或序列未完整
+ */
+bool gpio_ps2_keyboard_feed(uint16_t *code, bool *released, gpio_ps2_keyboard_t *keyboard, const uint8_t byte)
+{
+    if ((!code) || (!released) || (!keyboard))
+    {
+        return false;
+    }
+
+    // Pause没有松开码, 整个序列作为一次按下
+    if (0 != keyboard->skip)
+    {
+        if (0 != --keyboard->skip)
+        {
+            return false;
+        }
+
+        *code = GPIO_PS2_KEY_PAUSE;
+        *released = false;
+
+        return true;
+    }
+
+    switch (byte)
+    {
+    case GPIO_PS2_KEY_EXTENDED:
+    {
+        keyboard->extended = true;
+
+        return false;
+    }
+
+    case GPIO_PS2_KEY_RELEASE:
+    {
+        keyboard->release = true;
+
+        return false;
+    }
+
+    case GPIO_PS2_KEY_PAUSE_PREFIX:
+    {
+        keyboard->skip = GPIO_PS2_KEY_PAUSE_BYTES;
+
+        return false;
+    }
+
+    default:
+    {
+        break;
+    }
+    }
+
+    *code = keyboard->extended ? (uint16_t)(0xE000 | byte) : byte;
+    *released = keyboard->release;
+    keyboard->extended = false;
+    keyboard->release = false;
+
+    return true;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file      : gpio_ps2.h
+ * @brief     : PS/2键盘/鼠标协议解码头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 11:02:45
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_PS2_H
+#define __GPIO_PS2_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+
+// 默认位超时, 单位: ns, 帧内相邻两个时钟下降沿间隔超过该值时丢弃当前帧重新同步(PS/2时钟周期60~100us)
+#define GPIO_PS2_DEFAULT_TIMEOUT_NS 250000
+
+// gpio_ps2_open_group申请的内核事件缓冲区大小(事件个数), 鼠标连续上报时应用程序短暂延迟也不丢事件
+#define GPIO_PS2_EVENT_BUFFER_SIZE 1024
+
+// 鼠标数据包内相邻字节的最大间隔, 单位: ns, 超过时重新开始一个数据包
+#define GPIO_PS2_PACKET_GAP_NS 5000000
+
+// 键盘Pause键(扫描码集2中E1开头的8字节序列)
+#define GPIO_PS2_KEY_PAUSE 0xE114
+
+/**
+ * @brief  字节接收回调函数
+ * @param  byte        : 输入参数, 接收到的字节(起始位、奇校验和停止位均正确)
+ * @param  timestamp_ns: 输入参数, 起始位的时钟下降沿时间戳, 单位: ns
+ * @param  arg         : 输入参数, 配置中的用户参数
+ */
+typedef void (*gpio_ps2_callback_t)(const uint8_t byte, const uint64_t timestamp_ns, void *arg);
+
+// PS/2解码器配置
+typedef struct
+{
+    // 输入GPIO组: CLK检测下降沿, DATA检测双边沿且与CLK在同一个uAPI v2请求中时由事件跟踪电平(见gpio_ps2_open_group),
+    // 否则在CLK事件回调中读取DATA
+    gpio_group_t *group;
+    // CLK/DATA在GPIO组内的序号
+    uint8_t clk;
+    uint8_t data;
+    // 位超时, 单位: ns, 0表示使用GPIO_PS2_DEFAULT_TIMEOUT_NS
+    uint64_t timeout_ns;
+    // 字节接收回调函数
+    gpio_ps2_callback_t callback;
+    // 用户参数
+    void *arg;
+} gpio_ps2_config_t;
+
+// PS/2解码统计
+typedef struct
+{
+    // 正确接收的帧个数
+    uint64_t frames;
+    // 奇校验错误个数
+    uint64_t parity_errors;
+    // 起始位/停止位错误个数
+    uint64_t framing_errors;
+    // 帧内超时重新同步的次数
+    uint64_t timeouts;
+    // 内核丢失或事件循环合并的事件个数(当前帧被丢弃)
+    uint64_t lost;
+} gpio_ps2_stats_t;
+
+// PS/2解码器
+typedef struct
+{
+    gpio_ps2_config_t config;
+    // DATA电平由同一请求中的边沿事件跟踪(事件按内核顺序到达, 与CLK事件精确对应)
+    bool track_data;
+    // 当前DATA电平
+    uint8_t data_level;
+    // 已与帧边界同步, 丢失事件或帧错误后等到时钟停顿超过位超时(帧间隔)再恢复
+    bool synced;
+    // 当前帧已接收的位数, 0表示等待起始位
+    uint8_t bit_count;
+    // 当前帧的数据位、校验位和停止位
+    uint16_t frame;
+    // 当前帧起始位时间戳和上一个时钟下降沿时间戳, 单位: ns
+    uint64_t start_ns;
+    uint64_t last_ns;
+    gpio_ps2_stats_t stats;
+} gpio_ps2_t;
+
+// 鼠标数据包(标准3字节)
+typedef struct
+{
+    // 按键: bit0左键, bit1右键, bit2中键
+    uint8_t buttons;
+    // X/Y位移(向右/向上为正)
+    int16_t dx;
+    int16_t dy;
+    // X或Y位移溢出
+    bool overflow;
+    // 第1个字节的时间戳, 单位: ns
+    uint64_t timestamp_ns;
+} gpio_ps2_mouse_packet_t;
+
+// 鼠标数据包组装状态
+typedef struct
+{
+    uint8_t bytes[3];
+    uint8_t num;
+    uint64_t first_ns;
+    uint64_t last_ns;
+    // 因第1个字节同步位错误或字节间隔超时而丢弃的字节个数
+    uint64_t dropped;
+} gpio_ps2_mouse_t;
+
+// 键盘扫描码(集2)解码状态
+typedef struct
+{
+    // 已收到E0前缀
+    bool extended;
+    // 已收到F0前缀
+    bool release;
+    // Pause序列中剩余待跳过的字节个数
+    uint8_t skip;
+} gpio_ps2_keyboard_t;
+
+/**
+ * @brief  打开PS/2使用的GPIO组: CLK(序号0)检测下降沿, DATA(序号1)检测双边沿, 在同一个请求中并使用较大的内核事件缓冲区
+ * @param  group: 输出参数, GPIO组
+ * @param  chip : 输入参数, GPIO芯片设备路径, 为NULL时使用sysfs后端(DATA在事件回调中读取)
+ * @param  clk  : 输入参数, CLK的GPIO编号(字符设备为芯片内偏移)
+ * @param  data : 输入参数, DATA的GPIO编号(字符设备为芯片内偏移)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_ps2_open_group(gpio_group_t *group, const char *chip, const uint16_t clk, const uint16_t data);
+
+/**
+ * @brief  初始化PS/2解码器, 读取DATA初始电平
+ * @param  ps2   : 输出参数, PS/2解码器
+ * @param  config: 输入参数, PS/2解码器配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_ps2_init(gpio_ps2_t *ps2, const gpio_ps2_config_t *config);
+
+/**
+ * @brief  处理边沿事件: DATA边沿更新电平, CLK下降沿采样一位, 收满11位后校验并回调
+ * @note   可直接作为gpio_loop的回调函数, arg为PS/2解码器; 事件有丢失或被合并时丢弃当前帧
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, PS/2解码器
+ */
+void gpio_ps2_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+/**
+ * @brief  组装鼠标数据包
+ * @param  packet      : 输出参数, 完整的数据包
+ * @param  mouse       : 输入参数, 组装状态
+ * @param  byte        : 输入参数, 接收到的字节
+ * @param  timestamp_ns: 输入参数, 字节时间戳, 单位: ns
+ * @return true : 组装出一个完整的数据包
+ * @return false: 数据包未完整
+ */
+bool gpio_ps2_mouse_feed(gpio_ps2_mouse_packet_t *packet, gpio_ps2_mouse_t *mouse, const uint8_t byte,
+                         const uint64_t timestamp_ns);
+
+/**
+ * @brief  解码键盘扫描码(集2)
+ * @param  code    : 输出参数, 按键码, 扩展键为0xE000 | 扫描码, Pause键为GPIO_PS2_KEY_PAUSE
+ * @param  released: 输出参数, 是否为松开
+ * @param  keyboard: 输入参数, 解码状态
+ * @param  byte    : 输入参数, 接收到的字节
+ * @return true : 解码出一个按键
+ * @return false: 前缀或序列未完整
+ */
+bool gpio_ps2_keyboard_feed(uint16_t *code, bool *released, gpio_ps2_keyboard_t *keyboard, const uint8_t byte);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_PS2_H
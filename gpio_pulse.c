@@ -0,0 +1,404 @@
+/**
+ * @file      : gpio_pulse.c
+ * @brief     : GPIO精确脉冲输出源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 17:26:35
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-19 huenrong        结束边沿作为屏障动作, 拒绝不大于合并窗口的脉冲宽度
+ *              2026-10-19 huenrong        定时引擎已满导致结束边沿无法安排时恢复电平并中止脉冲序列
+ *
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "./gpio_pulse.h"
+
+static void gpio_pulse_started(gpio_timer_t *timer, const gpio_timer_action_t *action, const int64_t error_ns,
+                               void *arg);
+static void gpio_pulse_ended(gpio_timer_t *timer, const gpio_timer_action_t *action, const int64_t error_ns,
+                             void *arg);
+
+/**
+ * @brief  安排一个脉冲的两个边沿(调用前需持有脉冲输出的锁)
+ * @note   两个边沿同时放入定时引擎, 短脉冲的结束边沿在起始边沿之后直接进入忙等待
+ * @param  pulse   : 输入参数, 脉冲输出
+ * @param  start_ns: 输入参数, 起始边沿截止时刻, 单位: ns
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_pulse_schedule(gpio_pulse_t *pulse, const uint64_t start_ns)
+{
+    gpio_timer_action_t action = {0};
+    uint64_t bit = 1ULL << pulse->index;
+
+    action.deadline_ns = start_ns;
+    action.group = pulse->group;
+    action.mask = bit;
+    action.values = (E_GPIO_HIGH == pulse->level) ? bit : 0;
+    action.callback = gpio_pulse_started;
+    action.arg = pulse;
+    pulse->start_id = gpio_timer_schedule(pulse->timer, &action);
+    if (0 == pulse->start_id)
+    {
+        return false;
+    }
+
+    // 结束边沿与起始边沿是同一GPIO, 作为屏障动作不与起始边沿合并成一次输出
+    action.deadline_ns = start_ns + pulse->width_ns;
+    action.values ^= bit;
+    action.barrier = true;
+    action.callback = gpio_pulse_ended;
+    pulse->end_id = gpio_timer_schedule(pulse->timer, &action);
+    if (0 == pulse->end_id)
+    {
+        gpio_timer_cancel(pulse->timer, pulse->start_id);
+        pulse->start_id = 0;
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  脉冲起始边沿输出完成, 记录实际输出时刻, 滞后时推迟结束边沿
+ * @param  timer   : 输入参数, 定时引擎
+ * @param  action  : 输入参数, 已执行的定时动作
+ * @param  error_ns: 输入参数, 实际输出时刻与截止时刻的偏差, 单位: ns
+ * @param  arg     : 输入参数, 脉冲输出
+ */
+static void gpio_pulse_started(gpio_timer_t *timer, const gpio_timer_action_t *action, const int64_t error_ns,
+                               void *arg)
+{
+    gpio_pulse_t *pulse = (gpio_pulse_t *)arg;
+    gpio_timer_action_t end = *action;
+
+    (void)timer;
+
+    pthread_mutex_lock(&pulse->mutex);
+    if (action->id == pulse->start_id)
+    {
+        pulse->edge_ns = action->deadline_ns + (uint64_t)error_ns;
+        pulse->start_id = 0;
+
+        // 起始边沿滞后时结束边沿以实际输出时刻为基准重新安排, 保证脉冲宽度
+        if ((error_ns > 0) && (0 != pulse->end_id) && (gpio_timer_cancel(pulse->timer, pulse->end_id)))
+        {
+            end.deadline_ns = pulse->edge_ns + pulse->width_ns;
+            end.values ^= end.mask;
+            end.barrier = true;
+            end.callback = gpio_pulse_ended;
+            pulse->end_id = gpio_timer_schedule(pulse->timer, &end);
+
+            // 定时引擎已满时在定时线程中立即恢复电平, 中止脉冲序列
+            if (0 == pulse->end_id)
+            {
+                gpio_group_set_values(pulse->group, end.mask, end.values);
+                pulse->failed = true;
+                pulse->busy = false;
+                pthread_cond_broadcast(&pulse->cond);
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&pulse->mutex);
+}
+
+/**
+ * @brief  脉冲结束边沿输出完成, 计算实际宽度并安排下一个脉冲
+ * @param  timer   : 输入参数, 定时引擎
+ * @param  action  : 输入参数, 已执行的定时动作
+ * @param  error_ns: 输入参数, 实际输出时刻与截止时刻的偏差, 单位: ns
+ * @param  arg     : 输入参数, 脉冲输出
+ */
+static void gpio_pulse_ended(gpio_timer_t *timer, const gpio_timer_action_t *action, const int64_t error_ns,
+                             void *arg)
+{
+    gpio_pulse_t *pulse = (gpio_pulse_t *)arg;
+    uint32_t number = 0;
+    int64_t width_ns = 0;
+    bool finished = false;
+
+    (void)timer;
+
+    pthread_mutex_lock(&pulse->mutex);
+    if (action->id != pulse->end_id)
+    {
+        pthread_mutex_unlock(&pulse->mutex);
+
+        return;
+    }
+
+    // 实际宽度为两个边沿输出完成时刻之差
+    width_ns = (int64_t)(action->deadline_ns + (uint64_t)error_ns - pulse->edge_ns);
+    pulse->end_id = 0;
+    pulse->last_width_ns = width_ns;
+    if (width_ns < pulse->min_width_ns)
+    {
+        pulse->min_width_ns = width_ns;
+    }
+
+    if (width_ns > pulse->max_width_ns)
+    {
+        pulse->max_width_ns = width_ns;
+    }
+
+    number = pulse->done++;
+    finished = (pulse->done >= pulse->count);
+    if ((!finished) && (!gpio_pulse_schedule(pulse, pulse->first_ns + (uint64_t)pulse->done * pulse->period_ns)))
+    {
+        pulse->failed = true;
+        finished = true;
+    }
+
+    pthread_mutex_unlock(&pulse->mutex);
+
+    if (pulse->callback)
+    {
+        pulse->callback(pulse, number, width_ns, pulse->arg);
+    }
+
+    // 最后一个回调完成后才唤醒等待者
+    if (finished)
+    {
+        pthread_mutex_lock(&pulse->mutex);
+        pulse->busy = false;
+        pthread_cond_broadcast(&pulse->cond);
+        pthread_mutex_unlock(&pulse->mutex);
+    }
+}
+
+/**
+ * @brief  初始化脉冲输出
+ * @param  pulse   : 输出参数, 脉冲输出
+ * @param  timer   : 输入参数, 已启动的定时引擎
+ * @param  group   : 输入参数, 输出GPIO组
+ * @param  index   : 输入参数, 输出GPIO组内序号
+ * @param  callback: 输入参数, 单个脉冲完成回调函数, 可以为NULL
+ * @param  arg     : 输入参数, 传给回调函数的用户参数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pulse_init(gpio_pulse_t *pulse, gpio_timer_t *timer, gpio_group_t *group, const uint8_t index,
+                     const gpio_pulse_callback_t callback, void *arg)
+{
+    pthread_condattr_t cond_attr;
+
+    if ((!pulse) || (!timer) || (!group) || (index >= group->num))
+    {
+        return false;
+    }
+
+    memset(pulse, 0, sizeof(gpio_pulse_t));
+    pulse->timer = timer;
+    pulse->group = group;
+    pulse->index = index;
+    pulse->callback = callback;
+    pulse->arg = arg;
+
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    if (0 != pthread_cond_init(&pulse->cond, &cond_attr))
+    {
+        pthread_condattr_destroy(&cond_attr);
+
+        return false;
+    }
+
+    pthread_condattr_destroy(&cond_attr);
+    if (0 != pthread_mutex_init(&pulse->mutex, NULL))
+    {
+        pthread_cond_destroy(&pulse->cond);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  销毁脉冲输出(正在输出时先取消)
+ * @param  pulse: 输入参数, 脉冲输出
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pulse_deinit(gpio_pulse_t *pulse)
+{
+    if (!pulse)
+    {
+        return false;
+    }
+
+    gpio_pulse_cancel(pulse);
+    pthread_mutex_destroy(&pulse->mutex);
+    pthread_cond_destroy(&pulse->cond);
+
+    return true;
+}
+
+/**
+ * @brief  异步输出一个脉冲: 输出level, 经过width_ns后恢复
+ * @param  pulse   : 输入参数, 脉冲输出
+ * @param  level   : 输入参数, 脉冲电平
+ * @param  width_ns: 输入参数, 脉冲宽度, 单位: ns, 需大于定时引擎的合并窗口
+ * @return true : 成功
+ * @return false: 失败(参数错误或上一次脉冲未完成)
+ */
+bool gpio_pulse(gpio_pulse_t *pulse, const gpio_value_e level, const uint64_t width_ns)
+{
+    return gpio_pulse_train(pulse, level, 1, width_ns + 1, width_ns);
+}
+
+/**
+ * @brief  异步输出脉冲序列, 每个脉冲的起始时刻都以第一个脉冲为基准, 不累积误差
+ * @param  pulse    : 输入参数, 脉冲输出
+ * @param  level    : 输入参数, 脉冲电平
+ * @param  count    : 输入参数, 脉冲个数
+ * @param  period_ns: 输入参数, 脉冲周期, 单位: ns, 需大于脉冲宽度
+ * @param  width_ns : 输入参数, 脉冲宽度, 单位: ns, 需大于定时引擎的合并窗口
+ * @return true : 成功
+ * @return false: 失败(参数错误或上一次脉冲未完成)
+ */
+bool gpio_pulse_train(gpio_pulse_t *pulse, const gpio_value_e level, const uint32_t count,
+                      const uint64_t period_ns, const uint64_t width_ns)
+{
+    bool ret = false;
+
+    if ((!pulse) || (0 == count) || (0 == width_ns) || (period_ns <= width_ns))
+    {
+        return false;
+    }
+
+    // 不大于合并窗口的宽度低于定时引擎的调度粒度, 无法保证
+    if (width_ns <= pulse->timer->merge_ns)
+    {
+        errno = EINVAL;
+
+        return false;
+    }
+
+    pthread_mutex_lock(&pulse->mutex);
+    if (pulse->busy)
+    {
+        pthread_mutex_unlock(&pulse->mutex);
+
+        return false;
+    }
+
+    pulse->level = level;
+    pulse->width_ns = width_ns;
+    pulse->period_ns = period_ns;
+    pulse->count = count;
+    pulse->done = 0;
+    pulse->failed = false;
+    pulse->last_width_ns = 0;
+    pulse->min_width_ns = INT64_MAX;
+    pulse->max_width_ns = INT64_MIN;
+
+    // 起始边沿留出一个忙等待窗口, 两个边沿都在忙等待后输出
+    pulse->first_ns = gpio_timer_now_ns() + pulse->timer->spin_ns;
+    ret = gpio_pulse_schedule(pulse, pulse->first_ns);
+    pulse->busy = ret;
+    pthread_mutex_unlock(&pulse->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief  等待脉冲输出完成
+ * @param  pulse     : 输入参数, 脉冲输出
+ * @param  timeout_ms: 输入参数, 超时时间, 单位: ms, 小于0表示一直等待
+ * @return true : 已完成
+ * @return false: 超时或失败(脉冲序列因定时引擎已满而中止时errno为EIO)
+ */
+bool gpio_pulse_wait(gpio_pulse_t *pulse, const int timeout_ms)
+{
+    uint64_t deadline_ns = 0;
+    struct timespec ts = {0};
+    bool ret = false;
+
+    if (!pulse)
+    {
+        return false;
+    }
+
+    deadline_ns = gpio_timer_now_ns() + ((timeout_ms > 0) ? (uint64_t)timeout_ms * 1000000ULL : 0);
+    ts.tv_sec = (time_t)(deadline_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline_ns % 1000000000ULL);
+
+    pthread_mutex_lock(&pulse->mutex);
+    while (pulse->busy)
+    {
+        if (timeout_ms < 0)
+        {
+            pthread_cond_wait(&pulse->cond, &pulse->mutex);
+        }
+        else if (0 != pthread_cond_timedwait(&pulse->cond, &pulse->mutex, &ts))
+        {
+            break;
+        }
+    }
+
+    ret = ((!pulse->busy) && (!pulse->failed));
+    if ((!pulse->busy) && (pulse->failed))
+    {
+        errno = EIO;
+    }
+
+    pthread_mutex_unlock(&pulse->mutex);
+
+    return ret;
+}
+
+/**
+ * @brief  取消未完成的脉冲, 已输出的起始边沿立即恢复
+ * @param  pulse: 输入参数, 脉冲输出
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pulse_cancel(gpio_pulse_t *pulse)
+{
+    gpio_timer_action_t action = {0};
+
+    if (!pulse)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&pulse->mutex);
+    if (!pulse->busy)
+    {
+        pthread_mutex_unlock(&pulse->mutex);
+
+        return true;
+    }
+
+    if (0 != pulse->start_id)
+    {
+        gpio_timer_cancel(pulse->timer, pulse->start_id);
+        pulse->start_id = 0;
+    }
+
+    // 结束边沿已在定时引擎中时提前到当前时刻输出, 保证电平恢复
+    if ((0 != pulse->end_id) && (gpio_timer_cancel(pulse->timer, pulse->end_id)))
+    {
+        action.deadline_ns = gpio_timer_now_ns();
+        action.group = pulse->group;
+        action.mask = 1ULL << pulse->index;
+        action.values = (E_GPIO_HIGH == pulse->level) ? 0 : action.mask;
+        gpio_timer_schedule(pulse->timer, &action);
+    }
+
+    pulse->end_id = 0;
+    pulse->busy = false;
+    pthread_cond_broadcast(&pulse->cond);
+    pthread_mutex_unlock(&pulse->mutex);
+
+    return true;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file      : gpio_pulse.h
+ * @brief     : GPIO精确脉冲输出头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 17:26:35
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-19 huenrong        结束边沿作为屏障动作, 拒绝不大于合并窗口的脉冲宽度
+ *              2026-10-19 huenrong        定时引擎已满导致结束边沿无法安排时恢复电平并中止脉冲序列
+ *
+ */
+
+#ifndef __GPIO_PULSE_H
+#define __GPIO_PULSE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "./gpio_group.h"
+#include "./gpio_timer.h"
+
+typedef struct gpio_pulse gpio_pulse_t;
+
+/**
+ * @brief  单个脉冲输出完成回调函数, 在定时线程中调用
+ * @param  pulse   : 输入参数, 脉冲输出
+ * @param  number  : 输入参数, 脉冲序号, 从0开始
+ * @param  width_ns: 输入参数, 实际脉冲宽度(两次输出完成时刻之差), 单位: ns
+ * @param  arg     : 输入参数, 初始化时传入的用户参数
+ */
+typedef void (*gpio_pulse_callback_t)(gpio_pulse_t *pulse, const uint32_t number, const int64_t width_ns,
+                                      void *arg);
+
+// 脉冲输出, 绑定一个GPIO, 脉冲的两个边沿都由定时引擎在截止时刻前忙等待后输出
+struct gpio_pulse
+{
+    // 执行输出的定时引擎
+    gpio_timer_t *timer;
+    // 输出GPIO组(只由定时线程写入)
+    gpio_group_t *group;
+    // 输出GPIO组内序号
+    uint8_t index;
+    // 脉冲完成回调函数, 可以为NULL
+    gpio_pulse_callback_t callback;
+    void *arg;
+    // 保护以下状态, 与定时回调互斥
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    // 正在输出脉冲
+    bool busy;
+    // 脉冲序列因定时引擎已满而中止(电平已恢复), 下一次输出时清除
+    bool failed;
+    // 脉冲电平
+    gpio_value_e level;
+    // 脉冲宽度, 单位: ns
+    uint64_t width_ns;
+    // 脉冲周期, 单位: ns
+    uint64_t period_ns;
+    // 脉冲个数
+    uint32_t count;
+    // 已完成的脉冲个数
+    uint32_t done;
+    // 第一个脉冲的起始截止时刻, 单位: ns
+    uint64_t first_ns;
+    // 当前脉冲起始边沿实际输出完成时刻, 单位: ns
+    uint64_t edge_ns;
+    // 当前脉冲两个边沿的定时动作标识
+    uint32_t start_id;
+    uint32_t end_id;
+    // 最近一个/最小/最大实际脉冲宽度, 单位: ns
+    int64_t last_width_ns;
+    int64_t min_width_ns;
+    int64_t max_width_ns;
+};
+
+/**
+ * @brief  初始化脉冲输出
+ * @param  pulse   : 输出参数, 脉冲输出
+ * @param  timer   : 输入参数, 已启动的定时引擎
+ * @param  group   : 输入参数, 输出GPIO组
+ * @param  index   : 输入参数, 输出GPIO组内序号
+ * @param  callback: 输入参数, 单个脉冲完成回调函数, 可以为NULL
+ * @param  arg     : 输入参数, 传给回调函数的用户参数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pulse_init(gpio_pulse_t *pulse, gpio_timer_t *timer, gpio_group_t *group, const uint8_t index,
+                     const gpio_pulse_callback_t callback, void *arg);
+
+/**
+ * @brief  销毁脉冲输出(正在输出时先取消)
+ * @param  pulse: 输入参数, 脉冲输出
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pulse_deinit(gpio_pulse_t *pulse);
+
+/**
+ * @brief  异步输出一个脉冲: 输出level, 经过width_ns后恢复
+ * @param  pulse   : 输入参数, 脉冲输出
+ * @param  level   : 输入参数, 脉冲电平
+ * @param  width_ns: 输入参数, 脉冲宽度, 单位: ns, 需大于定时引擎的合并窗口
+ * @return true : 成功
+ * @return false: 失败(参数错误或上一次脉冲未完成)
+ */
+bool gpio_pulse(gpio_pulse_t *pulse, const gpio_value_e level, const uint64_t width_ns);
+
+/**
+ * @brief  异步输出脉冲序列, 每个脉冲的起始时刻都以第一个脉冲为基准, 不累积误差
+ * @param  pulse    : 输入参数, 脉冲输出
+ * @param  level    : 输入参数, 脉冲电平
+ * @param  count    : 输入参数, 脉冲个数
+ * @param  period_ns: 输入参数, 脉冲周期, 单位: ns, 需大于脉冲宽度
+ * @param  width_ns : 输入参数, 脉冲宽度, 单位: ns, 需大于定时引擎的合并窗口
+ * @return true : 成功
+ * @return false: 失败(参数错误或上一次脉冲未完成)
+ */
+bool gpio_pulse_train(gpio_pulse_t *pulse, const gpio_value_e level, const uint32_t count,
+                      const uint64_t period_ns, const uint64_t width_ns);
+
+/**
+ * @brief  等待脉冲输出完成
+ * @param  pulse     : 输入参数, 脉冲输出
+ * @param  timeout_ms: 输入参数, 超时时间, 单位: ms, 小于0表示一直等待
+ * @return true : 已完成
+ * @return false: 超时或失败(脉冲序列因定时引擎已满而中止时errno为EIO)
+ */
+bool gpio_pulse_wait(gpio_pulse_t *pulse, const int timeout_ms);
+
+/**
+ * @brief  取消未完成的脉冲, 已输出的起始边沿立即恢复
+ * @param  pulse: 输入参数, 脉冲输出
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_pulse_cancel(gpio_pulse_t *pulse);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_PULSE_H
@@ -0,0 +1,307 @@
+/**
+ * @file      : gpio_rctime.c
+ * @brief     : RC充电计时模拟量测量源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 16:44:18
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        初始化时检查GPIO组为uAPI v2后端
+ *              2026-10-19 huenrong        切换输入后立即读取电平, 已越过阈值的通道直接判为过快
+ *
+ */
+
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+#include "./gpio_rctime.h"
+#include "./gpio_timer.h"
+
+/**
+ * @brief  初始化RC充电计时
+ * @param  rctime: 输出参数, RC充电计时
+ * @param  config: 输入参数, 配置
+ * @return true : 成功
+ * @return false: 失败(GPIO组不是uAPI v2后端时errno为ENOTSUP)
+ */
+bool gpio_rctime_init(gpio_rctime_t *rctime, const gpio_rctime_config_t *config)
+{
+    if ((!rctime) || (!config) || (!config->group))
+    {
+        return false;
+    }
+
+    // 只有uAPI v2后端可以把检测边沿的GPIO临时切换为输出放电
+    if (E_GPIO_BACKEND_CDEV_V2 != config->group->backend)
+    {
+        errno = ENOTSUP;
+
+        return false;
+    }
+
+    memset(rctime, 0, sizeof(gpio_rctime_t));
+    rctime->config = *config;
+    if (0 == rctime->config.discharge_ns)
+    {
+        rctime->config.discharge_ns = GPIO_RCTIME_DEFAULT_DISCHARGE_NS;
+    }
+
+    if (0 == rctime->config.timeout_ns)
+    {
+        rctime->config.timeout_ns = GPIO_RCTIME_DEFAULT_TIMEOUT_NS;
+    }
+
+    if (0 == rctime->config.samples)
+    {
+        rctime->config.samples = 1;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  添加通道
+ * @param  rctime: 输入参数, RC充电计时
+ * @param  index : 输入参数, 组内序号, 必须检测上升沿
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_rctime_add_channel(gpio_rctime_t *rctime, const uint8_t index)
+{
+    uint8_t channel = 0;
+
+    if ((!rctime) || (rctime->channel_num >= GPIO_RCTIME_MAX_CHANNELS) || (index >= rctime->config.group->num) ||
+        (!(rctime->config.group->rising_mask & (1ULL << index))) || (rctime->mask & (1ULL << index)))
+    {
+        return -1;
+    }
+
+    channel = rctime->channel_num;
+    rctime->index[channel] = index;
+    rctime->calibrated[channel] = false;
+    rctime->mask |= 1ULL << index;
+    rctime->channel_num++;
+
+    return channel;
+}
+
+/**
+ * @brief  设置通道校准
+ * @param  rctime     : 输入参数, RC充电计时
+ * @param  channel    : 输入参数, 通道序号
+ * @param  calibration: 输入参数, 两点校准, raw0_ns与raw1_ns不能相同
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_rctime_set_calibration(gpio_rctime_t *rctime, const uint8_t channel,
+                                 const gpio_rctime_calibration_t *calibration)
+{
+    if ((!rctime) || (channel >= rctime->channel_num) || (!calibration) ||
+        (calibration->raw0_ns == calibration->raw1_ns))
+    {
+        return false;
+    }
+
+    rctime->calibration[channel] = *calibration;
+    rctime->calibrated[channel] = true;
+
+    return true;
+}
+
+/**
+ * @brief  充放电一次
+ * @param  raw_ns: 输出参数, 各GPIO的充电时间(按组内序号), 单位: ns
+ * @param  fast  : 输出参数, 切换为输入时已越过阈值的GPIO掩码
+ * @param  done  : 输出参数, 测得充电时间的GPIO掩码(包括fast)
+ * @param  rctime: 输入参数, RC充电计时
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_rctime_sample(uint64_t *raw_ns, uint64_t *fast, uint64_t *done, gpio_rctime_t *rctime)
+{
+    gpio_group_t *group = rctime->config.group;
+    uint64_t pending = rctime->mask;
+    uint64_t release_ns = 0;
+    uint64_t deadline_ns = 0;
+    uint64_t now_ns = 0;
+    uint64_t values = 0;
+    uint64_t bit = 0;
+    gpio_event_t event = {0};
+    struct timespec ts = {0};
+
+    *fast = 0;
+    *done = 0;
+
+    // 一次配置全部输出低电平放电, 此时这些GPIO暂停边沿检测
+    if (!gpio_group_set_direction(group, rctime->mask, E_GPIO_OUT, 0))
+    {
+        return false;
+    }
+
+    ts.tv_sec = (time_t)(rctime->config.discharge_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(rctime->config.discharge_ns % 1000000000ULL);
+    while ((-1 == nanosleep(&ts, &ts)) && (EINTR == errno))
+    {
+    }
+
+    // 丢弃上一次测量遗留的事件
+    while (gpio_group_wait_any(&event, group, rctime->mask, E_GPIO_BOTH, 0))
+    {
+    }
+
+    // 一次配置全部切换为输入并恢复边沿检测, 开始充电
+    if (!gpio_group_set_direction(group, rctime->mask, E_GPIO_IN, 0))
+    {
+        return false;
+    }
+
+    release_ns = gpio_timer_now_ns();
+
+    // 切换输入后立即读取一次电平, 已为高电平说明在边沿检测生效前已越过阈值, 直接判为过快
+    if (!gpio_group_get_values(&values, group, pending))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        bit = 1ULL << i;
+        if (values & pending & bit)
+        {
+            raw_ns[i] = 0;
+            pending &= ~bit;
+            *fast |= bit;
+            *done |= bit;
+        }
+    }
+
+    deadline_ns = release_ns + rctime->config.timeout_ns;
+    while (0 != pending)
+    {
+        now_ns = gpio_timer_now_ns();
+        if (now_ns >= deadline_ns)
+        {
+            break;
+        }
+
+        if (!gpio_group_wait_any(&event, group, pending, E_GPIO_RISING, (int64_t)(deadline_ns - now_ns)))
+        {
+            if (ETIMEDOUT == errno)
+            {
+                break;
+            }
+
+            return false;
+        }
+
+        // 每个GPIO只取第一个上升沿, 越过阈值时的抖动被忽略; 边沿可能早于ioctl返回
+        bit = 1ULL << event.index;
+        raw_ns[event.index] = (event.timestamp_ns > release_ns) ? (event.timestamp_ns - release_ns) : 0;
+        pending &= ~bit;
+        *done |= bit;
+    }
+
+    if (0 == pending)
+    {
+        return true;
+    }
+
+    // 超时仍为高电平说明边沿在读取电平与边沿检测生效之间越过阈值
+    if (!gpio_group_get_values(&values, group, pending))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < group->num; i++)
+    {
+        bit = 1ULL << i;
+        if (values & bit)
+        {
+            raw_ns[i] = 0;
+            *fast |= bit;
+            *done |= bit;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  并行测量全部通道: 一次配置全部切换为输出低电平放电, 再一次配置全部切换为输入,
+ *         由各通道第一个上升沿的内核时间戳得到充电时间
+ * @note   阻塞到全部通道越过阈值或超时; 时间起点为切换输入的ioctl返回时刻, 固定偏差由校准消除
+ * @param  results: 输出参数, 各通道的测量结果, 至少channel_num个元素
+ * @param  rctime : 输入参数, RC充电计时
+ * @return true : 成功(各通道的状态见结果)
+ * @return false: 失败
+ */
+bool gpio_rctime_measure(gpio_rctime_result_t *results, gpio_rctime_t *rctime)
+{
+    uint64_t raw_ns[GPIO_GROUP_MAX_NUM] = {0};
+    uint64_t sum_ns[GPIO_RCTIME_MAX_CHANNELS] = {0};
+    uint8_t ok_num[GPIO_RCTIME_MAX_CHANNELS] = {0};
+    uint8_t fast_num[GPIO_RCTIME_MAX_CHANNELS] = {0};
+    uint64_t fast = 0;
+    uint64_t done = 0;
+    uint64_t bit = 0;
+    const gpio_rctime_calibration_t *calibration = NULL;
+
+    if ((!results) || (!rctime) || (0 == rctime->channel_num))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < rctime->config.samples; i++)
+    {
+        if (!gpio_rctime_sample(raw_ns, &fast, &done, rctime))
+        {
+            return false;
+        }
+
+        for (uint8_t j = 0; j < rctime->channel_num; j++)
+        {
+            bit = 1ULL << rctime->index[j];
+            if (fast & bit)
+            {
+                fast_num[j]++;
+            }
+            else if (done & bit)
+            {
+                sum_ns[j] += raw_ns[rctime->index[j]];
+                ok_num[j]++;
+            }
+        }
+    }
+
+    // 有一次测得充电时间即取平均值, 否则按过快或超时
+    for (uint8_t i = 0; i < rctime->channel_num; i++)
+    {
+        if (0 != ok_num[i])
+        {
+            results[i].status = E_GPIO_RCTIME_OK;
+            results[i].raw_ns = sum_ns[i] / ok_num[i];
+        }
+        else
+        {
+            results[i].status = (0 != fast_num[i]) ? E_GPIO_RCTIME_FAST : E_GPIO_RCTIME_TIMEOUT;
+            results[i].raw_ns = (0 != fast_num[i]) ? 0 : rctime->config.timeout_ns;
+        }
+
+        if (!rctime->calibrated[i])
+        {
+            results[i].value = (double)results[i].raw_ns;
+
+            continue;
+        }
+
+        calibration = &rctime->calibration[i];
+        results[i].value = calibration->value0 + ((double)results[i].raw_ns - (double)calibration->raw0_ns) *
+                                                     (calibration->value1 - calibration->value0) /
+                                                     ((double)calibration->raw1_ns - (double)calibration->raw0_ns);
+    }
+
+    return true;
+}
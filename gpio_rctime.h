@@ -0,0 +1,138 @@
+/**
+ * @file      : gpio_rctime.h
+ * @brief     : RC充电计时模拟量测量头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 16:44:18
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        初始化时检查GPIO组为uAPI v2后端
+ *
+ */
+
+#ifndef __GPIO_RCTIME_H
+#define __GPIO_RCTIME_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+
+// 最大通道数
+#define GPIO_RCTIME_MAX_CHANNELS GPIO_GROUP_MAX_NUM
+
+// 默认放电时间, 单位: ns
+#define GPIO_RCTIME_DEFAULT_DISCHARGE_NS 1000000ULL
+
+// 默认充电超时时间, 单位: ns
+#define GPIO_RCTIME_DEFAULT_TIMEOUT_NS 100000000ULL
+
+// 测量结果状态
+typedef enum
+{
+    // 测得充电时间
+    E_GPIO_RCTIME_OK = 0,
+    // 超时仍未越过输入阈值(开路或电阻过大)
+    E_GPIO_RCTIME_TIMEOUT = 1,
+    // 切换为输入时已越过阈值(短路或电容过小), 充电时间记为0
+    E_GPIO_RCTIME_FAST = 2,
+} gpio_rctime_status_e;
+
+// RC充电计时配置
+typedef struct
+{
+    // GPIO组, 传感器GPIO以输入方向打开并检测上升沿(电容接地, 经电阻充电到电源);
+    // 放电和充电只切换方向, 需要uAPI v2后端; 测量期间独占该组的事件, 不能同时注册到事件循环
+    gpio_group_t *group;
+    // 输出低电平放电的时间, 单位: ns, 0表示使用GPIO_RCTIME_DEFAULT_DISCHARGE_NS
+    uint64_t discharge_ns;
+    // 充电超时时间, 单位: ns, 0表示使用GPIO_RCTIME_DEFAULT_TIMEOUT_NS
+    uint64_t timeout_ns;
+    // 每次测量的充放电次数, 结果为成功次数的平均值, 0表示1次
+    uint8_t samples;
+} gpio_rctime_config_t;
+
+// 通道两点校准: 充电时间raw0_ns对应value0, raw1_ns对应value1, 其间线性插值(RC充电时间与R、C成正比)
+typedef struct
+{
+    uint64_t raw0_ns;
+    double value0;
+    uint64_t raw1_ns;
+    double value1;
+} gpio_rctime_calibration_t;
+
+// 通道测量结果
+typedef struct
+{
+    gpio_rctime_status_e status;
+    // 充电时间(从切换为输入到上升沿的内核时间戳), 单位: ns
+    uint64_t raw_ns;
+    // 校准后的值, 未校准时为充电时间(单位: ns)
+    double value;
+} gpio_rctime_result_t;
+
+// RC充电计时
+typedef struct
+{
+    gpio_rctime_config_t config;
+    // 通道对应的组内序号
+    uint8_t index[GPIO_RCTIME_MAX_CHANNELS];
+    gpio_rctime_calibration_t calibration[GPIO_RCTIME_MAX_CHANNELS];
+    bool calibrated[GPIO_RCTIME_MAX_CHANNELS];
+    uint8_t channel_num;
+    // 全部通道的GPIO掩码
+    uint64_t mask;
+} gpio_rctime_t;
+
+/**
+ * @brief  初始化RC充电计时
+ * @param  rctime: 输出参数, RC充电计时
+ * @param  config: 输入参数, 配置
+ * @return true : 成功
+ * @return false: 失败(GPIO组不是uAPI v2后端时errno为ENOTSUP)
+ */
+bool gpio_rctime_init(gpio_rctime_t *rctime, const gpio_rctime_config_t *config);
+
+/**
+ * @brief  添加通道
+ * @param  rctime: 输入参数, RC充电计时
+ * @param  index : 输入参数, 组内序号, 必须检测上升沿
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_rctime_add_channel(gpio_rctime_t *rctime, const uint8_t index);
+
+/**
+ * @brief  设置通道校准
+ * @param  rctime     : 输入参数, RC充电计时
+ * @param  channel    : 输入参数, 通道序号
+ * @param  calibration: 输入参数, 两点校准, raw0_ns与raw1_ns不能相同
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_rctime_set_calibration(gpio_rctime_t *rctime, const uint8_t channel,
+                                 const gpio_rctime_calibration_t *calibration);
+
+/**
+ * @brief  并行测量全部通道: 一次配置全部切换为输出低电平放电, 再一次配置全部切换为输入,
+ *         由各通道第一个上升沿的内核时间戳得到充电时间
+ * @note   阻塞到全部通道越过阈值或超时; 时间起点为切换输入的ioctl返回时刻, 固定偏差由校准消除
+ * @param  results: 输出参数, 各通道的测量结果, 至少channel_num个元素
+ * @param  rctime : 输入参数, RC充电计时
+ * @return true : 成功(各通道的状态见结果)
+ * @return false: 失败
+ */
+bool gpio_rctime_measure(gpio_rctime_result_t *results, gpio_rctime_t *rctime);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_RCTIME_H
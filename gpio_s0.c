@@ -0,0 +1,597 @@
+/**
+ * @file      : gpio_s0.c
+ * @brief     : S0脉冲计数(电能表/水表)及掉电保存源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 17:20:09
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        创建日志文件后同步所在目录, 检查互斥锁初始化结果, 拒绝重复添加同一GPIO的通道
+ *              2026-10-19 huenrong        补计事件循环普通/低优先级队列满时丢弃的脉冲
+ *
+ */
+
+#include <string.h>
+#include <stddef.h>
+#include <errno.h>
+#include <limits.h>
+#include <libgen.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "./gpio_s0.h"
+#include "./gpio_timer.h"
+
+// 记录魔数"S0J1"
+#define GPIO_S0_MAGIC 0x314A3053
+
+// 记录槽个数
+#define GPIO_S0_SLOTS 2
+
+// CRC32多项式(反射)
+#define GPIO_S0_CRC32_POLY 0xEDB88320
+
+// 日志记录, 每个记录槽的开头一条
+typedef struct
+{
+    uint32_t magic;
+    uint32_t channel_num;
+    // 记录序号, 每次保存加1, 恢复时取校验正确且最大的一个
+    uint64_t sequence;
+    uint64_t counters[GPIO_S0_MAX_CHANNELS];
+    // 以上字段的CRC32
+    uint32_t crc;
+    uint32_t reserved;
+} gpio_s0_record_t;
+
+/**
+ * @brief  计算CRC32(只在保存和恢复时计算, 不使用查找表)
+ * @param  data: 输入参数, 数据
+ * @param  len : 输入参数, 数据长度
+ * @return CRC32
+ */
+static uint32_t gpio_s0_crc32(const uint8_t *data, const size_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            crc = (crc & 1) ? ((crc >> 1) ^ GPIO_S0_CRC32_POLY) : (crc >> 1);
+        }
+    }
+
+    return ~crc;
+}
+
+/**
+ * @brief  检查记录槽
+ * @param  record: 输入参数, 记录
+ * @return true : 记录完整
+ * @return false: 记录无效
+ */
+static bool gpio_s0_check_record(const gpio_s0_record_t *record)
+{
+    return (GPIO_S0_MAGIC == record->magic) && (record->channel_num <= GPIO_S0_MAX_CHANNELS) &&
+           (0 != record->sequence) &&
+           (record->crc == gpio_s0_crc32((const uint8_t *)record, offsetof(gpio_s0_record_t, crc)));
+}
+
+/**
+ * @brief  保存计数(调用前需持有锁): 写入较旧的记录槽后msync
+ * @param  s0: 输入参数, 脉冲计数器
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_s0_commit(gpio_s0_t *s0)
+{
+    gpio_s0_record_t record = {0};
+    uint8_t slot = s0->slot ^ 1;
+    uint64_t start_ns = gpio_timer_now_ns();
+    uint64_t end_ns = 0;
+
+    record.magic = GPIO_S0_MAGIC;
+    record.channel_num = (s0->channel_num > s0->loaded_num) ? s0->channel_num : s0->loaded_num;
+    record.sequence = s0->sequence + 1;
+    memcpy(record.counters, s0->counters, sizeof(record.counters));
+    record.crc = gpio_s0_crc32((const uint8_t *)&record, offsetof(gpio_s0_record_t, crc));
+
+    // 只覆盖较旧的槽, msync完成前掉电时最新的记录仍完整
+    memcpy(s0->map + slot * s0->slot_size, &record, sizeof(gpio_s0_record_t));
+    if (0 != msync(s0->map + slot * s0->slot_size, s0->slot_size, MS_SYNC))
+    {
+        s0->journal_stats.errors++;
+
+        return false;
+    }
+
+    end_ns = gpio_timer_now_ns();
+    s0->slot = slot;
+    s0->sequence = record.sequence;
+    s0->dirty_pulses = 0;
+    s0->sync_ns = end_ns;
+    s0->journal_stats.commits++;
+    s0->journal_stats.last_commit_ns = end_ns - start_ns;
+    if (s0->journal_stats.last_commit_ns > s0->journal_stats.max_commit_ns)
+    {
+        s0->journal_stats.max_commit_ns = s0->journal_stats.last_commit_ns;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  是否到达保存条件(调用前需持有锁)
+ * @param  s0: 输入参数, 脉冲计数器
+ * @return true : 需要保存
+ * @return false: 不需要保存
+ */
+static bool gpio_s0_due(const gpio_s0_t *s0)
+{
+    if (0 == s0->dirty_pulses)
+    {
+        return false;
+    }
+
+    if ((0 != s0->sync_pulses) && (s0->dirty_pulses >= s0->sync_pulses))
+    {
+        return true;
+    }
+
+    return gpio_timer_now_ns() - s0->sync_ns >= s0->sync_interval_ns;
+}
+
+/**
+ * @brief  同步文件所在的目录, 新建的文件掉电后仍在目录中
+ * @param  path: 输入参数, 文件路径
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_s0_sync_dir(const char *path)
+{
+    char dir[PATH_MAX] = {0};
+    int fd = -1;
+    int err = 0;
+
+    // dirname会修改参数, 使用副本
+    if (strlen(path) >= sizeof(dir))
+    {
+        errno = ENAMETOOLONG;
+
+        return false;
+    }
+
+    memcpy(dir, path, strlen(path) + 1);
+    fd = open(dirname(dir), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (0 != fsync(fd))
+    {
+        err = errno;
+        close(fd);
+        errno = err;
+
+        return false;
+    }
+
+    close(fd);
+
+    return true;
+}
+
+/**
+ * @brief  打开S0脉冲计数器: 映射日志文件(不存在时创建), 恢复两个记录槽中校验正确且序号最大的计数
+ * @param  s0              : 输出参数, 脉冲计数器
+ * @param  path            : 输入参数, 日志文件路径
+ * @param  sync_interval_ns: 输入参数, 有脉冲时的保存间隔, 单位: ns, 0表示使用GPIO_S0_DEFAULT_SYNC_INTERVAL_NS
+ * @param  sync_pulses     : 输入参数, 累计该个数的脉冲后立即保存, 0表示只按间隔保存
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_open(gpio_s0_t *s0, const char *path, const uint64_t sync_interval_ns, const uint64_t sync_pulses)
+{
+    struct stat st = {0};
+    long page_size = sysconf(_SC_PAGESIZE);
+    const gpio_s0_record_t *record = NULL;
+    const gpio_s0_record_t *latest = NULL;
+    bool empty = false;
+    bool created = true;
+    int err = 0;
+
+    if ((!s0) || (!path) || (page_size <= 0))
+    {
+        return false;
+    }
+
+    memset(s0, 0, sizeof(gpio_s0_t));
+    s0->sync_interval_ns = (0 != sync_interval_ns) ? sync_interval_ns : GPIO_S0_DEFAULT_SYNC_INTERVAL_NS;
+    s0->sync_pulses = sync_pulses;
+    // 每个记录槽独占整页, msync一个槽不会写回另一个槽
+    s0->slot_size = ((sizeof(gpio_s0_record_t) + (size_t)page_size - 1) / (size_t)page_size) * (size_t)page_size;
+
+    // 先以O_EXCL创建, 区分新建的文件
+    s0->fd = open(path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if ((s0->fd < 0) && (EEXIST == errno))
+    {
+        created = false;
+        s0->fd = open(path, O_RDWR | O_CLOEXEC);
+    }
+
+    if (s0->fd < 0)
+    {
+        return false;
+    }
+
+    if (0 != fstat(s0->fd, &st))
+    {
+        close(s0->fd);
+
+        return false;
+    }
+
+    // 新文件扩展为两个空槽并同步文件大小
+    if ((size_t)st.st_size < GPIO_S0_SLOTS * s0->slot_size)
+    {
+        if ((0 != ftruncate(s0->fd, (off_t)(GPIO_S0_SLOTS * s0->slot_size))) || (0 != fsync(s0->fd)))
+        {
+            close(s0->fd);
+
+            return false;
+        }
+    }
+
+    // 新建的文件还需同步目录项, 否则掉电后文件可能不存在
+    if ((created) && (!gpio_s0_sync_dir(path)))
+    {
+        err = errno;
+        close(s0->fd);
+        errno = err;
+
+        return false;
+    }
+
+    s0->map = mmap(NULL, GPIO_S0_SLOTS * s0->slot_size, PROT_READ | PROT_WRITE, MAP_SHARED, s0->fd, 0);
+    if (MAP_FAILED == s0->map)
+    {
+        close(s0->fd);
+
+        return false;
+    }
+
+    for (uint8_t i = 0; i < GPIO_S0_SLOTS; i++)
+    {
+        record = (const gpio_s0_record_t *)(s0->map + i * s0->slot_size);
+        if (!gpio_s0_check_record(record))
+        {
+            // 从未写过的空槽不算写入中断
+            empty = true;
+            for (size_t j = 0; j < sizeof(gpio_s0_record_t); j++)
+            {
+                if (0 != ((const uint8_t *)record)[j])
+                {
+                    empty = false;
+
+                    break;
+                }
+            }
+
+            if (!empty)
+            {
+                s0->journal_stats.torn++;
+            }
+
+            continue;
+        }
+
+        if ((!latest) || (record->sequence > latest->sequence))
+        {
+            latest = record;
+            s0->slot = i;
+        }
+    }
+
+    // 没有有效记录时下一次写入槽0
+    if (!latest)
+    {
+        s0->slot = GPIO_S0_SLOTS - 1;
+    }
+    else
+    {
+        s0->sequence = latest->sequence;
+        s0->loaded_num = (uint8_t)latest->channel_num;
+        memcpy(s0->counters, latest->counters, latest->channel_num * sizeof(uint64_t));
+        s0->journal_stats.loaded_sequence = latest->sequence;
+    }
+
+    s0->sync_ns = gpio_timer_now_ns();
+    err = pthread_mutex_init(&s0->mutex, NULL);
+    if (0 != err)
+    {
+        munmap(s0->map, GPIO_S0_SLOTS * s0->slot_size);
+        s0->map = NULL;
+        close(s0->fd);
+        s0->fd = -1;
+        errno = err;
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  关闭S0脉冲计数器: 保存未保存的计数后解除映射
+ * @param  s0: 输入参数, 脉冲计数器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_close(gpio_s0_t *s0)
+{
+    bool result = true;
+
+    if ((!s0) || (!s0->map))
+    {
+        return false;
+    }
+
+    result = gpio_s0_sync(s0, true);
+    munmap(s0->map, GPIO_S0_SLOTS * s0->slot_size);
+    s0->map = NULL;
+    close(s0->fd);
+    s0->fd = -1;
+    pthread_mutex_destroy(&s0->mutex);
+
+    return result;
+}
+
+/**
+ * @brief  添加通道, 计数从日志中同一序号的通道恢复
+ * @param  s0     : 输入参数, 脉冲计数器
+ * @param  channel: 输入参数, 通道配置, 同一GPIO组的同一GPIO只能添加一次
+ * @return 成功: 通道序号
+ *         失败: -1(重复添加时errno为EEXIST)
+ */
+int gpio_s0_add_channel(gpio_s0_t *s0, const gpio_s0_channel_t *channel)
+{
+    uint64_t bit = 0;
+    uint64_t dropped = 0;
+    uint8_t index = 0;
+
+    if ((!s0) || (!channel) || (!channel->group) || (channel->index >= channel->group->num))
+    {
+        return -1;
+    }
+
+    // 只补计添加通道之后丢弃的事件
+    if ((channel->loop) && (!gpio_loop_get_dropped(&dropped, channel->loop, channel->group, channel->index)))
+    {
+        errno = ENOENT;
+
+        return -1;
+    }
+
+    // 只检测一个边沿, 事件个数才等于脉冲个数
+    bit = 1ULL << channel->index;
+    if (!((channel->group->rising_mask & bit) ^ (channel->group->falling_mask & bit)))
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&s0->mutex);
+    if (s0->channel_num >= GPIO_S0_MAX_CHANNELS)
+    {
+        pthread_mutex_unlock(&s0->mutex);
+
+        return -1;
+    }
+
+    // 同一GPIO的事件会被重复计数
+    for (uint8_t i = 0; i < s0->channel_num; i++)
+    {
+        if ((channel->group == s0->channels[i].group) && (channel->index == s0->channels[i].index))
+        {
+            pthread_mutex_unlock(&s0->mutex);
+            errno = EEXIST;
+
+            return -1;
+        }
+    }
+
+    index = s0->channel_num;
+    s0->channels[index] = *channel;
+    memset(&s0->stats[index], 0, sizeof(gpio_s0_stats_t));
+    s0->loop_dropped[index] = dropped;
+    s0->channel_num++;
+    pthread_mutex_unlock(&s0->mutex);
+
+    return index;
+}
+
+/**
+ * @brief  补计事件循环丢弃的事件(调用者已加锁)
+ * @param  s0     : 输入参数, 脉冲计数器
+ * @param  channel: 输入参数, 通道序号
+ * @return 补计的脉冲个数
+ */
+static uint64_t gpio_s0_collect_dropped(gpio_s0_t *s0, const uint8_t channel)
+{
+    const gpio_s0_channel_t *config = &s0->channels[channel];
+    uint64_t dropped = 0;
+    uint64_t pulses = 0;
+
+    if ((!config->loop) || (!gpio_loop_get_dropped(&dropped, config->loop, config->group, config->index)) ||
+        (dropped <= s0->loop_dropped[channel]))
+    {
+        return 0;
+    }
+
+    pulses = dropped - s0->loop_dropped[channel];
+    s0->loop_dropped[channel] = dropped;
+    s0->stats[channel].dropped += pulses;
+    s0->counters[channel] += pulses;
+    s0->dirty_pulses += pulses;
+
+    return pulses;
+}
+
+/**
+ * @brief  处理边沿事件: 计数加上事件个数、内核丢失的事件个数和事件循环丢弃的事件个数, 到达保存条件时保存
+ * @note   可直接作为gpio_loop的回调函数, arg为脉冲计数器; 计数只写内存, 保存时才写入映射并msync;
+ *         普通/低优先级的GPIO在队列满时被事件循环丢弃, 须在通道配置中指定事件循环才能补计
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 脉冲计数器
+ */
+void gpio_s0_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_s0_t *s0 = (gpio_s0_t *)arg;
+    gpio_s0_stats_t *stats = NULL;
+    uint64_t pulses = 0;
+    uint64_t dropped = 0;
+
+    if ((!group) || (!event) || (!s0))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&s0->mutex);
+    for (uint8_t i = 0; i < s0->channel_num; i++)
+    {
+        if ((s0->channels[i].group != group) || (s0->channels[i].index != event->index))
+        {
+            continue;
+        }
+
+        stats = &s0->stats[i];
+        pulses = (0 != event->count) ? event->count : 1;
+        dropped = gpio_s0_collect_dropped(s0, i);
+
+        // 干扰过滤只作用于单个事件, 丢失、丢弃或汇总的事件无法区分干扰, 全部计数
+        if ((0 != s0->channels[i].min_interval_ns) && (1 == pulses) && (0 == event->lost) && (0 == dropped) &&
+            (0 != stats->last_ns) && (event->timestamp_ns - stats->last_ns < s0->channels[i].min_interval_ns))
+        {
+            stats->glitches++;
+
+            break;
+        }
+
+        pulses += event->lost;
+        stats->recovered += event->lost;
+        stats->last_ns = event->timestamp_ns;
+        s0->counters[i] += pulses;
+        s0->dirty_pulses += pulses;
+
+        break;
+    }
+
+    if (gpio_s0_due(s0))
+    {
+        gpio_s0_commit(s0);
+    }
+
+    pthread_mutex_unlock(&s0->mutex);
+}
+
+/**
+ * @brief  保存计数: 写入较旧的记录槽后msync, 写入中断时另一个槽仍为完整的上一次记录
+ * @note   force为false时只在有未保存脉冲且到达保存条件时保存, 可在每次gpio_loop_run_once之后调用,
+ *         保证最后一个脉冲之后没有新脉冲时也在保存间隔内写入; 同时补计事件循环丢弃的事件,
+ *         指定了事件循环的通道须在事件循环线程中调用
+ * @param  s0   : 输入参数, 脉冲计数器
+ * @param  force: 输入参数, 有未保存脉冲时立即保存
+ * @return true : 成功(包括不需要保存)
+ * @return false: 失败
+ */
+bool gpio_s0_sync(gpio_s0_t *s0, const bool force)
+{
+    bool result = true;
+
+    if ((!s0) || (!s0->map))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&s0->mutex);
+    // 被丢弃的脉冲之后没有新事件时也能补计
+    for (uint8_t i = 0; i < s0->channel_num; i++)
+    {
+        gpio_s0_collect_dropped(s0, i);
+    }
+
+    if ((force) ? (0 != s0->dirty_pulses) : gpio_s0_due(s0))
+    {
+        result = gpio_s0_commit(s0);
+    }
+
+    pthread_mutex_unlock(&s0->mutex);
+
+    return result;
+}
+
+/**
+ * @brief  获取通道计数
+ * @param  counter: 输出参数, 计数
+ * @param  s0     : 输入参数, 脉冲计数器
+ * @param  channel: 输入参数, 通道序号
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_get_counter(uint64_t *counter, gpio_s0_t *s0, const uint8_t channel)
+{
+    if ((!counter) || (!s0))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&s0->mutex);
+    if (channel >= s0->channel_num)
+    {
+        pthread_mutex_unlock(&s0->mutex);
+
+        return false;
+    }
+
+    *counter = s0->counters[channel];
+    pthread_mutex_unlock(&s0->mutex);
+
+    return true;
+}
+
+/**
+ * @brief  设置通道计数(如更换表计后设置初始读数), 立即保存
+ * @param  s0     : 输入参数, 脉冲计数器
+ * @param  channel: 输入参数, 通道序号
+ * @param  counter: 输入参数, 计数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_set_counter(gpio_s0_t *s0, const uint8_t channel, const uint64_t counter)
+{
+    bool result = false;
+
+    if ((!s0) || (!s0->map))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&s0->mutex);
+    if (channel < s0->channel_num)
+    {
+        s0->counters[channel] = counter;
+        s0->dirty_pulses++;
+        result = gpio_s0_commit(s0);
+    }
+
+    pthread_mutex_unlock(&s0->mutex);
+
+    return result;
+}
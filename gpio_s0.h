@@ -0,0 +1,184 @@
+/**
+ * @file      : gpio_s0.h
+ * @brief     : S0脉冲计数(电能表/水表)及掉电保存头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 17:20:09
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        拒绝重复添加同一GPIO的通道
+ *              2026-10-19 huenrong        补计事件循环普通/低优先级队列满时丢弃的脉冲
+ *
+ */
+
+#ifndef __GPIO_S0_H
+#define __GPIO_S0_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "./gpio_group.h"
+#include "./gpio_loop.h"
+
+// 最大通道数
+#define GPIO_S0_MAX_CHANNELS 64
+
+// 默认保存间隔, 单位: ns
+#define GPIO_S0_DEFAULT_SYNC_INTERVAL_NS 10000000000ULL
+
+// S0通道配置
+typedef struct
+{
+    // 输入GPIO组, 该GPIO只检测计数的一个边沿, 内核丢失和事件循环汇总的事件个数都是脉冲个数
+    gpio_group_t *group;
+    // 输入GPIO组内序号
+    uint8_t index;
+    // 距上一个计数边沿小于该时间的边沿视为干扰, 单位: ns, 0表示不过滤(S0脉冲宽度不小于30ms)
+    uint64_t min_interval_ns;
+    // 分发事件的事件循环(添加通道前已注册该GPIO组), 补计普通/低优先级队列满时丢弃的事件;
+    // NULL表示该GPIO为高优先级或由钩子处理(事件循环不会丢弃), 或不经过事件循环
+    gpio_loop_t *loop;
+} gpio_s0_channel_t;
+
+// S0通道统计
+typedef struct
+{
+    // 由内核丢失事件个数补计的脉冲个数
+    uint64_t recovered;
+    // 由事件循环丢弃事件个数补计的脉冲个数
+    uint64_t dropped;
+    // 被过滤的干扰边沿个数
+    uint64_t glitches;
+    // 最近一个计数边沿的内核时间戳, 单位: ns
+    uint64_t last_ns;
+} gpio_s0_stats_t;
+
+// 保存统计
+typedef struct
+{
+    // 打开时恢复的记录序号, 0表示没有有效记录
+    uint64_t loaded_sequence;
+    // 打开时校验失败(写入中断)的记录个数
+    uint32_t torn;
+    // 已保存的次数
+    uint64_t commits;
+    // 保存失败的次数
+    uint64_t errors;
+    // 最近一次/最长保存耗时(写入记录和msync), 单位: ns
+    uint64_t last_commit_ns;
+    uint64_t max_commit_ns;
+} gpio_s0_journal_stats_t;
+
+// S0脉冲计数器
+typedef struct
+{
+    // 保护计数、通道和日志, 事件循环线程计数与其他线程读取/保存互斥
+    pthread_mutex_t mutex;
+    // 日志文件及其映射: 两个页对齐的记录槽交替写入
+    int fd;
+    uint8_t *map;
+    size_t slot_size;
+    // 最新有效记录所在的槽和序号
+    uint8_t slot;
+    uint64_t sequence;
+    // 保存间隔(ns)和保存前最多累计的脉冲个数(0表示不按个数保存)
+    uint64_t sync_interval_ns;
+    uint64_t sync_pulses;
+    // 上次保存后的脉冲个数和上次保存时刻
+    uint64_t dirty_pulses;
+    uint64_t sync_ns;
+    gpio_s0_channel_t channels[GPIO_S0_MAX_CHANNELS];
+    // 各通道计数, 打开时从日志恢复, 按通道序号依次属于添加的通道
+    uint64_t counters[GPIO_S0_MAX_CHANNELS];
+    gpio_s0_stats_t stats[GPIO_S0_MAX_CHANNELS];
+    // 各通道已补计到的事件循环丢弃数
+    uint64_t loop_dropped[GPIO_S0_MAX_CHANNELS];
+    uint8_t channel_num;
+    // 日志中恢复的计数个数, 尚未添加的通道的计数保存时原样写回
+    uint8_t loaded_num;
+    gpio_s0_journal_stats_t journal_stats;
+} gpio_s0_t;
+
+/**
+ * @brief  打开S0脉冲计数器: 映射日志文件(不存在时创建), 恢复两个记录槽中校验正确且序号最大的计数
+ * @param  s0              : 输出参数, 脉冲计数器
+ * @param  path            : 输入参数, 日志文件路径
+ * @param  sync_interval_ns: 输入参数, 有脉冲时的保存间隔, 单位: ns, 0表示使用GPIO_S0_DEFAULT_SYNC_INTERVAL_NS
+ * @param  sync_pulses     : 输入参数, 累计该个数的脉冲后立即保存, 0表示只按间隔保存
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_open(gpio_s0_t *s0, const char *path, const uint64_t sync_interval_ns, const uint64_t sync_pulses);
+
+/**
+ * @brief  关闭S0脉冲计数器: 保存未保存的计数后解除映射
+ * @param  s0: 输入参数, 脉冲计数器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_close(gpio_s0_t *s0);
+
+/**
+ * @brief  添加通道, 计数从日志中同一序号的通道恢复
+ * @param  s0     : 输入参数, 脉冲计数器
+ * @param  channel: 输入参数, 通道配置, 同一GPIO组的同一GPIO只能添加一次
+ * @return 成功: 通道序号
+ *         失败: -1(重复添加时errno为EEXIST, 指定的事件循环未注册该GPIO组时errno为ENOENT)
+ */
+int gpio_s0_add_channel(gpio_s0_t *s0, const gpio_s0_channel_t *channel);
+
+/**
+ * @brief  处理边沿事件: 计数加上事件个数、内核丢失的事件个数和事件循环丢弃的事件个数, 到达保存条件时保存
+ * @note   可直接作为gpio_loop的回调函数, arg为脉冲计数器; 计数只写内存, 保存时才写入映射并msync;
+ *         普通/低优先级的GPIO在队列满时被事件循环丢弃, 须在通道配置中指定事件循环才能补计
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 脉冲计数器
+ */
+void gpio_s0_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+/**
+ * @brief  保存计数: 写入较旧的记录槽后msync, 写入中断时另一个槽仍为完整的上一次记录
+ * @note   force为false时只在有未保存脉冲且到达保存条件时保存, 可在每次gpio_loop_run_once之后调用,
+ *         保证最后一个脉冲之后没有新脉冲时也在保存间隔内写入; 同时补计事件循环丢弃的事件,
+ *         指定了事件循环的通道须在事件循环线程中调用
+ * @param  s0   : 输入参数, 脉冲计数器
+ * @param  force: 输入参数, 有未保存脉冲时立即保存
+ * @return true : 成功(包括不需要保存)
+ * @return false: 失败
+ */
+bool gpio_s0_sync(gpio_s0_t *s0, const bool force);
+
+/**
+ * @brief  获取通道计数
+ * @param  counter: 输出参数, 计数
+ * @param  s0     : 输入参数, 脉冲计数器
+ * @param  channel: 输入参数, 通道序号
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_get_counter(uint64_t *counter, gpio_s0_t *s0, const uint8_t channel);
+
+/**
+ * @brief  设置通道计数(如更换表计后设置初始读数), 立即保存
+ * @param  s0     : 输入参数, 脉冲计数器
+ * @param  channel: 输入参数, 通道序号
+ * @param  counter: 输入参数, 计数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_s0_set_counter(gpio_s0_t *s0, const uint8_t channel, const uint64_t counter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_S0_H
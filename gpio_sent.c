@@ -0,0 +1,400 @@
+/**
+ * @file      : gpio_sent.c
+ * @brief     : SENT(SAE J2716)协议解码源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 13:15:47
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_sent.h"
+
+// 同步脉冲的tick数
+#define GPIO_SENT_SYNC_TICKS 56
+
+// 半字节脉冲的最小tick数(值为0时)
+#define GPIO_SENT_NIBBLE_TICKS 12
+
+// 同步脉冲允许偏离标称值的比例(1/5, 即20%)
+#define GPIO_SENT_SYNC_TOLERANCE 5
+
+// 相邻两次同步脉冲校准允许的偏差比例(1/64)
+#define GPIO_SENT_SYNC_DRIFT 64
+
+// CRC种子
+#define GPIO_SENT_CRC4_SEED 0x05
+#define GPIO_SENT_CRC6_SEED 0x15
+
+// CRC6多项式x^6+x^4+x^3+1(不含最高项)
+#define GPIO_SENT_CRC6_POLY 0x19
+
+// 短串行消息16帧, bit3在第1帧为1, 其余为0
+#define GPIO_SENT_SHORT_FRAMES 16
+#define GPIO_SENT_SHORT_BIT3 0x8000
+
+// 增强型串行消息18帧, bit3为111111 0 C xxxx 0 xxxx 0
+#define GPIO_SENT_ENHANCED_FRAMES 18
+#define GPIO_SENT_ENHANCED_MASK 0x3F821
+#define GPIO_SENT_ENHANCED_BIT3 0x3F000
+
+// 解码阶段: 寻找同步脉冲、接收半字节、等待暂停脉冲、期望同步脉冲
+#define GPIO_SENT_PHASE_HUNT 0
+#define GPIO_SENT_PHASE_NIBBLE 1
+#define GPIO_SENT_PHASE_PAUSE 2
+#define GPIO_SENT_PHASE_SYNC 3
+
+// CRC4查找表: 多项式x^4+x^3+x^2+1, table[i]为i * x^4的余数
+static const uint8_t gpio_sent_crc4_table[16] = {0, 13, 7, 10, 14, 3, 9, 4, 1, 12, 6, 11, 15, 2, 8, 5};
+
+/**
+ * @brief  初始化SENT解码器
+ * @param  sent: 输出参数, SENT解码器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_sent_init(gpio_sent_t *sent)
+{
+    if (!sent)
+    {
+        return false;
+    }
+
+    memset(sent, 0, sizeof(gpio_sent_t));
+
+    return true;
+}
+
+/**
+ * @brief  添加SENT通道
+ * @param  sent   : 输入参数, SENT解码器
+ * @param  channel: 输入参数, 通道配置
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_sent_add_channel(gpio_sent_t *sent, const gpio_sent_channel_t *channel)
+{
+    uint8_t index = 0;
+
+    if ((!sent) || (!channel) || (sent->channel_num >= GPIO_SENT_MAX_CHANNELS))
+    {
+        return -1;
+    }
+
+    if ((!channel->group) || (channel->index >= channel->group->num) ||
+        (!(channel->group->falling_mask & (1ULL << channel->index))) || (0 == channel->tick_ns) ||
+        (0 == channel->data_nibbles) || (channel->data_nibbles > GPIO_SENT_MAX_NIBBLES))
+    {
+        return -1;
+    }
+
+    index = sent->channel_num;
+    sent->channels[index] = *channel;
+    memset(&sent->states[index], 0, sizeof(gpio_sent_state_t));
+    memset(&sent->stats[index], 0, sizeof(gpio_sent_stats_t));
+    sent->channel_num++;
+
+    return index;
+}
+
+/**
+ * @brief  计算SENT的CRC4(种子5, 多项式x^4+x^3+x^2+1)
+ * @param  nibbles: 输入参数, 半字节
+ * @param  num    : 输入参数, 半字节个数
+ * @param  crc    : 输入参数, CRC算法
+ * @return CRC4
+ */
+uint8_t gpio_sent_crc4(const uint8_t *nibbles, const uint8_t num, const gpio_sent_crc_e crc)
+{
+    uint8_t value = GPIO_SENT_CRC4_SEED;
+
+    for (uint8_t i = 0; i < num; i++)
+    {
+        value = gpio_sent_crc4_table[value] ^ (nibbles[i] & 0x0F);
+    }
+
+    if (E_GPIO_SENT_CRC_RECOMMENDED == crc)
+    {
+        value = gpio_sent_crc4_table[value];
+    }
+
+    return value;
+}
+
+/**
+ * @brief  计算增强型串行消息的CRC6: 第7~18帧的bit2/bit3交替排列为24位, 再补6个0
+ * @param  slow2: 输入参数, 18帧的bit2(第1帧在最高位)
+ * @param  slow3: 输入参数, 18帧的bit3(第1帧在最高位)
+ * @return CRC6
+ */
+static uint8_t gpio_sent_crc6(const uint32_t slow2, const uint32_t slow3)
+{
+    uint8_t value = GPIO_SENT_CRC6_SEED;
+    uint8_t bit = 0;
+    uint8_t top = 0;
+
+    for (int8_t i = 23 + 6; i >= 0; i--)
+    {
+        // i >= 6时为消息位: 奇数位取bit2, 偶数位取bit3
+        bit = (i < 6) ? 0 : ((((i - 6) & 1) ? slow2 : slow3) >> ((i - 6) >> 1)) & 1;
+        top = (value >> 5) & 1;
+        value = (uint8_t)(((value << 1) | bit) & 0x3F);
+        if (top)
+        {
+            value ^= GPIO_SENT_CRC6_POLY;
+        }
+    }
+
+    return value;
+}
+
+/**
+ * @brief  收集状态半字节的慢速通道位, 识别短/增强型串行消息
+ * @param  sent        : 输入参数, SENT解码器
+ * @param  index       : 输入参数, 通道序号
+ * @param  status      : 输入参数, 状态半字节
+ * @param  timestamp_ns: 输入参数, 帧时间戳, 单位: ns
+ */
+static void gpio_sent_slow(gpio_sent_t *sent, const uint8_t index, const uint8_t status, const uint64_t timestamp_ns)
+{
+    gpio_sent_channel_t *channel = &sent->channels[index];
+    gpio_sent_state_t *state = &sent->states[index];
+    gpio_sent_message_t message = {0};
+    uint8_t nibbles[3] = {0};
+    uint16_t bits = 0;
+    uint8_t x1 = 0;
+    uint8_t x2 = 0;
+
+    state->slow2 = ((state->slow2 << 1) | ((status >> 2) & 1)) & ((1U << GPIO_SENT_ENHANCED_FRAMES) - 1);
+    state->slow3 = ((state->slow3 << 1) | ((status >> 3) & 1)) & ((1U << GPIO_SENT_ENHANCED_FRAMES) - 1);
+    if (state->slow_num < GPIO_SENT_ENHANCED_FRAMES)
+    {
+        state->slow_num++;
+    }
+
+    message.timestamp_ns = timestamp_ns;
+    if ((GPIO_SENT_ENHANCED_FRAMES == state->slow_num) &&
+        (GPIO_SENT_ENHANCED_BIT3 == (state->slow3 & GPIO_SENT_ENHANCED_MASK)))
+    {
+        if (gpio_sent_crc6(state->slow2, state->slow3) != ((state->slow2 >> 12) & 0x3F))
+        {
+            sent->stats[index].message_crc_errors++;
+
+            return;
+        }
+
+        // 第8帧的bit3为配置位: 0为8位ID + 12位数据, 1为4位ID + 16位数据
+        x1 = (state->slow3 >> 6) & 0x0F;
+        x2 = (state->slow3 >> 1) & 0x0F;
+        message.enhanced = true;
+        message.data = state->slow2 & 0x0FFF;
+        if (state->slow3 & (1U << 10))
+        {
+            message.id = x1;
+            message.data |= (uint16_t)(x2 << 12);
+        }
+        else
+        {
+            message.id = (uint8_t)((x1 << 4) | x2);
+        }
+    }
+    else if ((state->slow_num >= GPIO_SENT_SHORT_FRAMES) &&
+             (GPIO_SENT_SHORT_BIT3 == (state->slow3 & ((1U << GPIO_SENT_SHORT_FRAMES) - 1))))
+    {
+        bits = state->slow2 & 0xFFFF;
+        nibbles[0] = (bits >> 12) & 0x0F;
+        nibbles[1] = (bits >> 8) & 0x0F;
+        nibbles[2] = (bits >> 4) & 0x0F;
+        if (gpio_sent_crc4(nibbles, 3, channel->crc) != (bits & 0x0F))
+        {
+            sent->stats[index].message_crc_errors++;
+
+            return;
+        }
+
+        message.id = nibbles[0];
+        message.data = (bits >> 4) & 0xFF;
+    }
+    else
+    {
+        return;
+    }
+
+    // 一条消息只输出一次, 下一条消息重新收集
+    state->slow_num = 0;
+    sent->stats[index].messages++;
+    if (channel->message_callback)
+    {
+        channel->message_callback(index, &message, channel->arg);
+    }
+}
+
+/**
+ * @brief  帧接收完成: 校验CRC, 回调并处理慢速通道
+ * @param  sent : 输入参数, SENT解码器
+ * @param  index: 输入参数, 通道序号
+ */
+static void gpio_sent_frame(gpio_sent_t *sent, const uint8_t index)
+{
+    gpio_sent_channel_t *channel = &sent->channels[index];
+    gpio_sent_state_t *state = &sent->states[index];
+    gpio_sent_frame_t frame = {0};
+    uint8_t num = channel->data_nibbles;
+
+    state->phase = channel->pause ? GPIO_SENT_PHASE_PAUSE : GPIO_SENT_PHASE_SYNC;
+    if (state->drop)
+    {
+        return;
+    }
+
+    // 状态半字节不参与CRC
+    if (gpio_sent_crc4(&state->nibbles[1], num, channel->crc) != state->nibbles[num + 1])
+    {
+        sent->stats[index].crc_errors++;
+
+        return;
+    }
+
+    sent->stats[index].frames++;
+    frame.status = state->nibbles[0];
+    memcpy(frame.data, &state->nibbles[1], num);
+    frame.num = num;
+    frame.tick_ns = (uint32_t)((state->sync_ns + GPIO_SENT_SYNC_TICKS / 2) / GPIO_SENT_SYNC_TICKS);
+    frame.timestamp_ns = state->frame_ns;
+    if (channel->frame_callback)
+    {
+        channel->frame_callback(index, &frame, channel->arg);
+    }
+
+    gpio_sent_slow(sent, index, frame.status, frame.timestamp_ns);
+}
+
+/**
+ * @brief  处理一个脉冲(相邻两个下降沿的间隔)
+ * @param  sent        : 输入参数, SENT解码器
+ * @param  index       : 输入参数, 通道序号
+ * @param  interval    : 输入参数, 脉冲长度, 单位: ns
+ * @param  timestamp_ns: 输入参数, 脉冲结束的下降沿时间戳, 单位: ns
+ */
+static void gpio_sent_pulse(gpio_sent_t *sent, const uint8_t index, const uint64_t interval,
+                            const uint64_t timestamp_ns)
+{
+    gpio_sent_channel_t *channel = &sent->channels[index];
+    gpio_sent_state_t *state = &sent->states[index];
+    uint64_t nominal = (uint64_t)channel->tick_ns * GPIO_SENT_SYNC_TICKS;
+    uint64_t diff = 0;
+    int64_t value = 0;
+
+    switch (state->phase)
+    {
+    case GPIO_SENT_PHASE_NIBBLE:
+    {
+        // 按同步脉冲长度换算为tick并四舍五入, 不先求tick以免损失精度
+        value = (int64_t)((interval * GPIO_SENT_SYNC_TICKS * 2 + state->sync_ns) / (state->sync_ns * 2)) -
+                GPIO_SENT_NIBBLE_TICKS;
+        if ((value >= 0) && (value <= 15))
+        {
+            state->nibbles[state->num++] = (uint8_t)value;
+            if (state->num == channel->data_nibbles + 2)
+            {
+                gpio_sent_frame(sent, index);
+            }
+
+            return;
+        }
+
+        // 帧不完整时该脉冲可能是下一帧的同步脉冲
+        sent->stats[index].nibble_errors++;
+        state->phase = GPIO_SENT_PHASE_HUNT;
+        break;
+    }
+
+    case GPIO_SENT_PHASE_PAUSE:
+    {
+        state->phase = GPIO_SENT_PHASE_SYNC;
+
+        return;
+    }
+
+    default:
+    {
+        break;
+    }
+    }
+
+    diff = (interval > nominal) ? (interval - nominal) : (nominal - interval);
+    if (diff > nominal / GPIO_SENT_SYNC_TOLERANCE)
+    {
+        if (GPIO_SENT_PHASE_SYNC == state->phase)
+        {
+            sent->stats[index].sync_errors++;
+        }
+
+        state->phase = GPIO_SENT_PHASE_HUNT;
+
+        return;
+    }
+
+    // 连续帧的同步脉冲变化过大说明时钟异常或脉冲识别错误, 丢弃该帧, 以新的长度重新校准
+    state->drop = false;
+    if (GPIO_SENT_PHASE_SYNC == state->phase)
+    {
+        diff = (interval > state->sync_ns) ? (interval - state->sync_ns) : (state->sync_ns - interval);
+        if (diff > state->sync_ns / GPIO_SENT_SYNC_DRIFT)
+        {
+            sent->stats[index].sync_errors++;
+            state->drop = true;
+        }
+    }
+
+    state->sync_ns = interval;
+    state->frame_ns = timestamp_ns - interval;
+    state->num = 0;
+    state->phase = GPIO_SENT_PHASE_NIBBLE;
+}
+
+/**
+ * @brief  处理下降沿事件: 相邻下降沿间隔为一个脉冲, 由同步脉冲校准tick后解码半字节, 收满一帧后校验CRC并组装慢速通道消息
+ * @note   可直接作为gpio_loop的回调函数, arg为SENT解码器; 多个传感器可在同一个GPIO组中, 由一个事件线程解码
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, SENT解码器
+ */
+void gpio_sent_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_sent_t *sent = (gpio_sent_t *)arg;
+    gpio_sent_state_t *state = NULL;
+
+    if ((!sent) || (!group) || (!event) || (E_GPIO_FALLING != event->edge))
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < sent->channel_num; i++)
+    {
+        if ((group != sent->channels[i].group) || (event->index != sent->channels[i].index))
+        {
+            continue;
+        }
+
+        state = &sent->states[i];
+
+        // 丢失或合并的边沿使脉冲长度失效, 以本边沿为起点重新寻找同步脉冲
+        if ((0 != event->lost) || (event->count > 1))
+        {
+            sent->stats[i].lost += (0 != event->lost) ? event->lost : (event->count - 1);
+            state->phase = GPIO_SENT_PHASE_HUNT;
+        }
+        else if (0 != state->last_ns)
+        {
+            gpio_sent_pulse(sent, i, event->timestamp_ns - state->last_ns, event->timestamp_ns);
+        }
+
+        state->last_ns = event->timestamp_ns;
+    }
+}
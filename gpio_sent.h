@@ -0,0 +1,195 @@
+/**
+ * @file      : gpio_sent.h
+ * @brief     : SENT(SAE J2716)协议解码头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 13:15:47
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_SENT_H
+#define __GPIO_SENT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+
+// SENT解码器最多的通道(传感器)数
+#define GPIO_SENT_MAX_CHANNELS 32
+
+// 每帧最多的数据半字节个数
+#define GPIO_SENT_MAX_NIBBLES 6
+
+// CRC算法
+typedef enum
+{
+    // 2010版推荐算法: 数据半字节之后再补一个0半字节
+    E_GPIO_SENT_CRC_RECOMMENDED = 0,
+    // 旧版算法: 不补0
+    E_GPIO_SENT_CRC_LEGACY = 1,
+} gpio_sent_crc_e;
+
+// 快速通道帧
+typedef struct
+{
+    // 状态半字节(bit2/bit3为慢速通道)
+    uint8_t status;
+    // 数据半字节
+    uint8_t data[GPIO_SENT_MAX_NIBBLES];
+    uint8_t num;
+    // 由同步脉冲校准的tick, 单位: ns
+    uint32_t tick_ns;
+    // 同步脉冲起始下降沿的内核时间戳, 单位: ns
+    uint64_t timestamp_ns;
+} gpio_sent_frame_t;
+
+// 慢速通道消息
+typedef struct
+{
+    // 增强型串行消息(18帧), 否则为短串行消息(16帧)
+    bool enhanced;
+    // 消息ID(短消息4位, 增强型8位或4位)
+    uint8_t id;
+    // 数据(短消息8位, 增强型12位或16位)
+    uint16_t data;
+    // 消息最后一帧的时间戳, 单位: ns
+    uint64_t timestamp_ns;
+} gpio_sent_message_t;
+
+/**
+ * @brief  快速通道帧回调函数(CRC正确), 在事件循环线程中调用
+ * @param  channel: 输入参数, 通道序号
+ * @param  frame  : 输入参数, 帧
+ * @param  arg    : 输入参数, 通道配置中的用户参数
+ */
+typedef void (*gpio_sent_frame_callback_t)(const uint8_t channel, const gpio_sent_frame_t *frame, void *arg);
+
+/**
+ * @brief  慢速通道消息回调函数(CRC正确), 在事件循环线程中调用
+ * @param  channel: 输入参数, 通道序号
+ * @param  message: 输入参数, 消息
+ * @param  arg    : 输入参数, 通道配置中的用户参数
+ */
+typedef void (*gpio_sent_message_callback_t)(const uint8_t channel, const gpio_sent_message_t *message, void *arg);
+
+// SENT通道配置
+typedef struct
+{
+    // 输入GPIO组(需检测下降沿)
+    gpio_group_t *group;
+    // 输入GPIO组内序号
+    uint8_t index;
+    // 标称tick, 单位: ns(常用3000), 同步脉冲偏离标称值超过20%时不接受
+    uint32_t tick_ns;
+    // 每帧数据半字节个数[1, GPIO_SENT_MAX_NIBBLES]
+    uint8_t data_nibbles;
+    gpio_sent_crc_e crc;
+    // 帧之间有暂停脉冲
+    bool pause;
+    // 快速通道帧回调函数, 可以为NULL
+    gpio_sent_frame_callback_t frame_callback;
+    // 慢速通道消息回调函数, 可以为NULL
+    gpio_sent_message_callback_t message_callback;
+    // 用户参数
+    void *arg;
+} gpio_sent_channel_t;
+
+// 通道统计
+typedef struct
+{
+    // CRC正确的帧个数
+    uint64_t frames;
+    // 帧CRC错误个数
+    uint64_t crc_errors;
+    // 期望同步脉冲时长度不符, 或与上一次校准的偏差超过1/64的次数(该帧丢弃)
+    uint64_t sync_errors;
+    // 半字节超出0~15的次数
+    uint64_t nibble_errors;
+    // 慢速通道消息个数
+    uint64_t messages;
+    // 慢速通道消息CRC错误个数
+    uint64_t message_crc_errors;
+    // 内核丢失或事件循环合并的事件个数
+    uint64_t lost;
+} gpio_sent_stats_t;
+
+// 通道解码状态
+typedef struct
+{
+    // 解码阶段
+    uint8_t phase;
+    // 当前帧丢弃(同步脉冲校准偏差过大)
+    bool drop;
+    // 上一个下降沿时间戳, 单位: ns
+    uint64_t last_ns;
+    // 同步脉冲长度(56 tick), 单位: ns
+    uint64_t sync_ns;
+    // 当前帧: 状态 + 数据 + CRC半字节
+    uint8_t nibbles[GPIO_SENT_MAX_NIBBLES + 2];
+    uint8_t num;
+    uint64_t frame_ns;
+    // 慢速通道: 最近18帧状态半字节的bit2/bit3(最早的在高位)
+    uint32_t slow2;
+    uint32_t slow3;
+    uint8_t slow_num;
+} gpio_sent_state_t;
+
+// SENT解码器
+typedef struct
+{
+    gpio_sent_channel_t channels[GPIO_SENT_MAX_CHANNELS];
+    gpio_sent_state_t states[GPIO_SENT_MAX_CHANNELS];
+    gpio_sent_stats_t stats[GPIO_SENT_MAX_CHANNELS];
+    uint8_t channel_num;
+} gpio_sent_t;
+
+/**
+ * @brief  初始化SENT解码器
+ * @param  sent: 输出参数, SENT解码器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_sent_init(gpio_sent_t *sent);
+
+/**
+ * @brief  添加SENT通道
+ * @param  sent   : 输入参数, SENT解码器
+ * @param  channel: 输入参数, 通道配置
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_sent_add_channel(gpio_sent_t *sent, const gpio_sent_channel_t *channel);
+
+/**
+ * @brief  处理下降沿事件: 相邻下降沿间隔为一个脉冲, 由同步脉冲校准tick后解码半字节, 收满一帧后校验CRC并组装慢速通道消息
+ * @note   可直接作为gpio_loop的回调函数, arg为SENT解码器; 多个传感器可在同一个GPIO组中, 由一个事件线程解码
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, SENT解码器
+ */
+void gpio_sent_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+/**
+ * @brief  计算SENT的CRC4(种子5, 多项式x^4+x^3+x^2+1)
+ * @param  nibbles: 输入参数, 半字节
+ * @param  num    : 输入参数, 半字节个数
+ * @param  crc    : 输入参数, CRC算法
+ * @return CRC4
+ */
+uint8_t gpio_sent_crc4(const uint8_t *nibbles, const uint8_t num, const gpio_sent_crc_e crc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_SENT_H
@@ -0,0 +1,455 @@
+/**
+ * @file      : gpio_shm.c
+ * @brief     : 共享内存输入电平快照源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 17:58:31
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        电平位图拆分为32位字, 创建时检查原所有者是否仍在运行
+ *              2026-10-19 huenrong        创建时检查互斥锁初始化结果
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "./gpio_shm.h"
+#include "./gpio_timer.h"
+
+// 快照魔数"GSHM"
+#define GPIO_SHM_MAGIC 0x4D485347
+
+/**
+ * @brief  发布电平(调用前需持有锁): 顺序锁写入
+ * @param  shm         : 输入参数, 快照
+ * @param  mask        : 输入参数, 更新的GPIO掩码
+ * @param  values      : 输入参数, 电平值
+ * @param  timestamp_ns: 输入参数, 时间戳, 单位: ns
+ */
+static void gpio_shm_publish(gpio_shm_t *shm, const uint64_t mask, const uint64_t values,
+                             const uint64_t timestamp_ns)
+{
+    gpio_shm_data_t *data = shm->data;
+    uint32_t sequence = data->sequence;
+    uint64_t new_values = (((uint64_t)data->values_hi << 32) | data->values_lo) & ~mask;
+    uint64_t new_valid = (((uint64_t)data->valid_hi << 32) | data->valid_lo) | mask;
+
+    new_values |= values & mask;
+
+    // 序号变为奇数后才写数据, 写完数据后序号才变为偶数
+    __atomic_store_n(&data->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&data->values_lo, (uint32_t)new_values, __ATOMIC_RELAXED);
+    __atomic_store_n(&data->values_hi, (uint32_t)(new_values >> 32), __ATOMIC_RELAXED);
+    __atomic_store_n(&data->valid_lo, (uint32_t)new_valid, __ATOMIC_RELAXED);
+    __atomic_store_n(&data->valid_hi, (uint32_t)(new_valid >> 32), __ATOMIC_RELAXED);
+    __atomic_store_n(&data->update_ns, timestamp_ns, __ATOMIC_RELAXED);
+    __atomic_store_n(&data->updates, data->updates + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&data->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief  映射共享内存
+ * @param  shm  : 输入输出参数, 快照, 已填写名称和角色
+ * @param  flags: 输入参数, shm_open标志
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_shm_map(gpio_shm_t *shm, const int flags)
+{
+    int fd = -1;
+    struct stat st = {0};
+    void *map = MAP_FAILED;
+
+    fd = shm_open(shm->name, flags | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if ((shm->owner) && (0 != ftruncate(fd, sizeof(gpio_shm_data_t))))
+    {
+        close(fd);
+
+        return false;
+    }
+
+    if (0 != fstat(fd, &st))
+    {
+        close(fd);
+
+        return false;
+    }
+
+    // 所有者尚未设置大小
+    if ((size_t)st.st_size < sizeof(gpio_shm_data_t))
+    {
+        close(fd);
+        errno = EAGAIN;
+
+        return false;
+    }
+
+    map = mmap(NULL, sizeof(gpio_shm_data_t), shm->owner ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd,
+               0);
+    // 映射建立后不再需要文件描述符
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return false;
+    }
+
+    shm->data = (gpio_shm_data_t *)map;
+
+    return true;
+}
+
+/**
+ * @brief  同名快照的所有者进程是否仍在运行
+ * @param  data: 输入参数, 已映射的快照
+ * @return true : 仍在运行
+ * @return false: 没有所有者或已退出
+ */
+static bool gpio_shm_owner_alive(const gpio_shm_data_t *data)
+{
+    pid_t pid = (pid_t)data->owner_pid;
+
+    if ((GPIO_SHM_MAGIC != data->magic) || (pid <= 0) || (pid == getpid()))
+    {
+        return false;
+    }
+
+    // EPERM说明进程存在, 只是不属于当前用户
+    return (0 == kill(pid, 0)) || (EPERM == errno);
+}
+
+/**
+ * @brief  创建共享内存快照(所有者): 读取输入GPIO组当前电平后发布
+ * @note   检测双边沿的GPIO由gpio_shm_on_event跟踪电平, 其他输入GPIO只在gpio_shm_refresh时更新;
+ *         同名快照的所有者进程仍在运行时失败, errno为EBUSY, 所有者已退出时接管
+ * @param  shm  : 输出参数, 快照
+ * @param  name : 输入参数, 共享内存名称, 以'/'开头, 如"/linux_gpio"
+ * @param  group: 输入参数, 输入GPIO组
+ * @return true : 成功
+ * @return false: 失败(同名快照的所有者仍在运行时errno为EBUSY)
+ */
+bool gpio_shm_create(gpio_shm_t *shm, const char *name, gpio_group_t *group)
+{
+    int ret = -1;
+
+    if ((!shm) || (!name) || ('/' != name[0]) || (strlen(name) >= sizeof(shm->name)) || (!group) ||
+        (0 == group->num))
+    {
+        return false;
+    }
+
+    memset(shm, 0, sizeof(gpio_shm_t));
+    snprintf(shm->name, sizeof(shm->name), "%s", name);
+    shm->owner = true;
+    shm->group = group;
+    shm->track_mask = group->rising_mask & group->falling_mask;
+    if (!gpio_shm_map(shm, O_CREAT | O_RDWR))
+    {
+        return false;
+    }
+
+    // 两个所有者交替写入会破坏顺序锁, 只接管所有者已退出的快照
+    if (gpio_shm_owner_alive(shm->data))
+    {
+        munmap(shm->data, sizeof(gpio_shm_data_t));
+        shm->data = NULL;
+        errno = EBUSY;
+
+        return false;
+    }
+
+    // 在写入所有者之前初始化, 失败时不发布快照
+    ret = pthread_mutex_init(&shm->mutex, NULL);
+    if (0 != ret)
+    {
+        munmap(shm->data, sizeof(gpio_shm_data_t));
+        shm->data = NULL;
+        shm_unlink(shm->name);
+        errno = ret;
+
+        return false;
+    }
+
+    // 重新创建时旧的读者可能仍在读取, 序号继续递增, 先置为奇数
+    __atomic_store_n(&shm->data->sequence, (shm->data->sequence | 1), __ATOMIC_RELAXED);
+    __atomic_store_n(&shm->data->magic, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    shm->data->owner_pid = (int32_t)getpid();
+    shm->data->num = group->num;
+    memcpy(shm->data->gpio_nums, group->gpio_nums, sizeof(shm->data->gpio_nums));
+    shm->data->values_lo = 0;
+    shm->data->values_hi = 0;
+    shm->data->valid_lo = 0;
+    shm->data->valid_hi = 0;
+    shm->data->update_ns = 0;
+    shm->data->updates = 0;
+    __atomic_store_n(&shm->data->sequence, shm->data->sequence + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&shm->data->magic, GPIO_SHM_MAGIC, __ATOMIC_RELEASE);
+
+    if (!gpio_shm_refresh(shm))
+    {
+        gpio_shm_destroy(shm);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  销毁共享内存快照(所有者), 删除共享内存名称, 已映射的读者继续读取最后的快照
+ * @param  shm: 输入参数, 快照
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_destroy(gpio_shm_t *shm)
+{
+    if ((!shm) || (!shm->owner) || (!shm->data))
+    {
+        return false;
+    }
+
+    munmap(shm->data, sizeof(gpio_shm_data_t));
+    shm->data = NULL;
+    shm_unlink(shm->name);
+    pthread_mutex_destroy(&shm->mutex);
+
+    return true;
+}
+
+/**
+ * @brief  处理边沿事件(所有者): 由边沿更新对应GPIO的电平并发布
+ * @note   可直接作为gpio_loop的回调函数, arg为快照; 丢失或合并事件时事件的边沿仍是该GPIO最新的电平
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 快照
+ */
+void gpio_shm_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_shm_t *shm = (gpio_shm_t *)arg;
+    uint64_t bit = 0;
+
+    if ((!group) || (!event) || (!shm) || (!shm->data) || (group != shm->group))
+    {
+        return;
+    }
+
+    bit = 1ULL << event->index;
+    if (!(shm->track_mask & bit))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&shm->mutex);
+    gpio_shm_publish(shm, bit, (E_GPIO_RISING == event->edge) ? bit : 0, event->timestamp_ns);
+    pthread_mutex_unlock(&shm->mutex);
+}
+
+/**
+ * @brief  重新读取输入GPIO组的全部输入电平并发布(所有者)
+ * @param  shm: 输入参数, 快照
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_refresh(gpio_shm_t *shm)
+{
+    uint64_t all = 0;
+    uint64_t mask = 0;
+    uint64_t values = 0;
+
+    if ((!shm) || (!shm->owner) || (!shm->data))
+    {
+        return false;
+    }
+
+    all = (GPIO_GROUP_MAX_NUM == shm->group->num) ? UINT64_MAX : ((1ULL << shm->group->num) - 1);
+    mask = all & ~shm->group->output_mask;
+    if (0 == mask)
+    {
+        return true;
+    }
+
+    // 读取和发布在同一把锁内, 不会覆盖读取之后到达的事件
+    pthread_mutex_lock(&shm->mutex);
+    if (!gpio_group_get_values(&values, shm->group, mask))
+    {
+        pthread_mutex_unlock(&shm->mutex);
+
+        return false;
+    }
+
+    gpio_shm_publish(shm, mask, values, gpio_timer_now_ns());
+    pthread_mutex_unlock(&shm->mutex);
+
+    return true;
+}
+
+/**
+ * @brief  打开共享内存快照(读者), 只读映射
+ * @param  shm : 输出参数, 快照
+ * @param  name: 输入参数, 共享内存名称
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_attach(gpio_shm_t *shm, const char *name)
+{
+    if ((!shm) || (!name) || ('/' != name[0]) || (strlen(name) >= sizeof(shm->name)))
+    {
+        return false;
+    }
+
+    memset(shm, 0, sizeof(gpio_shm_t));
+    snprintf(shm->name, sizeof(shm->name), "%s", name);
+    if (!gpio_shm_map(shm, O_RDONLY))
+    {
+        return false;
+    }
+
+    if (GPIO_SHM_MAGIC != __atomic_load_n(&shm->data->magic, __ATOMIC_ACQUIRE))
+    {
+        munmap(shm->data, sizeof(gpio_shm_data_t));
+        shm->data = NULL;
+        errno = EAGAIN;
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  关闭共享内存快照(读者)
+ * @param  shm: 输入参数, 快照
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_detach(gpio_shm_t *shm)
+{
+    if ((!shm) || (shm->owner) || (!shm->data))
+    {
+        return false;
+    }
+
+    munmap(shm->data, sizeof(gpio_shm_data_t));
+    shm->data = NULL;
+
+    return true;
+}
+
+/**
+ * @brief  读取电平位图: 不进入内核, 只有几次内存读取
+ * @param  values    : 输出参数, 电平位图, bit i对应第i个GPIO
+ * @param  valid_mask: 输出参数, 电平已知的GPIO掩码, 可以为NULL
+ * @param  shm       : 输入参数, 快照(所有者或读者)
+ * @return true : 成功
+ * @return false: 失败(所有者在写入中退出时errno为EAGAIN)
+ */
+bool gpio_shm_get_values(uint64_t *values, uint64_t *valid_mask, const gpio_shm_t *shm)
+{
+    const gpio_shm_data_t *data = NULL;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    uint32_t read_values[2] = {0};
+    uint32_t read_valid[2] = {0};
+
+    if ((!values) || (!shm) || (!shm->data))
+    {
+        return false;
+    }
+
+    data = shm->data;
+    for (uint32_t i = 0; i < GPIO_SHM_READ_RETRIES; i++)
+    {
+        begin = __atomic_load_n(&data->sequence, __ATOMIC_ACQUIRE);
+        if (begin & 1)
+        {
+            continue;
+        }
+
+        // 只用32位读取, 只读映射上不能使用64位原子读取
+        read_values[0] = __atomic_load_n(&data->values_lo, __ATOMIC_RELAXED);
+        read_values[1] = __atomic_load_n(&data->values_hi, __ATOMIC_RELAXED);
+        read_valid[0] = __atomic_load_n(&data->valid_lo, __ATOMIC_RELAXED);
+        read_valid[1] = __atomic_load_n(&data->valid_hi, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        end = __atomic_load_n(&data->sequence, __ATOMIC_RELAXED);
+        if (begin != end)
+        {
+            continue;
+        }
+
+        *values = ((uint64_t)read_values[1] << 32) | read_values[0];
+        if (valid_mask)
+        {
+            *valid_mask = ((uint64_t)read_valid[1] << 32) | read_valid[0];
+        }
+
+        return true;
+    }
+
+    errno = EAGAIN;
+
+    return false;
+}
+
+/**
+ * @brief  读取一个GPIO的电平
+ * @param  value   : 输出参数, GPIO电平值
+ * @param  shm     : 输入参数, 快照(所有者或读者)
+ * @param  gpio_num: 输入参数, GPIO编号(与所有者的GPIO组中的编号相同)
+ * @return true : 成功
+ * @return false: 失败(不在快照中或电平未知时errno为ENOENT)
+ */
+bool gpio_shm_get_value(gpio_value_e *value, const gpio_shm_t *shm, const uint16_t gpio_num)
+{
+    uint64_t values = 0;
+    uint64_t valid_mask = 0;
+    uint32_t num = 0;
+
+    if ((!value) || (!shm) || (!shm->data))
+    {
+        return false;
+    }
+
+    // GPIO编号在创建时写入, 之后不再变化
+    num = shm->data->num;
+    for (uint32_t i = 0; (i < num) && (i < GPIO_GROUP_MAX_NUM); i++)
+    {
+        if (shm->data->gpio_nums[i] != gpio_num)
+        {
+            continue;
+        }
+
+        if (!gpio_shm_get_values(&values, &valid_mask, shm))
+        {
+            return false;
+        }
+
+        if (!(valid_mask & (1ULL << i)))
+        {
+            break;
+        }
+
+        *value = ((values >> i) & 1) ? E_GPIO_HIGH : E_GPIO_LOW;
+
+        return true;
+    }
+
+    errno = ENOENT;
+
+    return false;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file      : gpio_shm.h
+ * @brief     : 共享内存输入电平快照头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 17:58:31
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        电平位图拆分为32位字, 创建时检查原所有者是否仍在运行
+ *
+ */
+
+#ifndef __GPIO_SHM_H
+#define __GPIO_SHM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "./gpio.h"
+#include "./gpio_group.h"
+
+// 读者等待写入完成的最大重试次数, 超过时认为所有者进程在写入中退出
+#define GPIO_SHM_READ_RETRIES 10000
+
+// 共享内存中的快照, 由顺序锁保护: 所有者写入前后各把序号加1, 读者读取前后序号相同且为偶数时数据一致
+typedef struct
+{
+    uint32_t magic;
+    // 顺序锁序号, 奇数表示正在写入
+    uint32_t sequence;
+    // 所有者进程号
+    int32_t owner_pid;
+    // GPIO数量及编号(与所有者的GPIO组相同)
+    uint32_t num;
+    uint16_t gpio_nums[GPIO_GROUP_MAX_NUM];
+    // 电平位图的低/高32位, bit i对应第i个GPIO;
+    // 读者只读映射, 拆分为32位字, 避免ARMv7的64位原子读取(LDREXD/STREXD)写只读页
+    uint32_t values_lo;
+    uint32_t values_hi;
+    // 电平已知的GPIO掩码的低/高32位
+    uint32_t valid_lo;
+    uint32_t valid_hi;
+    // 最近一次更新的时间戳(事件的内核时间戳或读取时刻), 单位: ns
+    uint64_t update_ns;
+    // 更新次数
+    uint64_t updates;
+} gpio_shm_data_t;
+
+// 共享内存快照的所有者或读者
+typedef struct
+{
+    // 为true时是所有者(可写), 否则是读者(只读映射)
+    bool owner;
+    char name[64];
+    gpio_shm_data_t *data;
+    // 所有者: 快照对应的GPIO组, 检测双边沿的GPIO由事件跟踪电平
+    gpio_group_t *group;
+    uint64_t track_mask;
+    // 所有者: 同一进程中事件循环线程与刷新线程的写入互斥
+    pthread_mutex_t mutex;
+} gpio_shm_t;
+
+/**
+ * @brief  创建共享内存快照(所有者): 读取输入GPIO组当前电平后发布
+ * @note   检测双边沿的GPIO由gpio_shm_on_event跟踪电平, 其他输入GPIO只在gpio_shm_refresh时更新;
+ *         同名快照的所有者进程仍在运行时失败, errno为EBUSY, 所有者已退出时接管
+ * @param  shm  : 输出参数, 快照
+ * @param  name : 输入参数, 共享内存名称, 以'/'开头, 如"/linux_gpio"
+ * @param  group: 输入参数, 输入GPIO组
+ * @return true : 成功
+ * @return false: 失败(同名快照的所有者仍在运行时errno为EBUSY)
+ */
+bool gpio_shm_create(gpio_shm_t *shm, const char *name, gpio_group_t *group);
+
+/**
+ * @brief  销毁共享内存快照(所有者), 删除共享内存名称, 已映射的读者继续读取最后的快照
+ * @param  shm: 输入参数, 快照
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_destroy(gpio_shm_t *shm);
+
+/**
+ * @brief  处理边沿事件(所有者): 由边沿更新对应GPIO的电平并发布
+ * @note   可直接作为gpio_loop的回调函数, arg为快照; 丢失或合并事件时事件的边沿仍是该GPIO最新的电平
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 快照
+ */
+void gpio_shm_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+/**
+ * @brief  重新读取输入GPIO组的全部输入电平并发布(所有者)
+ * @param  shm: 输入参数, 快照
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_refresh(gpio_shm_t *shm);
+
+/**
+ * @brief  打开共享内存快照(读者), 只读映射
+ * @param  shm : 输出参数, 快照
+ * @param  name: 输入参数, 共享内存名称
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_attach(gpio_shm_t *shm, const char *name);
+
+/**
+ * @brief  关闭共享内存快照(读者)
+ * @param  shm: 输入参数, 快照
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_shm_detach(gpio_shm_t *shm);
+
+/**
+ * @brief  读取电平位图: 不进入内核, 只有几次内存读取
+ * @param  values    : 输出参数, 电平位图, bit i对应第i个GPIO
+ * @param  valid_mask: 输出参数, 电平已知的GPIO掩码, 可以为NULL
+ * @param  shm       : 输入参数, 快照(所有者或读者)
+ * @return true : 成功
+ * @return false: 失败(所有者在写入中退出时errno为EAGAIN)
+ */
+bool gpio_shm_get_values(uint64_t *values, uint64_t *valid_mask, const gpio_shm_t *shm);
+
+/**
+ * @brief  读取一个GPIO的电平
+ * @param  value   : 输出参数, GPIO电平值
+ * @param  shm     : 输入参数, 快照(所有者或读者)
+ * @param  gpio_num: 输入参数, GPIO编号(与所有者的GPIO组中的编号相同)
+ * @return true : 成功
+ * @return false: 失败(不在快照中或电平未知时errno为ENOENT)
+ */
+bool gpio_shm_get_value(gpio_value_e *value, const gpio_shm_t *shm, const uint16_t gpio_num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_SHM_H
@@ -0,0 +1,801 @@
+/**
+ * @file      : gpio_svf.c
+ * @brief     : SVF(Serial Vector Format)文件播放源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 19:02:27
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-19 huenrong        RUNTEST的MAXIMUM按"<时间> SEC"解析
+ *
+ */
+
+// 使用strtok_r/strcasecmp需要定义_GNU_SOURCE
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <time.h>
+#include <errno.h>
+
+#include "./gpio_svf.h"
+
+// 移位参数类型
+typedef enum
+{
+    E_GPIO_SVF_SIR = 0,
+    E_GPIO_SVF_SDR = 1,
+    E_GPIO_SVF_HIR = 2,
+    E_GPIO_SVF_HDR = 3,
+    E_GPIO_SVF_TIR = 4,
+    E_GPIO_SVF_TDR = 5,
+    E_GPIO_SVF_XXR_NUM = 6,
+} gpio_svf_xxr_e;
+
+// 移位参数, 位数不变时TDI/MASK沿用上一次的值
+typedef struct
+{
+    uint32_t len;
+    uint8_t *tdi;
+    uint8_t *tdo;
+    uint8_t *mask;
+    // 本条语句是否指定了TDO
+    bool check;
+} gpio_svf_xxr_t;
+
+// 待校验的TDO
+typedef struct
+{
+    uint8_t *captured;
+    uint8_t *expected;
+    uint8_t *mask;
+    // 数据在捕获结果中的起始位置(跳过header)
+    uint32_t offset;
+    uint32_t bits;
+    uint32_t line;
+} gpio_svf_check_t;
+
+// 播放状态
+typedef struct
+{
+    gpio_jtag_t *jtag;
+    gpio_svf_result_t *result;
+    gpio_svf_xxr_t xxr[E_GPIO_SVF_XXR_NUM];
+    gpio_jtag_state_e endir;
+    gpio_jtag_state_e enddr;
+    gpio_jtag_state_e run_state;
+    gpio_jtag_state_e end_state;
+    gpio_svf_check_t checks[GPIO_JTAG_MAX_CAPTURES];
+    uint8_t check_num;
+    uint32_t line;
+} gpio_svf_t;
+
+// 状态名称, 与gpio_jtag_state_e顺序一致
+static const char *const g_gpio_svf_states[E_GPIO_JTAG_STATE_NUM] = {
+    "RESET",   "IDLE",     "DRSELECT", "DRCAPTURE", "DRSHIFT", "DREXIT1",  "DRPAUSE", "DREXIT2",
+    "DRUPDATE", "IRSELECT", "IRCAPTURE", "IRSHIFT",  "IREXIT1", "IRPAUSE", "IREXIT2", "IRUPDATE",
+};
+
+/**
+ * @brief  记录错误
+ * @param  svf  : 输入参数, 播放状态
+ * @param  error: 输入参数, 出错原因
+ * @return false
+ */
+static bool gpio_svf_error(gpio_svf_t *svf, const char *error)
+{
+    if (0 == svf->result->error_line)
+    {
+        svf->result->error_line = svf->line;
+        snprintf(svf->result->error, sizeof(svf->result->error), "%s", error);
+    }
+
+    return false;
+}
+
+/**
+ * @brief  读取一条语句(到';'为止), 去掉注释, 括号内的空白被删除, 括号前后补空格
+ * @param  buf : 输入输出参数, 语句缓冲区, 不足时自动扩容
+ * @param  size: 输入输出参数, 缓冲区大小
+ * @param  svf : 输入参数, 播放状态(更新行号)
+ * @param  fp  : 输入参数, SVF文件
+ * @return true : 成功
+ * @return false: 文件结束
+ */
+static bool gpio_svf_read_statement(char **buf, size_t *size, gpio_svf_t *svf, FILE *fp)
+{
+    size_t len = 0;
+    bool paren = false;
+    bool comment = false;
+    int c = 0;
+    int next = 0;
+    char *tmp = NULL;
+
+    while (EOF != (c = fgetc(fp)))
+    {
+        if ('\n' == c)
+        {
+            svf->line++;
+            comment = false;
+        }
+
+        if (comment)
+        {
+            continue;
+        }
+
+        if ((!paren) && ('!' == c))
+        {
+            comment = true;
+
+            continue;
+        }
+
+        if ((!paren) && ('/' == c))
+        {
+            next = fgetc(fp);
+            if ('/' == next)
+            {
+                comment = true;
+
+                continue;
+            }
+
+            ungetc(next, fp);
+        }
+
+        if ((!paren) && (';' == c))
+        {
+            (*buf)[len] = '\0';
+
+            return true;
+        }
+
+        if ((paren) && (isspace(c)))
+        {
+            continue;
+        }
+
+        // 预留括号前后的空格和结束符
+        if (len + 4 >= *size)
+        {
+            tmp = realloc(*buf, *size * 2);
+            if (!tmp)
+            {
+                return false;
+            }
+
+            *buf = tmp;
+            *size *= 2;
+        }
+
+        if ('(' == c)
+        {
+            paren = true;
+            (*buf)[len++] = ' ';
+        }
+
+        (*buf)[len++] = (char)(isspace(c) ? ' ' : c);
+
+        if (')' == c)
+        {
+            paren = false;
+            (*buf)[len++] = ' ';
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  解析状态名称
+ * @param  state: 输出参数, 状态
+ * @param  name : 输入参数, 状态名称
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_svf_parse_state(gpio_jtag_state_e *state, const char *name)
+{
+    for (uint8_t i = 0; i < E_GPIO_JTAG_STATE_NUM; i++)
+    {
+        if (0 == strcasecmp(name, g_gpio_svf_states[i]))
+        {
+            *state = (gpio_jtag_state_e)i;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  解析"(十六进制)"为LSB优先的位数组, 十六进制字符串最右边为第0位
+ * @param  data: 输入输出参数, 位数组, 按位数重新分配
+ * @param  bits: 输入参数, 位数
+ * @param  str : 输入参数, "(十六进制)"
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_svf_parse_hex(uint8_t **data, const uint32_t bits, const char *str)
+{
+    size_t len = strlen(str);
+    uint32_t size = (bits + 7) / 8;
+    uint8_t *tmp = NULL;
+    uint32_t nibble = 0;
+    int c = 0;
+    int value = 0;
+
+    if ((len < 2) || ('(' != str[0]) || (')' != str[len - 1]))
+    {
+        return false;
+    }
+
+    tmp = realloc(*data, (0 == size) ? 1 : size);
+    if (!tmp)
+    {
+        return false;
+    }
+
+    *data = tmp;
+    memset(tmp, 0, (0 == size) ? 1 : size);
+    for (size_t i = len - 1; i > 1; i--)
+    {
+        c = toupper((unsigned char)str[i - 1]);
+        if (!isxdigit(c))
+        {
+            return false;
+        }
+
+        value = isdigit(c) ? (c - '0') : (c - 'A' + 10);
+        if (nibble * 4 < bits)
+        {
+            tmp[nibble / 2] |= (uint8_t)(value << ((nibble % 2) * 4));
+        }
+
+        nibble++;
+    }
+
+    // 超出位数的高位清零
+    if (0 != (bits % 8))
+    {
+        tmp[size - 1] &= (uint8_t)((1U << (bits % 8)) - 1);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  按位数组复制位
+ * @param  dest       : 输出参数, 目标位数组
+ * @param  dest_offset: 输入参数, 目标起始位
+ * @param  src        : 输入参数, 源位数组, 为NULL时复制0
+ * @param  bits       : 输入参数, 位数
+ */
+static void gpio_svf_copy_bits(uint8_t *dest, const uint32_t dest_offset, const uint8_t *src, const uint32_t bits)
+{
+    uint32_t pos = 0;
+
+    for (uint32_t i = 0; i < bits; i++)
+    {
+        pos = dest_offset + i;
+        if ((src) && (src[i / 8] & (1U << (i % 8))))
+        {
+            dest[pos / 8] |= (uint8_t)(1U << (pos % 8));
+        }
+        else
+        {
+            dest[pos / 8] &= (uint8_t)~(1U << (pos % 8));
+        }
+    }
+}
+
+/**
+ * @brief  执行已编译的波形并校验TDO
+ * @param  svf: 输入参数, 播放状态
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_svf_flush(gpio_svf_t *svf)
+{
+    gpio_svf_check_t *check = NULL;
+    uint32_t pos = 0;
+    uint8_t got = 0;
+    uint8_t want = 0;
+    bool ret = true;
+
+    if (!gpio_jtag_flush(svf->jtag))
+    {
+        ret = gpio_svf_error(svf, "jtag io error");
+    }
+
+    for (uint8_t i = 0; i < svf->check_num; i++)
+    {
+        check = &svf->checks[i];
+        for (uint32_t j = 0; (ret) && (j < check->bits); j++)
+        {
+            if (!(check->mask[j / 8] & (1U << (j % 8))))
+            {
+                continue;
+            }
+
+            pos = check->offset + j;
+            got = (check->captured[pos / 8] >> (pos % 8)) & 1;
+            want = (check->expected[j / 8] >> (j % 8)) & 1;
+            if (got != want)
+            {
+                svf->line = check->line;
+                ret = gpio_svf_error(svf, "tdo mismatch");
+            }
+        }
+
+        svf->result->checks++;
+        free(check->captured);
+        free(check->expected);
+        free(check->mask);
+    }
+
+    svf->check_num = 0;
+
+    return ret;
+}
+
+/**
+ * @brief  执行SIR/SDR: header、数据、trailer合并为一次移位, 指定了TDO时加入待校验列表
+ * @param  svf: 输入参数, 播放状态
+ * @param  ir : 输入参数, true: SIR, false: SDR
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_svf_scan(gpio_svf_t *svf, const bool ir)
+{
+    gpio_svf_xxr_t *data = &svf->xxr[ir ? E_GPIO_SVF_SIR : E_GPIO_SVF_SDR];
+    gpio_svf_xxr_t *header = &svf->xxr[ir ? E_GPIO_SVF_HIR : E_GPIO_SVF_HDR];
+    gpio_svf_xxr_t *trailer = &svf->xxr[ir ? E_GPIO_SVF_TIR : E_GPIO_SVF_TDR];
+    gpio_svf_check_t *check = NULL;
+    uint32_t bits = header->len + data->len + trailer->len;
+    uint32_t size = (bits + 7) / 8;
+    uint8_t *tdi = NULL;
+    bool ret = false;
+
+    if (0 == bits)
+    {
+        return true;
+    }
+
+    if ((data->check) && (svf->check_num >= GPIO_JTAG_MAX_CAPTURES) && (!gpio_svf_flush(svf)))
+    {
+        return false;
+    }
+
+    tdi = calloc(1, size);
+    if (!tdi)
+    {
+        return gpio_svf_error(svf, "out of memory");
+    }
+
+    // 先移出的header在低位, trailer在高位
+    gpio_svf_copy_bits(tdi, 0, header->tdi, header->len);
+    gpio_svf_copy_bits(tdi, header->len, data->tdi, data->len);
+    gpio_svf_copy_bits(tdi, header->len + data->len, trailer->tdi, trailer->len);
+
+    if (data->check)
+    {
+        check = &svf->checks[svf->check_num];
+        check->captured = calloc(1, size);
+        check->expected = malloc((data->len + 7) / 8);
+        check->mask = malloc((data->len + 7) / 8);
+        if ((!check->captured) || (!check->expected) || (!check->mask))
+        {
+            free(check->captured);
+            free(check->expected);
+            free(check->mask);
+            free(tdi);
+
+            return gpio_svf_error(svf, "out of memory");
+        }
+
+        memcpy(check->expected, data->tdo, (data->len + 7) / 8);
+        memcpy(check->mask, data->mask, (data->len + 7) / 8);
+        check->offset = header->len;
+        check->bits = data->len;
+        check->line = svf->line;
+        svf->check_num++;
+    }
+
+    ret = gpio_jtag_shift(svf->jtag, check ? check->captured : NULL, tdi, bits, ir, ir ? svf->endir : svf->enddr);
+    free(tdi);
+    svf->result->shifts++;
+    if (!ret)
+    {
+        return gpio_svf_error(svf, "jtag shift failed");
+    }
+
+    return true;
+}
+
+/**
+ * @brief  解析SIR/SDR/HIR/HDR/TIR/TDR的参数
+ * @param  svf   : 输入参数, 播放状态
+ * @param  xxr   : 输入参数, 移位参数
+ * @param  save  : 输入参数, strtok_r的上下文
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_svf_parse_xxr(gpio_svf_t *svf, gpio_svf_xxr_t *xxr, char **save)
+{
+    char *token = strtok_r(NULL, " ", save);
+    char *value = NULL;
+    char *end = NULL;
+    unsigned long len = 0;
+    bool has_tdi = false;
+    bool has_mask = false;
+
+    if (!token)
+    {
+        return gpio_svf_error(svf, "missing length");
+    }
+
+    len = strtoul(token, &end, 10);
+    if (('\0' != *end) || (len > UINT32_MAX))
+    {
+        return gpio_svf_error(svf, "invalid length");
+    }
+
+    xxr->check = false;
+    while (NULL != (token = strtok_r(NULL, " ", save)))
+    {
+        value = strtok_r(NULL, " ", save);
+        if (!value)
+        {
+            return gpio_svf_error(svf, "missing value");
+        }
+
+        if (0 == strcasecmp(token, "TDI"))
+        {
+            has_tdi = gpio_svf_parse_hex(&xxr->tdi, (uint32_t)len, value);
+            if (!has_tdi)
+            {
+                return gpio_svf_error(svf, "invalid TDI");
+            }
+        }
+        else if (0 == strcasecmp(token, "TDO"))
+        {
+            xxr->check = gpio_svf_parse_hex(&xxr->tdo, (uint32_t)len, value);
+            if (!xxr->check)
+            {
+                return gpio_svf_error(svf, "invalid TDO");
+            }
+        }
+        else if (0 == strcasecmp(token, "MASK"))
+        {
+            has_mask = gpio_svf_parse_hex(&xxr->mask, (uint32_t)len, value);
+            if (!has_mask)
+            {
+                return gpio_svf_error(svf, "invalid MASK");
+            }
+        }
+        else if (0 != strcasecmp(token, "SMASK"))
+        {
+            return gpio_svf_error(svf, "unknown scan parameter");
+        }
+    }
+
+    // 位数变化时必须重新指定TDI, MASK恢复为全部校验
+    if ((uint32_t)len != xxr->len)
+    {
+        if ((!has_tdi) && (0 != len))
+        {
+            return gpio_svf_error(svf, "TDI required");
+        }
+
+        if (!has_mask)
+        {
+            if (!gpio_svf_parse_hex(&xxr->mask, (uint32_t)len, "(0)"))
+            {
+                return gpio_svf_error(svf, "out of memory");
+            }
+
+            memset(xxr->mask, 0xFF, (len + 7) / 8);
+        }
+    }
+
+    xxr->len = (uint32_t)len;
+
+    return true;
+}
+
+/**
+ * @brief  执行RUNTEST
+ * @param  svf : 输入参数, 播放状态
+ * @param  save: 输入参数, strtok_r的上下文
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_svf_runtest(gpio_svf_t *svf, char **save)
+{
+    char *token = NULL;
+    char *unit = NULL;
+    char *end = NULL;
+    double number = 0;
+    uint32_t clocks = 0;
+    double min_time = 0;
+    bool end_given = false;
+    struct timespec ts = {0};
+
+    while (NULL != (token = strtok_r(NULL, " ", save)))
+    {
+        if (gpio_svf_parse_state(&svf->run_state, token))
+        {
+            continue;
+        }
+
+        if (0 == strcasecmp(token, "ENDSTATE"))
+        {
+            token = strtok_r(NULL, " ", save);
+            if ((!token) || (!gpio_svf_parse_state(&svf->end_state, token)))
+            {
+                return gpio_svf_error(svf, "invalid ENDSTATE");
+            }
+
+            end_given = true;
+
+            continue;
+        }
+
+        // 最长时间只校验格式, 等待时间以最短时间为准
+        if (0 == strcasecmp(token, "MAXIMUM"))
+        {
+            token = strtok_r(NULL, " ", save);
+            unit = strtok_r(NULL, " ", save);
+            if ((!token) || (strtod(token, &end) < 0) || (end == token) || ('\0' != *end) || (!unit) ||
+                (0 != strcasecmp(unit, "SEC")))
+            {
+                return gpio_svf_error(svf, "invalid RUNTEST MAXIMUM");
+            }
+
+            continue;
+        }
+
+        number = strtod(token, &end);
+        if ((end == token) || ('\0' != *end) || (number < 0))
+        {
+            return gpio_svf_error(svf, "invalid RUNTEST");
+        }
+
+        unit = strtok_r(NULL, " ", save);
+        if ((unit) && ((0 == strcasecmp(unit, "TCK")) || (0 == strcasecmp(unit, "SCK"))))
+        {
+            clocks = (uint32_t)number;
+        }
+        else if ((unit) && (0 == strcasecmp(unit, "SEC")))
+        {
+            min_time = number;
+        }
+        else
+        {
+            return gpio_svf_error(svf, "invalid RUNTEST");
+        }
+    }
+
+    if (!end_given)
+    {
+        svf->end_state = svf->run_state;
+    }
+
+    if ((!gpio_jtag_goto_state(svf->jtag, svf->run_state)) || (!gpio_jtag_clocks(svf->jtag, clocks)))
+    {
+        return gpio_svf_error(svf, "jtag io error");
+    }
+
+    // 需要等待时间时先执行已编译的波形, 再在run_state中等待
+    if (min_time > 0)
+    {
+        if (!gpio_svf_flush(svf))
+        {
+            return false;
+        }
+
+        ts.tv_sec = (time_t)min_time;
+        ts.tv_nsec = (long)((min_time - (double)ts.tv_sec) * 1e9);
+        while ((-1 == nanosleep(&ts, &ts)) && (EINTR == errno))
+        {
+        }
+    }
+
+    if (!gpio_jtag_goto_state(svf->jtag, svf->end_state))
+    {
+        return gpio_svf_error(svf, "jtag io error");
+    }
+
+    return true;
+}
+
+/**
+ * @brief  执行一条语句
+ * @param  svf      : 输入参数, 播放状态
+ * @param  statement: 输入参数, 语句
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_svf_execute(gpio_svf_t *svf, char *statement)
+{
+    char *save = NULL;
+    char *command = strtok_r(statement, " ", &save);
+    char *token = NULL;
+    gpio_jtag_state_e state = E_GPIO_JTAG_RESET;
+    double hz = 0;
+
+    if (!command)
+    {
+        return true;
+    }
+
+    svf->result->statements++;
+    if ((0 == strcasecmp(command, "SIR")) || (0 == strcasecmp(command, "SDR")))
+    {
+        if (!gpio_svf_parse_xxr(svf, &svf->xxr[('I' == toupper((unsigned char)command[1])) ? E_GPIO_SVF_SIR
+                                                                                          : E_GPIO_SVF_SDR],
+                                &save))
+        {
+            return false;
+        }
+
+        return gpio_svf_scan(svf, ('I' == toupper((unsigned char)command[1])));
+    }
+
+    if ((0 == strcasecmp(command, "HIR")) || (0 == strcasecmp(command, "HDR")) ||
+        (0 == strcasecmp(command, "TIR")) || (0 == strcasecmp(command, "TDR")))
+    {
+        // header/trailer只用于补齐菊花链中其他器件的位, 不校验TDO
+        return gpio_svf_parse_xxr(svf,
+                                  &svf->xxr[(('H' == toupper((unsigned char)command[0])) ? E_GPIO_SVF_HIR
+                                                                                        : E_GPIO_SVF_TIR) +
+                                            (('D' == toupper((unsigned char)command[1])) ? 1 : 0)],
+                                  &save);
+    }
+
+    if ((0 == strcasecmp(command, "ENDIR")) || (0 == strcasecmp(command, "ENDDR")))
+    {
+        token = strtok_r(NULL, " ", &save);
+        if ((!token) || (!gpio_svf_parse_state(&state, token)))
+        {
+            return gpio_svf_error(svf, "invalid end state");
+        }
+
+        if ('I' == toupper((unsigned char)command[3]))
+        {
+            svf->endir = state;
+        }
+        else
+        {
+            svf->enddr = state;
+        }
+
+        return true;
+    }
+
+    if (0 == strcasecmp(command, "STATE"))
+    {
+        while (NULL != (token = strtok_r(NULL, " ", &save)))
+        {
+            if (!gpio_svf_parse_state(&state, token))
+            {
+                return gpio_svf_error(svf, "invalid state");
+            }
+
+            if (!((E_GPIO_JTAG_RESET == state) ? gpio_jtag_reset(svf->jtag)
+                                               : gpio_jtag_goto_state(svf->jtag, state)))
+            {
+                return gpio_svf_error(svf, "jtag io error");
+            }
+        }
+
+        return true;
+    }
+
+    if (0 == strcasecmp(command, "RUNTEST"))
+    {
+        return gpio_svf_runtest(svf, &save);
+    }
+
+    if (0 == strcasecmp(command, "FREQUENCY"))
+    {
+        // 先以原来的频率执行已编译的波形
+        if (!gpio_svf_flush(svf))
+        {
+            return false;
+        }
+
+        token = strtok_r(NULL, " ", &save);
+        hz = token ? strtod(token, NULL) : 0;
+        svf->jtag->config.half_period_ns = (hz > 0) ? (uint64_t)(500000000.0 / hz + 0.5) : 0;
+
+        return true;
+    }
+
+    // 没有TRST引脚
+    if (0 == strcasecmp(command, "TRST"))
+    {
+        return true;
+    }
+
+    return gpio_svf_error(svf, "unsupported command");
+}
+
+/**
+ * @brief  播放SVF文件
+ * @note   移位语句编译到JTAG引擎的波形缓冲区, 缓冲区满、TDO校验个数满或RUNTEST需要等待时间时才执行;
+ *         支持SIR/SDR/HIR/HDR/TIR/TDR/ENDIR/ENDDR/STATE/RUNTEST/FREQUENCY, TRST被忽略, 不支持PIO/PIOMAP
+ * @param  result: 输出参数, 播放结果
+ * @param  jtag  : 输入参数, 已初始化的JTAG引擎
+ * @param  path  : 输入参数, SVF文件路径
+ * @return true : 成功(全部TDO校验通过)
+ * @return false: 失败(result中为出错行号和原因)
+ */
+bool gpio_svf_play(gpio_svf_result_t *result, gpio_jtag_t *jtag, const char *path)
+{
+    gpio_svf_t svf = {0};
+    FILE *fp = NULL;
+    char *buf = NULL;
+    size_t size = 256;
+    bool ret = true;
+
+    if ((!result) || (!jtag) || (!path))
+    {
+        return false;
+    }
+
+    memset(result, 0, sizeof(gpio_svf_result_t));
+    svf.jtag = jtag;
+    svf.result = result;
+    svf.endir = E_GPIO_JTAG_IDLE;
+    svf.enddr = E_GPIO_JTAG_IDLE;
+    svf.run_state = E_GPIO_JTAG_IDLE;
+    svf.end_state = E_GPIO_JTAG_IDLE;
+    svf.line = 1;
+
+    fp = fopen(path, "r");
+    if (!fp)
+    {
+        snprintf(result->error, sizeof(result->error), "open failed");
+
+        return false;
+    }
+
+    buf = malloc(size);
+    if (!buf)
+    {
+        fclose(fp);
+
+        return false;
+    }
+
+    while ((ret) && (gpio_svf_read_statement(&buf, &size, &svf, fp)))
+    {
+        ret = gpio_svf_execute(&svf, buf);
+    }
+
+    // 执行剩余的波形并校验
+    if (!gpio_svf_flush(&svf))
+    {
+        ret = false;
+    }
+
+    for (uint8_t i = 0; i < E_GPIO_SVF_XXR_NUM; i++)
+    {
+        free(svf.xxr[i].tdi);
+        free(svf.xxr[i].tdo);
+        free(svf.xxr[i].mask);
+    }
+
+    free(buf);
+    fclose(fp);
+
+    return ret;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file      : gpio_svf.h
+ * @brief     : SVF(Serial Vector Format)文件播放头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 19:02:27
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_SVF_H
+#define __GPIO_SVF_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_jtag.h"
+
+// SVF播放结果
+typedef struct
+{
+    // 已执行的语句个数
+    uint32_t statements;
+    // 已执行的移位个数(SIR/SDR)
+    uint32_t shifts;
+    // 已校验的TDO个数
+    uint32_t checks;
+    // 出错语句所在行号, 0表示没有出错
+    uint32_t error_line;
+    // 出错原因
+    char error[64];
+} gpio_svf_result_t;
+
+/**
+ * @brief  播放SVF文件
+ * @note   移位语句编译到JTAG引擎的波形缓冲区, 缓冲区满、TDO校验个数满或RUNTEST需要等待时间时才执行;
+ *         支持SIR/SDR/HIR/HDR/TIR/TDR/ENDIR/ENDDR/STATE/RUNTEST/FREQUENCY, TRST被忽略, 不支持PIO/PIOMAP
+ * @param  result: 输出参数, 播放结果
+ * @param  jtag  : 输入参数, 已初始化的JTAG引擎
+ * @param  path  : 输入参数, SVF文件路径
+ * @return true : 成功(全部TDO校验通过)
+ * @return false: 失败(result中为出错行号和原因)
+ */
+bool gpio_svf_play(gpio_svf_result_t *result, gpio_jtag_t *jtag, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_SVF_H
@@ -0,0 +1,722 @@
+/**
+ * @file      : gpio_swd.c
+ * @brief     : GPIO模拟SWD(Serial Wire Debug)源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 19:48:16
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_swd.h"
+
+// JTAG切换到SWD的序列(LSB优先)
+#define GPIO_SWD_JTAG_TO_SWD 0xE79E
+
+// CTRL/STAT: 调试域和系统域上电请求/应答
+#define GPIO_SWD_CTRL_PWRUP_REQ 0x50000000
+#define GPIO_SWD_CTRL_PWRUP_ACK 0xA0000000
+
+// CTRL/STAT: 溢出检测和粘滞错误
+#define GPIO_SWD_CTRL_ORUNDETECT 0x00000001
+#define GPIO_SWD_CTRL_STICKYORUN 0x00000002
+#define GPIO_SWD_CTRL_STICKYERR 0x00000020
+
+// ABORT: 清除全部粘滞错误
+#define GPIO_SWD_ABORT_CLEAR 0x0000001E
+
+// MEM-AP CSW: 32位访问, TAR单步递增, 调试访问
+#define GPIO_SWD_CSW_32BIT_INC 0x23000012
+
+// TAR自动递增只保证在1KB范围内
+#define GPIO_SWD_TAR_WRAP 1024
+
+/**
+ * @brief  计算32位数据的奇偶校验位
+ * @param  value: 输入参数, 数据
+ * @return 1的个数为奇数时为1
+ */
+static uint32_t gpio_swd_parity(uint32_t value)
+{
+    value ^= value >> 16;
+    value ^= value >> 8;
+    value ^= value >> 4;
+    value ^= value >> 2;
+    value ^= value >> 1;
+
+    return value & 1;
+}
+
+/**
+ * @brief  切换SWDIO方向
+ * @param  swd   : 输入参数, SWD引擎
+ * @param  output: 输入参数, true: 主机驱动, false: 目标驱动
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_set_output(gpio_swd_t *swd, const bool output)
+{
+    if (output == swd->output)
+    {
+        return true;
+    }
+
+    if (!gpio_group_set_direction(swd->config.group, (1ULL << swd->config.swdio), output ? E_GPIO_OUT : E_GPIO_IN,
+                                  0))
+    {
+        return false;
+    }
+
+    swd->output = output;
+
+    return true;
+}
+
+/**
+ * @brief  主机输出若干位(LSB优先): SWCLK低电平时同时输出SWDIO(一次批量设置), 再输出SWCLK上升沿
+ * @param  swd : 输入参数, SWD引擎
+ * @param  data: 输入参数, 数据
+ * @param  bits: 输入参数, 位数(1~32)
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_write_bits(gpio_swd_t *swd, const uint32_t data, const uint8_t bits)
+{
+    uint64_t clk = 1ULL << swd->config.swclk;
+    uint64_t dio = 1ULL << swd->config.swdio;
+
+    if (!gpio_swd_set_output(swd, true))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < bits; i++)
+    {
+        if ((!gpio_group_set_values(swd->config.group, clk | dio, ((data >> i) & 1) ? dio : 0)) ||
+            (!gpio_group_set_values(swd->config.group, clk, clk)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  读取目标输出的若干位(LSB优先): SWCLK低电平时采样, 目标在上升沿后更新数据
+ * @param  data: 输出参数, 数据, 为NULL时只输出时钟不采样
+ * @param  swd : 输入参数, SWD引擎
+ * @param  bits: 输入参数, 位数(1~32)
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_read_bits(uint32_t *data, gpio_swd_t *swd, const uint8_t bits)
+{
+    uint64_t clk = 1ULL << swd->config.swclk;
+    uint64_t dio = 1ULL << swd->config.swdio;
+    uint64_t values = 0;
+    uint32_t result = 0;
+
+    if (!gpio_swd_set_output(swd, false))
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < bits; i++)
+    {
+        if (!gpio_group_set_values(swd->config.group, clk, 0))
+        {
+            return false;
+        }
+
+        if (data)
+        {
+            if (!gpio_group_get_values(&values, swd->config.group, dio))
+            {
+                return false;
+            }
+
+            if (values & dio)
+            {
+                result |= (1U << i);
+            }
+        }
+
+        if (!gpio_group_set_values(swd->config.group, clk, clk))
+        {
+            return false;
+        }
+    }
+
+    if (data)
+    {
+        *data = result;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  执行一次传输: 请求、转换、应答、(转换)、数据和校验
+ * @param  value    : 输入输出参数, 写入时为数据, 读取时为结果
+ * @param  swd      : 输入参数, SWD引擎
+ * @param  ap       : 输入参数, true: AP, false: DP
+ * @param  read     : 输入参数, true: 读, false: 写
+ * @param  addr     : 输入参数, 寄存器地址(只使用A[3:2])
+ * @param  check_ack: 输入参数, 是否采样应答, 为false时假定应答OK(需启用溢出检测, 之后检查粘滞错误)
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_transfer(uint32_t *value, gpio_swd_t *swd, const bool ap, const bool read, const uint8_t addr,
+                              const bool check_ack)
+{
+    uint8_t turnaround = (0 == swd->config.turnaround) ? 1 : swd->config.turnaround;
+    uint32_t request = 0;
+    uint32_t ack = 0;
+    uint32_t data = 0;
+    uint32_t parity = 0;
+
+    request = (ap ? 1U : 0U) | (read ? 2U : 0U) | ((uint32_t)addr & 0xC);
+    request = 0x81 | (request << 1) | (gpio_swd_parity(request) << 5);
+
+    for (uint32_t retry = 0; retry <= swd->config.retries; retry++)
+    {
+        swd->stats.transfers++;
+        if ((!gpio_swd_write_bits(swd, request, 8)) || (!gpio_swd_read_bits(NULL, swd, turnaround)) ||
+            (!gpio_swd_read_bits(check_ack ? &ack : NULL, swd, 3)))
+        {
+            return false;
+        }
+
+        if (!check_ack)
+        {
+            ack = GPIO_SWD_ACK_OK;
+        }
+
+        swd->ack = (uint8_t)ack;
+
+        // 应答OK或启用了溢出检测时有数据阶段
+        if ((GPIO_SWD_ACK_OK == ack) || (swd->overrun))
+        {
+            if (read)
+            {
+                if ((!gpio_swd_read_bits(&data, swd, 32)) || (!gpio_swd_read_bits(&parity, swd, 1)) ||
+                    (!gpio_swd_read_bits(NULL, swd, turnaround)))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                data = (GPIO_SWD_ACK_OK == ack) ? *value : 0;
+                if ((!gpio_swd_read_bits(NULL, swd, turnaround)) || (!gpio_swd_write_bits(swd, data, 32)) ||
+                    (!gpio_swd_write_bits(swd, gpio_swd_parity(data), 1)))
+                {
+                    return false;
+                }
+            }
+        }
+        else if (!gpio_swd_read_bits(NULL, swd, turnaround))
+        {
+            return false;
+        }
+
+        if (!gpio_swd_set_output(swd, true))
+        {
+            return false;
+        }
+
+        if (GPIO_SWD_ACK_OK == ack)
+        {
+            if ((read) && (parity != gpio_swd_parity(data)))
+            {
+                swd->stats.faults++;
+
+                return false;
+            }
+
+            if (read)
+            {
+                *value = data;
+            }
+
+            return true;
+        }
+
+        if (GPIO_SWD_ACK_WAIT != ack)
+        {
+            swd->stats.faults++;
+
+            return false;
+        }
+
+        swd->stats.waits++;
+    }
+
+    return false;
+}
+
+/**
+ * @brief  输出空闲时钟(SWDIO低电平)
+ * @param  swd   : 输入参数, SWD引擎
+ * @param  cycles: 输入参数, 时钟个数(1~32)
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_idle(gpio_swd_t *swd, const uint8_t cycles)
+{
+    return gpio_swd_write_bits(swd, 0, cycles);
+}
+
+/**
+ * @brief  按需写DP SELECT
+ * @param  swd   : 输入参数, SWD引擎
+ * @param  select: 输入参数, SELECT值
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_select(gpio_swd_t *swd, const uint32_t select)
+{
+    if ((swd->select_valid) && (select == swd->select))
+    {
+        return true;
+    }
+
+    if (!gpio_swd_dp_write(swd, GPIO_SWD_DP_SELECT, select))
+    {
+        swd->select_valid = false;
+
+        return false;
+    }
+
+    swd->select = select;
+    swd->select_valid = true;
+
+    return true;
+}
+
+/**
+ * @brief  按需写MEM-AP CSW
+ * @param  swd: 输入参数, SWD引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_setup_csw(gpio_swd_t *swd)
+{
+    if ((swd->csw_valid) && (GPIO_SWD_CSW_32BIT_INC == swd->csw))
+    {
+        return true;
+    }
+
+    if (!gpio_swd_ap_write(swd, 0, GPIO_SWD_AP_CSW, GPIO_SWD_CSW_32BIT_INC))
+    {
+        swd->csw_valid = false;
+
+        return false;
+    }
+
+    swd->csw = GPIO_SWD_CSW_32BIT_INC;
+    swd->csw_valid = true;
+
+    return true;
+}
+
+/**
+ * @brief  初始化SWD引擎, SWCLK输出低电平, SWDIO输出高电平
+ * @param  swd   : 输出参数, SWD引擎
+ * @param  config: 输入参数, SWD配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_init(gpio_swd_t *swd, const gpio_swd_config_t *config)
+{
+    uint64_t clk = 0;
+    uint64_t dio = 0;
+
+    if ((!swd) || (!config) || (!config->group) || (config->swclk >= config->group->num) ||
+        (config->swdio >= config->group->num) || (config->swclk == config->swdio) || (config->turnaround > 4))
+    {
+        return false;
+    }
+
+    memset(swd, 0, sizeof(gpio_swd_t));
+    swd->config = *config;
+    if (0 == swd->config.retries)
+    {
+        swd->config.retries = GPIO_SWD_DEFAULT_RETRIES;
+    }
+
+    clk = 1ULL << config->swclk;
+    dio = 1ULL << config->swdio;
+    if (!gpio_group_set_direction(config->group, clk | dio, E_GPIO_OUT, dio))
+    {
+        return false;
+    }
+
+    swd->output = true;
+
+    return gpio_group_set_values(config->group, clk | dio, dio);
+}
+
+/**
+ * @brief  线复位: SWDIO高电平至少50个时钟, 再输出2个空闲时钟
+ * @param  swd: 输入参数, SWD引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_line_reset(gpio_swd_t *swd)
+{
+    if (!swd)
+    {
+        return false;
+    }
+
+    swd->select_valid = false;
+    swd->csw_valid = false;
+    swd->overrun = false;
+
+    return (gpio_swd_write_bits(swd, UINT32_MAX, 32) && gpio_swd_write_bits(swd, UINT32_MAX, 24) &&
+            gpio_swd_idle(swd, 2));
+}
+
+/**
+ * @brief  连接目标: JTAG切换到SWD序列、线复位、读取DPIDR、清除错误并上电调试域
+ * @param  idcode: 输出参数, DPIDR
+ * @param  swd   : 输入参数, SWD引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_connect(uint32_t *idcode, gpio_swd_t *swd)
+{
+    uint32_t ctrl = 0;
+
+    if ((!idcode) || (!swd))
+    {
+        return false;
+    }
+
+    if ((!gpio_swd_write_bits(swd, UINT32_MAX, 32)) || (!gpio_swd_write_bits(swd, UINT32_MAX, 24)) ||
+        (!gpio_swd_write_bits(swd, GPIO_SWD_JTAG_TO_SWD, 16)) || (!gpio_swd_line_reset(swd)))
+    {
+        return false;
+    }
+
+    // 线复位后第一个传输必须是读DPIDR
+    if ((!gpio_swd_dp_read(idcode, swd, GPIO_SWD_DP_DPIDR)) ||
+        (!gpio_swd_dp_write(swd, GPIO_SWD_DP_ABORT, GPIO_SWD_ABORT_CLEAR)) ||
+        (!gpio_swd_dp_write(swd, GPIO_SWD_DP_CTRL_STAT, GPIO_SWD_CTRL_PWRUP_REQ)))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i <= swd->config.retries; i++)
+    {
+        if (!gpio_swd_dp_read(&ctrl, swd, GPIO_SWD_DP_CTRL_STAT))
+        {
+            return false;
+        }
+
+        if (GPIO_SWD_CTRL_PWRUP_ACK == (ctrl & GPIO_SWD_CTRL_PWRUP_ACK))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief  读DP寄存器
+ * @param  value: 输出参数, 寄存器值
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 寄存器地址(0x0/0x4/0x8/0xC)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_dp_read(uint32_t *value, gpio_swd_t *swd, const uint8_t addr)
+{
+    if ((!value) || (!swd))
+    {
+        return false;
+    }
+
+    return gpio_swd_transfer(value, swd, false, true, addr, true);
+}
+
+/**
+ * @brief  写DP寄存器
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 寄存器地址(0x0/0x4/0x8/0xC)
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_dp_write(gpio_swd_t *swd, const uint8_t addr, const uint32_t value)
+{
+    uint32_t data = value;
+
+    if (!swd)
+    {
+        return false;
+    }
+
+    return gpio_swd_transfer(&data, swd, false, false, addr, true);
+}
+
+/**
+ * @brief  读AP寄存器(AP读取是延迟的, 内部再读RDBUFF获取结果)
+ * @param  value: 输出参数, 寄存器值
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  ap   : 输入参数, AP序号
+ * @param  addr : 输入参数, 寄存器地址
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_ap_read(uint32_t *value, gpio_swd_t *swd, const uint8_t ap, const uint8_t addr)
+{
+    uint32_t dummy = 0;
+
+    if ((!value) || (!swd))
+    {
+        return false;
+    }
+
+    if ((!gpio_swd_select(swd, ((uint32_t)ap << 24) | (addr & 0xF0))) ||
+        (!gpio_swd_transfer(&dummy, swd, true, true, addr, true)))
+    {
+        return false;
+    }
+
+    return gpio_swd_dp_read(value, swd, GPIO_SWD_DP_RDBUFF);
+}
+
+/**
+ * @brief  写AP寄存器
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  ap   : 输入参数, AP序号
+ * @param  addr : 输入参数, 寄存器地址
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_ap_write(gpio_swd_t *swd, const uint8_t ap, const uint8_t addr, const uint32_t value)
+{
+    uint32_t data = value;
+
+    if (!swd)
+    {
+        return false;
+    }
+
+    if (!gpio_swd_select(swd, ((uint32_t)ap << 24) | (addr & 0xF0)))
+    {
+        return false;
+    }
+
+    return gpio_swd_transfer(&data, swd, true, false, addr, true);
+}
+
+/**
+ * @brief  通过MEM-AP(AP 0)读一个32位字
+ * @param  value: 输出参数, 读取的值
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 目标地址(4字节对齐)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_read32(uint32_t *value, gpio_swd_t *swd, const uint32_t addr)
+{
+    return gpio_swd_mem_read_block(value, swd, addr, 1);
+}
+
+/**
+ * @brief  通过MEM-AP(AP 0)写一个32位字
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 目标地址(4字节对齐)
+ * @param  value: 输入参数, 写入的值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_write32(gpio_swd_t *swd, const uint32_t addr, const uint32_t value)
+{
+    if (!swd)
+    {
+        return false;
+    }
+
+    return (gpio_swd_setup_csw(swd) && gpio_swd_ap_write(swd, 0, GPIO_SWD_AP_TAR, addr) &&
+            gpio_swd_ap_write(swd, 0, GPIO_SWD_AP_DRW, value) && gpio_swd_idle(swd, 8));
+}
+
+/**
+ * @brief  通过MEM-AP(AP 0)连续读取, TAR自动递增, AP读取流水线化
+ * @param  data : 输出参数, 读取的数据
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 起始地址(4字节对齐)
+ * @param  count: 输入参数, 字数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_read_block(uint32_t *data, gpio_swd_t *swd, const uint32_t addr, const uint32_t count)
+{
+    uint32_t done = 0;
+    uint32_t chunk = 0;
+    uint32_t cur = 0;
+    uint32_t value = 0;
+
+    if ((!data) || (!swd) || (0 != (addr & 3)))
+    {
+        return false;
+    }
+
+    if (!gpio_swd_setup_csw(swd))
+    {
+        return false;
+    }
+
+    while (done < count)
+    {
+        cur = addr + done * 4;
+        chunk = (GPIO_SWD_TAR_WRAP - (cur % GPIO_SWD_TAR_WRAP)) / 4;
+        if (chunk > count - done)
+        {
+            chunk = count - done;
+        }
+
+        if (!gpio_swd_ap_write(swd, 0, GPIO_SWD_AP_TAR, cur))
+        {
+            return false;
+        }
+
+        // 每次AP读取返回上一次的结果, 最后一个从RDBUFF读取
+        for (uint32_t i = 0; i <= chunk; i++)
+        {
+            if (i < chunk)
+            {
+                if (!gpio_swd_transfer(&value, swd, true, true, GPIO_SWD_AP_DRW, true))
+                {
+                    return false;
+                }
+            }
+            else if (!gpio_swd_dp_read(&value, swd, GPIO_SWD_DP_RDBUFF))
+            {
+                return false;
+            }
+
+            if (i > 0)
+            {
+                data[done + i - 1] = value;
+            }
+        }
+
+        done += chunk;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  写入一段(不跨1KB边界)数据
+ * @param  swd      : 输入参数, SWD引擎
+ * @param  addr     : 输入参数, 起始地址
+ * @param  data     : 输入参数, 数据
+ * @param  count    : 输入参数, 字数
+ * @param  check_ack: 输入参数, 是否逐个采样应答
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_swd_write_chunk(gpio_swd_t *swd, const uint32_t addr, const uint32_t *data, const uint32_t count,
+                                 const bool check_ack)
+{
+    uint32_t value = 0;
+
+    if (!gpio_swd_ap_write(swd, 0, GPIO_SWD_AP_TAR, addr))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        value = data[i];
+        if (!gpio_swd_transfer(&value, swd, true, false, GPIO_SWD_AP_DRW, check_ack))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  通过MEM-AP(AP 0)批量写入, TAR自动递增
+ * @note   启用溢出检测后每个字不读取应答(只输出时钟), 每1KB结束时读一次CTRL/STAT检查粘滞错误;
+ *         出错时清除错误并对该段逐个校验应答重写
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 起始地址(4字节对齐)
+ * @param  data : 输入参数, 写入的数据
+ * @param  count: 输入参数, 字数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_write_block(gpio_swd_t *swd, const uint32_t addr, const uint32_t *data, const uint32_t count)
+{
+    uint32_t done = 0;
+    uint32_t chunk = 0;
+    uint32_t cur = 0;
+    uint32_t ctrl = 0;
+    bool ret = true;
+
+    if ((!swd) || (!data) || (0 != (addr & 3)))
+    {
+        return false;
+    }
+
+    if ((!gpio_swd_setup_csw(swd)) ||
+        (!gpio_swd_dp_write(swd, GPIO_SWD_DP_CTRL_STAT, GPIO_SWD_CTRL_PWRUP_REQ | GPIO_SWD_CTRL_ORUNDETECT)))
+    {
+        return false;
+    }
+
+    swd->overrun = true;
+    while ((ret) && (done < count))
+    {
+        cur = addr + done * 4;
+        chunk = (GPIO_SWD_TAR_WRAP - (cur % GPIO_SWD_TAR_WRAP)) / 4;
+        if (chunk > count - done)
+        {
+            chunk = count - done;
+        }
+
+        // 不采样应答, 每个字只剩时钟和输出; 段结束时检查粘滞错误
+        ret = gpio_swd_write_chunk(swd, cur, &data[done], chunk, false) &&
+              gpio_swd_dp_read(&ctrl, swd, GPIO_SWD_DP_CTRL_STAT);
+        if ((!ret) || (ctrl & (GPIO_SWD_CTRL_STICKYORUN | GPIO_SWD_CTRL_STICKYERR)))
+        {
+            // 清除错误, 关闭溢出检测后逐个校验应答重写本段
+            swd->stats.fallbacks++;
+            swd->overrun = false;
+            ret = gpio_swd_dp_write(swd, GPIO_SWD_DP_ABORT, GPIO_SWD_ABORT_CLEAR) &&
+                  gpio_swd_dp_write(swd, GPIO_SWD_DP_CTRL_STAT, GPIO_SWD_CTRL_PWRUP_REQ) &&
+                  gpio_swd_write_chunk(swd, cur, &data[done], chunk, true) &&
+                  gpio_swd_dp_write(swd, GPIO_SWD_DP_CTRL_STAT,
+                                    GPIO_SWD_CTRL_PWRUP_REQ | GPIO_SWD_CTRL_ORUNDETECT);
+            swd->overrun = ret;
+        }
+
+        done += chunk;
+    }
+
+    // 关闭溢出检测
+    swd->overrun = false;
+    if (!gpio_swd_dp_write(swd, GPIO_SWD_DP_CTRL_STAT, GPIO_SWD_CTRL_PWRUP_REQ))
+    {
+        return false;
+    }
+
+    return (ret && gpio_swd_idle(swd, 8));
+}
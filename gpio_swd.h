@@ -0,0 +1,210 @@
+/**
+ * @file      : gpio_swd.h
+ * @brief     : GPIO模拟SWD(Serial Wire Debug)头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 19:48:16
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_SWD_H
+#define __GPIO_SWD_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+
+// SWD应答
+#define GPIO_SWD_ACK_OK 0x1
+#define GPIO_SWD_ACK_WAIT 0x2
+#define GPIO_SWD_ACK_FAULT 0x4
+
+// DP寄存器地址
+#define GPIO_SWD_DP_DPIDR 0x0
+#define GPIO_SWD_DP_ABORT 0x0
+#define GPIO_SWD_DP_CTRL_STAT 0x4
+#define GPIO_SWD_DP_SELECT 0x8
+#define GPIO_SWD_DP_RDBUFF 0xC
+
+// MEM-AP寄存器地址
+#define GPIO_SWD_AP_CSW 0x00
+#define GPIO_SWD_AP_TAR 0x04
+#define GPIO_SWD_AP_DRW 0x0C
+#define GPIO_SWD_AP_IDR 0xFC
+
+// WAIT应答默认重试次数
+#define GPIO_SWD_DEFAULT_RETRIES 100
+
+// SWD配置
+typedef struct
+{
+    // GPIO组(SWCLK和SWDIO, 打开为输出, SWDIO在读取时切换为输入)
+    gpio_group_t *group;
+    // SWCLK/SWDIO在GPIO组内的序号
+    uint8_t swclk;
+    uint8_t swdio;
+    // 转换周期(1~4个时钟), 0表示1
+    uint8_t turnaround;
+    // WAIT应答重试次数, 0表示使用GPIO_SWD_DEFAULT_RETRIES
+    uint32_t retries;
+} gpio_swd_config_t;
+
+// SWD统计
+typedef struct
+{
+    // 传输次数
+    uint64_t transfers;
+    // WAIT应答次数
+    uint64_t waits;
+    // FAULT应答和校验错误次数
+    uint64_t faults;
+    // 批量写入回退为逐个校验应答的次数
+    uint64_t fallbacks;
+} gpio_swd_stats_t;
+
+// SWD引擎
+typedef struct
+{
+    gpio_swd_config_t config;
+    // SWDIO当前由主机驱动
+    bool output;
+    // 已启用溢出检测(ORUNDETECT), 此时WAIT/FAULT应答后仍有数据阶段
+    bool overrun;
+    // DP SELECT寄存器缓存, 相同时不再写入
+    uint32_t select;
+    bool select_valid;
+    // MEM-AP CSW寄存器缓存
+    uint32_t csw;
+    bool csw_valid;
+    // 最近一次应答
+    uint8_t ack;
+    gpio_swd_stats_t stats;
+} gpio_swd_t;
+
+/**
+ * @brief  初始化SWD引擎, SWCLK输出低电平, SWDIO输出高电平
+ * @param  swd   : 输出参数, SWD引擎
+ * @param  config: 输入参数, SWD配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_init(gpio_swd_t *swd, const gpio_swd_config_t *config);
+
+/**
+ * @brief  连接目标: JTAG切换到SWD序列、线复位、读取DPIDR、清除错误并上电调试域
+ * @param  idcode: 输出参数, DPIDR
+ * @param  swd   : 输入参数, SWD引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_connect(uint32_t *idcode, gpio_swd_t *swd);
+
+/**
+ * @brief  线复位: SWDIO高电平至少50个时钟, 再输出2个空闲时钟
+ * @param  swd: 输入参数, SWD引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_line_reset(gpio_swd_t *swd);
+
+/**
+ * @brief  读DP寄存器
+ * @param  value: 输出参数, 寄存器值
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 寄存器地址(0x0/0x4/0x8/0xC)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_dp_read(uint32_t *value, gpio_swd_t *swd, const uint8_t addr);
+
+/**
+ * @brief  写DP寄存器
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 寄存器地址(0x0/0x4/0x8/0xC)
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_dp_write(gpio_swd_t *swd, const uint8_t addr, const uint32_t value);
+
+/**
+ * @brief  读AP寄存器(AP读取是延迟的, 内部再读RDBUFF获取结果)
+ * @param  value: 输出参数, 寄存器值
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  ap   : 输入参数, AP序号
+ * @param  addr : 输入参数, 寄存器地址
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_ap_read(uint32_t *value, gpio_swd_t *swd, const uint8_t ap, const uint8_t addr);
+
+/**
+ * @brief  写AP寄存器
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  ap   : 输入参数, AP序号
+ * @param  addr : 输入参数, 寄存器地址
+ * @param  value: 输入参数, 寄存器值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_ap_write(gpio_swd_t *swd, const uint8_t ap, const uint8_t addr, const uint32_t value);
+
+/**
+ * @brief  通过MEM-AP(AP 0)读一个32位字
+ * @param  value: 输出参数, 读取的值
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 目标地址(4字节对齐)
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_read32(uint32_t *value, gpio_swd_t *swd, const uint32_t addr);
+
+/**
+ * @brief  通过MEM-AP(AP 0)写一个32位字
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 目标地址(4字节对齐)
+ * @param  value: 输入参数, 写入的值
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_write32(gpio_swd_t *swd, const uint32_t addr, const uint32_t value);
+
+/**
+ * @brief  通过MEM-AP(AP 0)连续读取, TAR自动递增, AP读取流水线化
+ * @param  data : 输出参数, 读取的数据
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 起始地址(4字节对齐)
+ * @param  count: 输入参数, 字数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_read_block(uint32_t *data, gpio_swd_t *swd, const uint32_t addr, const uint32_t count);
+
+/**
+ * @brief  通过MEM-AP(AP 0)批量写入, TAR自动递增
+ * @note   启用溢出检测后每个字不读取应答(只输出时钟), 每1KB结束时读一次CTRL/STAT检查粘滞错误;
+ *         出错时清除错误并对该段逐个校验应答重写
+ * @param  swd  : 输入参数, SWD引擎
+ * @param  addr : 输入参数, 起始地址(4字节对齐)
+ * @param  data : 输入参数, 写入的数据
+ * @param  count: 输入参数, 字数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_swd_mem_write_block(gpio_swd_t *swd, const uint32_t addr, const uint32_t *data, const uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_SWD_H
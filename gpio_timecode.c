@@ -0,0 +1,526 @@
+/**
+ * @file      : gpio_timecode.c
+ * @brief     : DCF77/WWVB长波授时信号解码源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 14:02:16
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_timecode.h"
+
+// 1ms, 单位: ns
+#define GPIO_TIMECODE_MS 1000000ULL
+
+// 秒周期, 单位: ns
+#define GPIO_TIMECODE_SECOND_NS (1000 * GPIO_TIMECODE_MS)
+
+// 相邻脉冲开始间隔允许偏离整秒的范围, 单位: ns
+#define GPIO_TIMECODE_JITTER_NS (100 * GPIO_TIMECODE_MS)
+
+// 短于该宽度的脉冲视为干扰, 单位: ns
+#define GPIO_TIMECODE_GLITCH_NS (40 * GPIO_TIMECODE_MS)
+
+// DCF77脉冲宽度: 0为100ms, 1为200ms, 以下为各符号的上限, 单位: ns
+#define GPIO_TIMECODE_DCF77_ZERO_NS (140 * GPIO_TIMECODE_MS)
+#define GPIO_TIMECODE_DCF77_ONE_NS (260 * GPIO_TIMECODE_MS)
+
+// WWVB脉冲宽度: 0为200ms, 1为500ms, 标记为800ms, 以下为各符号的上限, 单位: ns
+#define GPIO_TIMECODE_WWVB_ZERO_NS (350 * GPIO_TIMECODE_MS)
+#define GPIO_TIMECODE_WWVB_ONE_NS (650 * GPIO_TIMECODE_MS)
+#define GPIO_TIMECODE_WWVB_MARKER_NS (950 * GPIO_TIMECODE_MS)
+
+// 一帧的秒数
+#define GPIO_TIMECODE_FRAME_SECONDS 60
+
+// DCF77各字段的起始位
+#define GPIO_TIMECODE_DCF77_DST_ANNOUNCE 16
+#define GPIO_TIMECODE_DCF77_CEST 17
+#define GPIO_TIMECODE_DCF77_CET 18
+#define GPIO_TIMECODE_DCF77_LEAP 19
+#define GPIO_TIMECODE_DCF77_START 20
+#define GPIO_TIMECODE_DCF77_MINUTE 21
+#define GPIO_TIMECODE_DCF77_HOUR 29
+#define GPIO_TIMECODE_DCF77_DAY 36
+#define GPIO_TIMECODE_DCF77_WEEKDAY 42
+#define GPIO_TIMECODE_DCF77_MONTH 45
+#define GPIO_TIMECODE_DCF77_YEAR 50
+#define GPIO_TIMECODE_DCF77_PARITY_DATE 58
+
+// WWVB标记所在秒(0, 9, 19, ..., 59)
+#define GPIO_TIMECODE_WWVB_MARKERS 0x0802008020080201ULL
+
+// WWVB固定为0的秒
+#define GPIO_TIMECODE_WWVB_ZEROS 0x0040100C01304C10ULL
+
+// 符号
+#define GPIO_TIMECODE_ZERO 0
+#define GPIO_TIMECODE_ONE 1
+#define GPIO_TIMECODE_MARKER 2
+#define GPIO_TIMECODE_INVALID 3
+
+// 各月之前的累计天数(平年)
+static const uint16_t gpio_timecode_month_days[13] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365};
+
+/**
+ * @brief  是否为闰年
+ * @param  year: 输入参数, 年
+ * @return true : 是
+ * @return false: 否
+ */
+static bool gpio_timecode_leap_year(const uint16_t year)
+{
+    return ((0 == year % 4) && (0 != year % 100)) || (0 == year % 400);
+}
+
+/**
+ * @brief  计算星期(1~7为周一~周日)
+ * @param  year : 输入参数, 年
+ * @param  month: 输入参数, 月
+ * @param  day  : 输入参数, 日
+ * @return 星期
+ */
+static uint8_t gpio_timecode_weekday(uint16_t year, const uint8_t month, const uint8_t day)
+{
+    static const uint8_t offsets[12] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+    uint8_t weekday = 0;
+
+    if (month < 3)
+    {
+        year--;
+    }
+
+    // 0为周日
+    weekday = (uint8_t)((year + year / 4 - year / 100 + year / 400 + offsets[month - 1] + day) % 7);
+
+    return (0 == weekday) ? 7 : weekday;
+}
+
+/**
+ * @brief  取帧中连续的若干位, 高位在前
+ * @param  bits : 输入参数, 帧数据位
+ * @param  first: 输入参数, 起始秒
+ * @param  num  : 输入参数, 位数
+ * @return 值
+ */
+static uint8_t gpio_timecode_msb(const uint64_t bits, const uint8_t first, const uint8_t num)
+{
+    uint8_t value = 0;
+
+    for (uint8_t i = 0; i < num; i++)
+    {
+        value = (uint8_t)((value << 1) | ((bits >> (first + i)) & 1));
+    }
+
+    return value;
+}
+
+/**
+ * @brief  取DCF77的BCD字段(低位在前, 权重1, 2, 4, 8, 10, 20, 40, 80)
+ * @param  bits : 输入参数, 帧数据位
+ * @param  first: 输入参数, 起始秒
+ * @param  num  : 输入参数, 位数
+ * @return 值, 个位超过9时为0xFF
+ */
+static uint8_t gpio_timecode_bcd(const uint64_t bits, const uint8_t first, const uint8_t num)
+{
+    uint8_t units = (uint8_t)((bits >> first) & ((num < 4) ? ((1U << num) - 1) : 0x0F));
+    uint8_t tens = (num > 4) ? (uint8_t)((bits >> (first + 4)) & ((1U << (num - 4)) - 1)) : 0;
+
+    return (units > 9) ? 0xFF : (uint8_t)(tens * 10 + units);
+}
+
+/**
+ * @brief  偶校验: 区间内(含校验位)1的个数为偶数
+ * @param  bits : 输入参数, 帧数据位
+ * @param  first: 输入参数, 起始秒
+ * @param  last : 输入参数, 校验位所在秒
+ * @return true : 正确
+ * @return false: 错误
+ */
+static bool gpio_timecode_parity(const uint64_t bits, const uint8_t first, const uint8_t last)
+{
+    uint8_t parity = 0;
+
+    for (uint8_t i = first; i <= last; i++)
+    {
+        parity ^= (bits >> i) & 1;
+    }
+
+    return (0 == parity);
+}
+
+/**
+ * @brief  解码DCF77帧(第0~58秒)
+ * @param  time: 输出参数, 时间
+ * @param  bits: 输入参数, 帧数据位
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_timecode_decode_dcf77(gpio_timecode_time_t *time, const uint64_t bits)
+{
+    uint8_t year = 0;
+
+    // 第0秒固定为0, 第20秒固定为1, CEST/CET只有一个为1
+    if ((bits & 1) || (!((bits >> GPIO_TIMECODE_DCF77_START) & 1)) ||
+        (((bits >> GPIO_TIMECODE_DCF77_CEST) & 1) == ((bits >> GPIO_TIMECODE_DCF77_CET) & 1)))
+    {
+        return false;
+    }
+
+    if ((!gpio_timecode_parity(bits, GPIO_TIMECODE_DCF77_MINUTE, GPIO_TIMECODE_DCF77_HOUR - 1)) ||
+        (!gpio_timecode_parity(bits, GPIO_TIMECODE_DCF77_HOUR, GPIO_TIMECODE_DCF77_DAY - 1)) ||
+        (!gpio_timecode_parity(bits, GPIO_TIMECODE_DCF77_DAY, GPIO_TIMECODE_DCF77_PARITY_DATE)))
+    {
+        return false;
+    }
+
+    time->minute = gpio_timecode_bcd(bits, GPIO_TIMECODE_DCF77_MINUTE, 7);
+    time->hour = gpio_timecode_bcd(bits, GPIO_TIMECODE_DCF77_HOUR, 6);
+    time->day = gpio_timecode_bcd(bits, GPIO_TIMECODE_DCF77_DAY, 6);
+    time->weekday = gpio_timecode_bcd(bits, GPIO_TIMECODE_DCF77_WEEKDAY, 3);
+    time->month = gpio_timecode_bcd(bits, GPIO_TIMECODE_DCF77_MONTH, 5);
+    year = gpio_timecode_bcd(bits, GPIO_TIMECODE_DCF77_YEAR, 8);
+    if ((time->minute > 59) || (time->hour > 23) || (0 == time->day) || (time->day > 31) || (0 == time->weekday) ||
+        (time->weekday > 7) || (0 == time->month) || (time->month > 12) || (year > 99))
+    {
+        return false;
+    }
+
+    time->year = 2000 + year;
+    time->day_of_year = gpio_timecode_month_days[time->month - 1] + time->day +
+                        (((time->month > 2) && (gpio_timecode_leap_year(time->year))) ? 1 : 0);
+    time->dst = (bits >> GPIO_TIMECODE_DCF77_CEST) & 1;
+    time->dst_announce = (bits >> GPIO_TIMECODE_DCF77_DST_ANNOUNCE) & 1;
+    time->leap_announce = (bits >> GPIO_TIMECODE_DCF77_LEAP) & 1;
+
+    return true;
+}
+
+/**
+ * @brief  解码WWVB帧(第0~59秒)
+ * @param  time   : 输出参数, 时间
+ * @param  bits   : 输入参数, 帧数据位
+ * @param  markers: 输入参数, 帧标记
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_timecode_decode_wwvb(gpio_timecode_time_t *time, const uint64_t bits, const uint64_t markers)
+{
+    uint8_t minute_units = gpio_timecode_msb(bits, 5, 4);
+    uint8_t hour_units = gpio_timecode_msb(bits, 15, 4);
+    uint8_t day_tens = gpio_timecode_msb(bits, 25, 4);
+    uint8_t day_units = gpio_timecode_msb(bits, 30, 4);
+    uint8_t year_tens = gpio_timecode_msb(bits, 45, 4);
+    uint8_t year_units = gpio_timecode_msb(bits, 50, 4);
+    uint8_t dut1_sign = gpio_timecode_msb(bits, 36, 3);
+    uint16_t days = 0;
+    uint8_t month = 1;
+
+    if ((GPIO_TIMECODE_WWVB_MARKERS != markers) || (0 != (bits & GPIO_TIMECODE_WWVB_ZEROS)) || (minute_units > 9) ||
+        (hour_units > 9) || (day_tens > 9) || (day_units > 9) || (year_tens > 9) || (year_units > 9))
+    {
+        return false;
+    }
+
+    time->minute = (uint8_t)(gpio_timecode_msb(bits, 1, 3) * 10 + minute_units);
+    time->hour = (uint8_t)(gpio_timecode_msb(bits, 12, 2) * 10 + hour_units);
+    time->day_of_year = (uint16_t)(gpio_timecode_msb(bits, 22, 2) * 100 + day_tens * 10 + day_units);
+    time->year = (uint16_t)(2000 + year_tens * 10 + year_units);
+    days = gpio_timecode_leap_year(time->year) ? 366 : 365;
+    if ((time->minute > 59) || (time->hour > 23) || (0 == time->day_of_year) || (time->day_of_year > days) ||
+        (((bits >> 55) & 1) != (366 == days)))
+    {
+        return false;
+    }
+
+    // 一年中的第几天换算为月日, 闰年2月29日之后减去一天再查平年表
+    days = time->day_of_year;
+    if ((gpio_timecode_leap_year(time->year)) && (days > gpio_timecode_month_days[2]))
+    {
+        if (gpio_timecode_month_days[2] + 1 == days)
+        {
+            month = 2;
+            time->day = 29;
+        }
+
+        days--;
+    }
+
+    if (29 != time->day)
+    {
+        while (days > gpio_timecode_month_days[month])
+        {
+            month++;
+        }
+
+        time->day = (uint8_t)(days - gpio_timecode_month_days[month - 1]);
+    }
+
+    time->month = month;
+    time->weekday = gpio_timecode_weekday(time->year, time->month, time->day);
+
+    // 第57/58秒: 11为夏令时生效, 10/01为当天切换
+    time->dst = ((bits >> 57) & 1) && ((bits >> 58) & 1);
+    time->dst_announce = ((bits >> 57) & 1) != ((bits >> 58) & 1);
+    time->leap_announce = (bits >> 56) & 1;
+
+    // 第36~38秒为101时为正, 010时为负
+    time->dut1 = (int8_t)gpio_timecode_msb(bits, 40, 4);
+    if (0x02 == dut1_sign)
+    {
+        time->dut1 = (int8_t)-time->dut1;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  一帧结束, 校验解码并回调
+ * @param  timecode    : 输入参数, 解码器
+ * @param  timestamp_ns: 输入参数, 该时间对应的第0秒时间戳, 单位: ns
+ */
+static void gpio_timecode_frame(gpio_timecode_t *timecode, const uint64_t timestamp_ns)
+{
+    gpio_timecode_time_t time = {0};
+    bool ret = false;
+
+    if (E_GPIO_TIMECODE_DCF77 == timecode->config.protocol)
+    {
+        ret = gpio_timecode_decode_dcf77(&time, timecode->bits);
+    }
+    else
+    {
+        ret = gpio_timecode_decode_wwvb(&time, timecode->bits, timecode->markers);
+    }
+
+    if (!ret)
+    {
+        timecode->stats.frame_errors++;
+
+        return;
+    }
+
+    timecode->stats.frames++;
+    time.timestamp_ns = timestamp_ns;
+    if (timecode->config.time_callback)
+    {
+        timecode->config.time_callback(&time, timecode->config.arg);
+    }
+}
+
+/**
+ * @brief  处理一个有效脉冲: 由与上一个脉冲开始的间隔推进秒序号, 记录符号
+ * @param  timecode: 输入参数, 解码器
+ * @param  symbol  : 输入参数, 符号
+ */
+static void gpio_timecode_second(gpio_timecode_t *timecode, const uint8_t symbol)
+{
+    uint64_t interval = timecode->pulse_ns - timecode->second_ns;
+    uint64_t seconds = (interval + GPIO_TIMECODE_SECOND_NS / 2) / GPIO_TIMECODE_SECOND_NS;
+    uint64_t offset = 0;
+    bool dcf77 = (E_GPIO_TIMECODE_DCF77 == timecode->config.protocol);
+    bool first = (0 == timecode->second_ns);
+
+    timecode->second_ns = timecode->pulse_ns;
+    offset = (interval > seconds * GPIO_TIMECODE_SECOND_NS) ? (interval - seconds * GPIO_TIMECODE_SECOND_NS)
+                                                           : (seconds * GPIO_TIMECODE_SECOND_NS - interval);
+    if ((!first) && ((offset > GPIO_TIMECODE_JITTER_NS) || (0 == seconds) || (seconds > (dcf77 ? 2 : 1))))
+    {
+        timecode->stats.timing_errors++;
+        timecode->second = -1;
+    }
+    else if ((dcf77) && (2 == seconds))
+    {
+        // 第59秒没有脉冲: 上一个脉冲为第58秒(闰秒时为第59秒), 本脉冲为下一分钟的第0秒
+        if ((58 == timecode->second) ||
+            ((59 == timecode->second) && ((timecode->bits >> GPIO_TIMECODE_DCF77_LEAP) & 1)))
+        {
+            gpio_timecode_frame(timecode, timecode->pulse_ns);
+        }
+        else if (timecode->second >= 0)
+        {
+            timecode->stats.timing_errors++;
+        }
+
+        timecode->second = 0;
+        timecode->bits = 0;
+    }
+    else if (timecode->second >= 0)
+    {
+        timecode->second++;
+        if ((!dcf77) && (GPIO_TIMECODE_FRAME_SECONDS == timecode->second))
+        {
+            gpio_timecode_frame(timecode, timecode->frame_ns);
+            timecode->second = 0;
+        }
+        else if (timecode->second >= GPIO_TIMECODE_FRAME_SECONDS)
+        {
+            timecode->stats.timing_errors++;
+            timecode->second = -1;
+        }
+    }
+
+    // WWVB连续两个标记的第二个为第0秒
+    if (!dcf77)
+    {
+        if ((GPIO_TIMECODE_MARKER == symbol) && (timecode->prev_marker) && (timecode->second < 0))
+        {
+            timecode->second = 0;
+        }
+        else if ((0 == timecode->second) && (GPIO_TIMECODE_MARKER != symbol))
+        {
+            timecode->stats.timing_errors++;
+            timecode->second = -1;
+        }
+
+        timecode->prev_marker = (GPIO_TIMECODE_MARKER == symbol);
+    }
+
+    // 无法识别的脉冲仍作为秒开始, 但当前帧已不完整
+    if (GPIO_TIMECODE_INVALID == symbol)
+    {
+        timecode->stats.width_errors++;
+        timecode->second = -1;
+    }
+
+    if (0 == timecode->second)
+    {
+        timecode->bits = 0;
+        timecode->markers = 0;
+        timecode->frame_ns = timecode->pulse_ns;
+    }
+
+    if (timecode->second >= 0)
+    {
+        timecode->bits |= (uint64_t)(GPIO_TIMECODE_ONE == symbol) << timecode->second;
+        timecode->markers |= (uint64_t)(GPIO_TIMECODE_MARKER == symbol) << timecode->second;
+    }
+
+    if (timecode->config.second_callback)
+    {
+        timecode->config.second_callback(timecode->second, timecode->pulse_ns, timecode->config.arg);
+    }
+}
+
+/**
+ * @brief  初始化授时信号解码器
+ * @param  timecode: 输出参数, 解码器
+ * @param  config  : 输入参数, 解码器配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_timecode_init(gpio_timecode_t *timecode, const gpio_timecode_config_t *config)
+{
+    uint64_t bit = 0;
+
+    if ((!timecode) || (!config) || (!config->group) || (config->index >= config->group->num) ||
+        (config->protocol > E_GPIO_TIMECODE_WWVB))
+    {
+        return false;
+    }
+
+    bit = 1ULL << config->index;
+    if ((!(config->group->rising_mask & bit)) || (!(config->group->falling_mask & bit)))
+    {
+        return false;
+    }
+
+    memset(timecode, 0, sizeof(gpio_timecode_t));
+    timecode->config = *config;
+    timecode->second = -1;
+
+    return true;
+}
+
+/**
+ * @brief  处理边沿事件: 由脉冲宽度识别每秒的符号, 由相邻脉冲开始的间隔跟踪秒和分钟, 收满一帧后校验并回调时间
+ * @note   可直接作为gpio_loop的回调函数, arg为解码器; 分钟标记由间隔识别, 不需要轮询线程
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 解码器
+ */
+void gpio_timecode_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg)
+{
+    gpio_timecode_t *timecode = (gpio_timecode_t *)arg;
+    gpio_edge_e active = E_GPIO_NONE;
+    uint64_t width = 0;
+    uint8_t symbol = GPIO_TIMECODE_INVALID;
+
+    if ((!timecode) || (!event) || (group != timecode->config.group) || (event->index != timecode->config.index))
+    {
+        return;
+    }
+
+    // 丢失或合并的边沿使脉冲宽度和秒间隔失效, 重新同步
+    if ((0 != event->lost) || (event->count > 1))
+    {
+        timecode->stats.lost += (0 != event->lost) ? event->lost : (event->count - 1);
+        timecode->in_pulse = false;
+        timecode->second_ns = 0;
+        timecode->second = -1;
+        timecode->prev_marker = false;
+
+        return;
+    }
+
+    active = timecode->config.active_high ? E_GPIO_RISING : E_GPIO_FALLING;
+    if (active == event->edge)
+    {
+        timecode->in_pulse = true;
+        timecode->pulse_ns = event->timestamp_ns;
+
+        return;
+    }
+
+    if (!timecode->in_pulse)
+    {
+        return;
+    }
+
+    // 干扰脉冲不作为秒开始
+    timecode->in_pulse = false;
+    width = event->timestamp_ns - timecode->pulse_ns;
+    if (width < GPIO_TIMECODE_GLITCH_NS)
+    {
+        timecode->stats.glitches++;
+
+        return;
+    }
+
+    if (E_GPIO_TIMECODE_DCF77 == timecode->config.protocol)
+    {
+        if (width < GPIO_TIMECODE_DCF77_ZERO_NS)
+        {
+            symbol = GPIO_TIMECODE_ZERO;
+        }
+        else if (width < GPIO_TIMECODE_DCF77_ONE_NS)
+        {
+            symbol = GPIO_TIMECODE_ONE;
+        }
+    }
+    else
+    {
+        if (width < GPIO_TIMECODE_WWVB_ZERO_NS)
+        {
+            symbol = GPIO_TIMECODE_ZERO;
+        }
+        else if (width < GPIO_TIMECODE_WWVB_ONE_NS)
+        {
+            symbol = GPIO_TIMECODE_ONE;
+        }
+        else if (width < GPIO_TIMECODE_WWVB_MARKER_NS)
+        {
+            symbol = GPIO_TIMECODE_MARKER;
+        }
+    }
+
+    timecode->stats.pulses++;
+    gpio_timecode_second(timecode, symbol);
+}
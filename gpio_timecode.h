@@ -0,0 +1,154 @@
+/**
+ * @file      : gpio_timecode.h
+ * @brief     : DCF77/WWVB长波授时信号解码头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 14:02:16
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *
+ */
+
+#ifndef __GPIO_TIMECODE_H
+#define __GPIO_TIMECODE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+
+// 授时信号
+typedef enum
+{
+    // DCF77: 每秒开始100ms/200ms脉冲表示0/1, 第59秒无脉冲标记分钟开始, 帧内为下一分钟的本地时间
+    E_GPIO_TIMECODE_DCF77 = 0,
+    // WWVB: 每秒开始200ms/500ms/800ms脉冲表示0/1/标记, 连续两个标记的第二个为第0秒, 帧内为本分钟的UTC时间
+    E_GPIO_TIMECODE_WWVB = 1,
+} gpio_timecode_protocol_e;
+
+// 解码出的时间
+typedef struct
+{
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    // 星期: 1~7为周一~周日
+    uint8_t weekday;
+    uint8_t hour;
+    uint8_t minute;
+    // 一年中的第几天(WWVB直接发送, DCF77由日期计算)
+    uint16_t day_of_year;
+    // 夏令时生效/即将切换
+    bool dst;
+    bool dst_announce;
+    // 即将插入闰秒
+    bool leap_announce;
+    // UT1-UTC, 单位: 0.1s(只有WWVB发送)
+    int8_t dut1;
+    // 该时间对应的第0秒开始边沿的内核时间戳, 单位: ns
+    uint64_t timestamp_ns;
+} gpio_timecode_time_t;
+
+/**
+ * @brief  秒脉冲回调函数, 在事件循环线程中调用
+ * @param  second      : 输入参数, 帧内秒序号, 尚未与分钟同步时为-1
+ * @param  timestamp_ns: 输入参数, 秒开始边沿的内核时间戳, 单位: ns
+ * @param  arg         : 输入参数, 配置中的用户参数
+ */
+typedef void (*gpio_timecode_second_callback_t)(const int8_t second, const uint64_t timestamp_ns, void *arg);
+
+/**
+ * @brief  时间回调函数(一帧校验正确), 在事件循环线程中调用
+ * @param  time: 输入参数, 解码出的时间
+ * @param  arg : 输入参数, 配置中的用户参数
+ */
+typedef void (*gpio_timecode_time_callback_t)(const gpio_timecode_time_t *time, void *arg);
+
+// 授时信号解码器配置
+typedef struct
+{
+    // 输入GPIO组(检测双边沿)
+    gpio_group_t *group;
+    // 输入GPIO组内序号
+    uint8_t index;
+    gpio_timecode_protocol_e protocol;
+    // 接收模块输出的脉冲为高电平
+    bool active_high;
+    // 秒脉冲回调函数, 可以为NULL
+    gpio_timecode_second_callback_t second_callback;
+    // 时间回调函数, 可以为NULL
+    gpio_timecode_time_callback_t time_callback;
+    // 用户参数
+    void *arg;
+} gpio_timecode_config_t;
+
+// 解码统计
+typedef struct
+{
+    // 有效脉冲个数
+    uint64_t pulses;
+    // 过短被忽略的干扰脉冲个数
+    uint64_t glitches;
+    // 脉冲宽度无法识别的次数
+    uint64_t width_errors;
+    // 秒间隔不符(缺失或多余脉冲)的次数
+    uint64_t timing_errors;
+    // 帧校验错误(奇偶校验、固定位、标记位置或取值范围)的次数
+    uint64_t frame_errors;
+    // 解码出的时间个数
+    uint64_t frames;
+    // 内核丢失或事件循环合并的事件个数
+    uint64_t lost;
+} gpio_timecode_stats_t;
+
+// 授时信号解码器
+typedef struct
+{
+    gpio_timecode_config_t config;
+    // 脉冲进行中及其开始边沿时间戳, 单位: ns
+    bool in_pulse;
+    uint64_t pulse_ns;
+    // 上一个有效脉冲的开始时间戳, 单位: ns
+    uint64_t second_ns;
+    // 当前秒在帧内的序号, -1表示尚未同步
+    int8_t second;
+    // 帧内各秒的数据位和标记(WWVB)
+    uint64_t bits;
+    uint64_t markers;
+    // 上一秒是标记(WWVB帧同步)
+    bool prev_marker;
+    // 当前帧第0秒的时间戳, 单位: ns
+    uint64_t frame_ns;
+    gpio_timecode_stats_t stats;
+} gpio_timecode_t;
+
+/**
+ * @brief  初始化授时信号解码器
+ * @param  timecode: 输出参数, 解码器
+ * @param  config  : 输入参数, 解码器配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_timecode_init(gpio_timecode_t *timecode, const gpio_timecode_config_t *config);
+
+/**
+ * @brief  处理边沿事件: 由脉冲宽度识别每秒的符号, 由相邻脉冲开始的间隔跟踪秒和分钟, 收满一帧后校验并回调时间
+ * @note   可直接作为gpio_loop的回调函数, arg为解码器; 分钟标记由间隔识别, 不需要轮询线程
+ * @param  group: 输入参数, 产生事件的GPIO组
+ * @param  event: 输入参数, 边沿事件
+ * @param  arg  : 输入参数, 解码器
+ */
+void gpio_timecode_on_event(gpio_group_t *group, const gpio_event_t *event, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_TIMECODE_H
@@ -0,0 +1,457 @@
+/**
+ * @file      : gpio_timer.c
+ * @brief     : GPIO定时输出引擎源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 15:30:02
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-18 huenrong        同时到期的定时动作合并为一次批量输出
+ *              2026-10-19 huenrong        增加屏障动作, 不与更早的动作合并, 忙等待到自身截止时刻后输出
+ *              2026-10-19 huenrong        绑定CPU改为显式开关, 默认配置不绑定
+ *
+ */
+
+// 使用pthread_setaffinity_np需要定义_GNU_SOURCE
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sched.h>
+
+#include "./gpio_timer.h"
+
+/**
+ * @brief  获取CLOCK_MONOTONIC当前时间, 与定时动作截止时刻同一时钟
+ * @return 当前时间, 单位: ns
+ */
+uint64_t gpio_timer_now_ns(void)
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  交换堆中两个定时动作
+ * @param  timer: 输入参数, 定时引擎
+ * @param  a    : 输入参数, 堆下标
+ * @param  b    : 输入参数, 堆下标
+ */
+static void gpio_timer_swap(gpio_timer_t *timer, const uint32_t a, const uint32_t b)
+{
+    gpio_timer_action_t tmp = timer->heap[a];
+
+    timer->heap[a] = timer->heap[b];
+    timer->heap[b] = tmp;
+}
+
+/**
+ * @brief  堆元素上浮
+ * @param  timer: 输入参数, 定时引擎
+ * @param  index: 输入参数, 堆下标
+ */
+static void gpio_timer_sift_up(gpio_timer_t *timer, uint32_t index)
+{
+    uint32_t parent = 0;
+
+    while (index > 0)
+    {
+        parent = (index - 1) / 2;
+        if (timer->heap[parent].deadline_ns <= timer->heap[index].deadline_ns)
+        {
+            break;
+        }
+
+        gpio_timer_swap(timer, parent, index);
+        index = parent;
+    }
+}
+
+/**
+ * @brief  堆元素下沉
+ * @param  timer: 输入参数, 定时引擎
+ * @param  index: 输入参数, 堆下标
+ */
+static void gpio_timer_sift_down(gpio_timer_t *timer, uint32_t index)
+{
+    uint32_t child = 0;
+
+    while (true)
+    {
+        child = index * 2 + 1;
+        if (child >= timer->count)
+        {
+            break;
+        }
+
+        if ((child + 1 < timer->count) && (timer->heap[child + 1].deadline_ns < timer->heap[child].deadline_ns))
+        {
+            child++;
+        }
+
+        if (timer->heap[index].deadline_ns <= timer->heap[child].deadline_ns)
+        {
+            break;
+        }
+
+        gpio_timer_swap(timer, index, child);
+        index = child;
+    }
+}
+
+/**
+ * @brief  删除堆中指定下标的元素
+ * @param  timer: 输入参数, 定时引擎
+ * @param  index: 输入参数, 堆下标
+ */
+static void gpio_timer_remove(gpio_timer_t *timer, const uint32_t index)
+{
+    timer->count--;
+    if (index == timer->count)
+    {
+        return;
+    }
+
+    timer->heap[index] = timer->heap[timer->count];
+    gpio_timer_sift_up(timer, index);
+    gpio_timer_sift_down(timer, index);
+}
+
+/**
+ * @brief  执行一批到期的定时动作: 忙等待到最早的截止时刻, 每个GPIO组合并为一次批量设置, 逐个回调
+ * @param  timer  : 输入参数, 定时引擎
+ * @param  actions: 输入参数, 按截止时刻排序的定时动作
+ * @param  num    : 输入参数, 定时动作个数
+ */
+static void gpio_timer_fire(gpio_timer_t *timer, const gpio_timer_action_t *actions, const uint32_t num)
+{
+    int64_t error_ns = 0;
+    uint64_t mask = 0;
+    uint64_t values = 0;
+    uint64_t done_ns[GPIO_TIMER_MAX_BATCH] = {0};
+    bool written[GPIO_TIMER_MAX_BATCH] = {0};
+
+    // 最后一段忙等待, 避免睡眠唤醒延迟
+    while (gpio_timer_now_ns() < actions[0].deadline_ns)
+    {
+    }
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        if (written[i])
+        {
+            continue;
+        }
+
+        // 不提前执行的动作等到自身截止时刻
+        if (actions[i].barrier)
+        {
+            while (gpio_timer_now_ns() < actions[i].deadline_ns)
+            {
+            }
+        }
+
+        // 合并同一GPIO组的全部输出, 同一GPIO以截止时刻较晚的为准, 遇到该组不提前执行的动作为止
+        mask = 0;
+        values = 0;
+        for (uint32_t j = i; j < num; j++)
+        {
+            if ((written[j]) || (actions[j].group != actions[i].group))
+            {
+                continue;
+            }
+
+            if ((j != i) && (actions[j].barrier))
+            {
+                break;
+            }
+
+            values = (values & ~actions[j].mask) | (actions[j].values & actions[j].mask);
+            mask |= actions[j].mask;
+            written[j] = true;
+        }
+
+        if ((actions[i].group) && (0 != mask))
+        {
+            gpio_group_set_values(actions[i].group, mask, values);
+            timer->write_count++;
+        }
+
+        done_ns[i] = gpio_timer_now_ns();
+        for (uint32_t j = i + 1; j < num; j++)
+        {
+            if ((written[j]) && (0 == done_ns[j]) && (actions[j].group == actions[i].group))
+            {
+                done_ns[j] = done_ns[i];
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < num; i++)
+    {
+        error_ns = (int64_t)(done_ns[i] - actions[i].deadline_ns);
+        timer->fired_count++;
+        if (error_ns > timer->max_error_ns)
+        {
+            timer->max_error_ns = error_ns;
+        }
+
+        if (actions[i].callback)
+        {
+            actions[i].callback(timer, &actions[i], error_ns, actions[i].arg);
+        }
+    }
+}
+
+/**
+ * @brief  定时线程
+ * @param  arg: 输入参数, 定时引擎
+ * @return NULL
+ */
+static void *gpio_timer_thread(void *arg)
+{
+    gpio_timer_t *timer = (gpio_timer_t *)arg;
+    gpio_timer_action_t actions[GPIO_TIMER_MAX_BATCH];
+    uint32_t num = 0;
+    uint64_t wake_ns = 0;
+    uint64_t last_ns = 0;
+    struct timespec ts = {0};
+
+    pthread_mutex_lock(&timer->mutex);
+    while (timer->running)
+    {
+        if (0 == timer->count)
+        {
+            pthread_cond_wait(&timer->cond, &timer->mutex);
+
+            continue;
+        }
+
+        // 睡眠到截止时刻前的忙等待窗口, 期间有更早的定时动作加入时被唤醒
+        wake_ns = (timer->heap[0].deadline_ns > timer->spin_ns) ? (timer->heap[0].deadline_ns - timer->spin_ns) : 0;
+        if (gpio_timer_now_ns() < wake_ns)
+        {
+            ts.tv_sec = (time_t)(wake_ns / 1000000000ULL);
+            ts.tv_nsec = (long)(wake_ns % 1000000000ULL);
+            pthread_cond_timedwait(&timer->cond, &timer->mutex, &ts);
+
+            continue;
+        }
+
+        // 取出合并窗口内的全部定时动作
+        num = 0;
+        last_ns = timer->heap[0].deadline_ns + timer->merge_ns;
+        while ((timer->count > 0) && (num < GPIO_TIMER_MAX_BATCH) && (timer->heap[0].deadline_ns <= last_ns))
+        {
+            actions[num++] = timer->heap[0];
+            gpio_timer_remove(timer, 0);
+        }
+
+        // 执行时释放锁, 回调中可以继续添加定时动作
+        pthread_mutex_unlock(&timer->mutex);
+        gpio_timer_fire(timer, actions, num);
+        pthread_mutex_lock(&timer->mutex);
+    }
+
+    pthread_mutex_unlock(&timer->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief  启动定时引擎
+ * @param  timer : 输出参数, 定时引擎
+ * @param  config: 输入参数, 定时引擎配置, 为NULL时使用默认配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_timer_start(gpio_timer_t *timer, const gpio_timer_config_t *config)
+{
+    pthread_attr_t attr;
+    pthread_condattr_t cond_attr;
+    struct sched_param param = {0};
+    cpu_set_t cpus;
+    int ret = -1;
+
+    if ((!timer) || ((config) && (config->bind_cpu) && ((config->cpu < 0) || (config->cpu >= CPU_SETSIZE))))
+    {
+        return false;
+    }
+
+    memset(timer, 0, sizeof(gpio_timer_t));
+    timer->next_id = 1;
+    timer->spin_ns = ((config) && (0 != config->spin_ns)) ? config->spin_ns : GPIO_TIMER_DEFAULT_SPIN_NS;
+    timer->merge_ns = (config) ? config->merge_ns : 0;
+
+    // 条件变量超时使用CLOCK_MONOTONIC, 与截止时刻同一时钟
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+    if (0 != pthread_cond_init(&timer->cond, &cond_attr))
+    {
+        pthread_condattr_destroy(&cond_attr);
+
+        return false;
+    }
+
+    pthread_condattr_destroy(&cond_attr);
+    if (0 != pthread_mutex_init(&timer->mutex, NULL))
+    {
+        pthread_cond_destroy(&timer->cond);
+
+        return false;
+    }
+
+    timer->running = true;
+
+    pthread_attr_init(&attr);
+    if ((config) && (config->priority > 0))
+    {
+        param.sched_priority = config->priority;
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+
+    ret = pthread_create(&timer->thread, &attr, gpio_timer_thread, timer);
+    pthread_attr_destroy(&attr);
+
+    // 没有实时调度权限时退回普通调度
+    if ((EPERM == ret) && (config) && (config->priority > 0))
+    {
+        ret = pthread_create(&timer->thread, NULL, gpio_timer_thread, timer);
+    }
+    else if ((0 == ret) && (config) && (config->priority > 0))
+    {
+        timer->realtime = true;
+    }
+
+    if (0 != ret)
+    {
+        timer->running = false;
+        pthread_mutex_destroy(&timer->mutex);
+        pthread_cond_destroy(&timer->cond);
+
+        return false;
+    }
+
+    if ((config) && (config->bind_cpu))
+    {
+        CPU_ZERO(&cpus);
+        CPU_SET(config->cpu, &cpus);
+        pthread_setaffinity_np(timer->thread, sizeof(cpus), &cpus);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  停止定时引擎, 未执行的定时动作被丢弃
+ * @param  timer: 输入参数, 定时引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_timer_stop(gpio_timer_t *timer)
+{
+    if ((!timer) || (!timer->running))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&timer->mutex);
+    timer->running = false;
+    timer->count = 0;
+    pthread_cond_signal(&timer->cond);
+    pthread_mutex_unlock(&timer->mutex);
+
+    pthread_join(timer->thread, NULL);
+    pthread_mutex_destroy(&timer->mutex);
+    pthread_cond_destroy(&timer->cond);
+
+    return true;
+}
+
+/**
+ * @brief  添加定时动作, 可在任意线程(包括定时回调)中调用
+ * @note   定时引擎输出的GPIO组应只由定时线程写入
+ * @param  timer : 输入参数, 定时引擎
+ * @param  action: 输入参数, 定时动作(id由本函数分配)
+ * @return 成功: 定时动作标识(非0)
+ *         失败: 0
+ */
+uint32_t gpio_timer_schedule(gpio_timer_t *timer, const gpio_timer_action_t *action)
+{
+    uint32_t id = 0;
+
+    if ((!timer) || (!action) || (!timer->running))
+    {
+        return 0;
+    }
+
+    pthread_mutex_lock(&timer->mutex);
+    if (timer->count >= GPIO_TIMER_MAX_ACTIONS)
+    {
+        pthread_mutex_unlock(&timer->mutex);
+
+        return 0;
+    }
+
+    id = timer->next_id++;
+    if (0 == timer->next_id)
+    {
+        timer->next_id = 1;
+    }
+
+    timer->heap[timer->count] = *action;
+    timer->heap[timer->count].id = id;
+    timer->count++;
+    gpio_timer_sift_up(timer, timer->count - 1);
+
+    // 新动作成为最早的动作时唤醒定时线程重新计算睡眠时间
+    if (id == timer->heap[0].id)
+    {
+        pthread_cond_signal(&timer->cond);
+    }
+
+    pthread_mutex_unlock(&timer->mutex);
+
+    return id;
+}
+
+/**
+ * @brief  取消未执行的定时动作
+ * @param  timer: 输入参数, 定时引擎
+ * @param  id   : 输入参数, 定时动作标识
+ * @return true : 成功
+ * @return false: 定时动作不存在或已执行
+ */
+bool gpio_timer_cancel(gpio_timer_t *timer, const uint32_t id)
+{
+    bool result = false;
+
+    if ((!timer) || (0 == id))
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&timer->mutex);
+    for (uint32_t i = 0; i < timer->count; i++)
+    {
+        if (id == timer->heap[i].id)
+        {
+            gpio_timer_remove(timer, i);
+            result = true;
+
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&timer->mutex);
+
+    return result;
+}
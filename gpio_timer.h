@@ -0,0 +1,162 @@
+/**
+ * @file      : gpio_timer.h
+ * @brief     : GPIO定时输出引擎头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 15:30:02
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-18 huenrong        同时到期的定时动作合并为一次批量输出
+ *              2026-10-19 huenrong        增加屏障动作, 不与更早的动作合并, 忙等待到自身截止时刻后输出
+ *              2026-10-19 huenrong        绑定CPU改为显式开关, 默认配置不绑定
+ *
+ */
+
+#ifndef __GPIO_TIMER_H
+#define __GPIO_TIMER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "./gpio_group.h"
+
+// 定时引擎最多同时等待的定时动作个数
+#define GPIO_TIMER_MAX_ACTIONS 256
+
+// 默认忙等待窗口, 单位: ns
+#define GPIO_TIMER_DEFAULT_SPIN_NS 50000
+
+// 一次合并执行的定时动作最多个数
+#define GPIO_TIMER_MAX_BATCH 64
+
+typedef struct gpio_timer gpio_timer_t;
+typedef struct gpio_timer_action gpio_timer_action_t;
+
+/**
+ * @brief  定时动作执行完成回调函数, 在定时线程中调用, 可在其中继续添加定时动作
+ * @param  timer   : 输入参数, 定时引擎
+ * @param  action  : 输入参数, 已执行的定时动作
+ * @param  error_ns: 输入参数, 输出完成时刻与截止时刻的偏差, 单位: ns, 正数表示滞后
+ * @param  arg     : 输入参数, 定时动作中的用户参数
+ */
+typedef void (*gpio_timer_callback_t)(gpio_timer_t *timer, const gpio_timer_action_t *action,
+                                      const int64_t error_ns, void *arg);
+
+// 定时动作: 在截止时刻对GPIO组执行一次批量设置, 同时到期且输出同一GPIO组的动作合并为一次批量设置
+struct gpio_timer_action
+{
+    // 截止时刻(CLOCK_MONOTONIC, 与GPIO事件的内核时间戳同一时钟), 单位: ns
+    uint64_t deadline_ns;
+    // 输出的GPIO组, 为NULL时只回调
+    gpio_group_t *group;
+    // 输出的GPIO掩码
+    uint64_t mask;
+    // 输出的电平值
+    uint64_t values;
+    // 执行完成回调函数, 可以为NULL
+    gpio_timer_callback_t callback;
+    // 用户参数
+    void *arg;
+    // 不提前执行: 不与同一GPIO组中截止时刻更早的动作合并, 忙等待到自身截止时刻后单独批量设置(用于死区等最小间隔)
+    bool barrier;
+    // 定时动作标识, 由gpio_timer_schedule分配, 用于取消
+    uint32_t id;
+};
+
+// 定时引擎配置
+typedef struct
+{
+    // 定时线程SCHED_FIFO优先级[1, 99], 0表示普通调度; 没有权限时自动退回普通调度
+    int priority;
+    // 为true时定时线程绑定到cpu, 默认不绑定
+    bool bind_cpu;
+    // 定时线程绑定的CPU, 仅bind_cpu为true时有效
+    int cpu;
+    // 截止时刻前的忙等待窗口, 单位: ns, 0表示使用GPIO_TIMER_DEFAULT_SPIN_NS
+    uint64_t spin_ns;
+    // 合并窗口, 单位: ns, 截止时刻相差不超过该值的定时动作在最早的截止时刻一起执行, 0表示只合并截止时刻相同的
+    uint64_t merge_ns;
+} gpio_timer_config_t;
+
+// 定时引擎, 一个实时线程按截止时刻顺序执行所有定时动作
+struct gpio_timer
+{
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    // 定时线程运行标志
+    volatile bool running;
+    // 实际使用SCHED_FIFO
+    bool realtime;
+    // 忙等待窗口, 单位: ns
+    uint64_t spin_ns;
+    // 合并窗口, 单位: ns
+    uint64_t merge_ns;
+    // 按截止时刻排序的最小堆
+    gpio_timer_action_t heap[GPIO_TIMER_MAX_ACTIONS];
+    uint32_t count;
+    // 下一个定时动作标识
+    uint32_t next_id;
+    // 已执行的定时动作个数
+    uint64_t fired_count;
+    // 实际执行的GPIO组批量设置次数(合并后)
+    uint64_t write_count;
+    // 最大滞后, 单位: ns
+    int64_t max_error_ns;
+};
+
+/**
+ * @brief  启动定时引擎
+ * @param  timer : 输出参数, 定时引擎
+ * @param  config: 输入参数, 定时引擎配置, 为NULL时使用默认配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_timer_start(gpio_timer_t *timer, const gpio_timer_config_t *config);
+
+/**
+ * @brief  停止定时引擎, 未执行的定时动作被丢弃
+ * @param  timer: 输入参数, 定时引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_timer_stop(gpio_timer_t *timer);
+
+/**
+ * @brief  添加定时动作, 可在任意线程(包括定时回调)中调用
+ * @note   定时引擎输出的GPIO组应只由定时线程写入
+ * @param  timer : 输入参数, 定时引擎
+ * @param  action: 输入参数, 定时动作(id由本函数分配)
+ * @return 成功: 定时动作标识(非0)
+ *         失败: 0
+ */
+uint32_t gpio_timer_schedule(gpio_timer_t *timer, const gpio_timer_action_t *action);
+
+/**
+ * @brief  取消未执行的定时动作
+ * @param  timer: 输入参数, 定时引擎
+ * @param  id   : 输入参数, 定时动作标识
+ * @return true : 成功
+ * @return false: 定时动作不存在或已执行
+ */
+bool gpio_timer_cancel(gpio_timer_t *timer, const uint32_t id);
+
+/**
+ * @brief  获取CLOCK_MONOTONIC当前时间, 与定时动作截止时刻同一时钟
+ * @return 当前时间, 单位: ns
+ */
+uint64_t gpio_timer_now_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_TIMER_H
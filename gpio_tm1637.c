@@ -0,0 +1,598 @@
+/**
+ * @file      : gpio_tm1637.c
+ * @brief     : TM1637两线LED数码管驱动源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 10:05:14
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        应答时钟的CLK下降与DIO输出低电平在同一次写入
+ *
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "./gpio_tm1637.h"
+
+// 数据命令: 写显示数据, 地址自动递增
+#define GPIO_TM1637_CMD_DATA 0x40
+
+// 地址命令
+#define GPIO_TM1637_CMD_ADDRESS 0xC0
+
+// 显示控制命令: 显示关闭/打开(低3位为亮度)
+#define GPIO_TM1637_CMD_DISPLAY_OFF 0x80
+#define GPIO_TM1637_CMD_DISPLAY_ON 0x88
+
+// 0~9、A~F的段码
+static const uint8_t gpio_tm1637_hex_segments[16] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71,
+};
+
+/**
+ * @brief  忙等待
+ * @param  ns: 输入参数, 等待时间, 单位: ns
+ */
+static void gpio_tm1637_delay(const uint64_t ns)
+{
+    struct timespec start = {0};
+    struct timespec now = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+    {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((uint64_t)((now.tv_sec - start.tv_sec) * 1000000000LL + (now.tv_nsec - start.tv_nsec)) < ns);
+}
+
+/**
+ * @brief  追加一步, 与上一步相同时不追加
+ * @param  tm    : 输入参数, TM1637驱动
+ * @param  values: 输入参数, 输出电平值
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_tm1637_append(gpio_tm1637_t *tm, const uint64_t values)
+{
+    if ((0 != tm->pattern.num) && (values == tm->pattern.steps[tm->pattern.num - 1]))
+    {
+        return true;
+    }
+
+    return gpio_pattern_append(&tm->pattern, values, false) >= 0;
+}
+
+/**
+ * @brief  追加一个时钟: CLK下降, DIO输出low, CLK上升, DIO变为high_end
+ * @note   DIO只在CLK低电平时变化(数据位), 或在CLK高电平时单独变化(起始/停止条件), 不与CLK在同一步变化
+ * @param  tm      : 输入参数, TM1637驱动
+ * @param  current : 输入输出参数, 当前DIO电平
+ * @param  low     : 输入参数, CLK低电平期间的DIO电平
+ * @param  high_end: 输入参数, CLK高电平结束时的DIO电平
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_tm1637_append_cell(gpio_tm1637_t *tm, uint64_t *current, const uint64_t low, const uint64_t high_end)
+{
+    uint64_t clk = 1ULL << tm->config.clk;
+
+    if ((!gpio_tm1637_append(tm, *current)) || (!gpio_tm1637_append(tm, low)) ||
+        (!gpio_tm1637_append(tm, low | clk)) || (!gpio_tm1637_append(tm, high_end | clk)))
+    {
+        return false;
+    }
+
+    *current = high_end;
+
+    return true;
+}
+
+/**
+ * @brief  播放已编译的波形
+ * @param  tm: 输入参数, TM1637驱动
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_tm1637_play(gpio_tm1637_t *tm)
+{
+    bool ret = gpio_pattern_play(NULL, &tm->pattern, tm->config.group, NULL, 0, tm->config.half_period_ns);
+
+    gpio_pattern_clear(&tm->pattern);
+
+    return ret;
+}
+
+/**
+ * @brief  应答时钟(检查应答): CLK下降时DIO同时输出低电平, 再释放发送字节的DIO, CLK高电平时读取,
+ *         CLK下降后恢复输出低电平
+ * @param  nack     : 输出参数, 未应答的DIO掩码
+ * @param  tm       : 输入参数, TM1637驱动
+ * @param  byte_mask: 输入参数, 本轮发送字节的DIO掩码
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_tm1637_check_ack(uint64_t *nack, gpio_tm1637_t *tm, const uint64_t byte_mask)
+{
+    gpio_group_t *group = tm->config.group;
+    uint64_t clk = 1ULL << tm->config.clk;
+    uint64_t values = 0;
+
+    // 芯片在CLK下降沿拉低DIO, 主机不能在CLK低电平期间继续输出第8位的高电平
+    if ((!gpio_tm1637_play(tm)) || (!gpio_group_set_values(group, clk | byte_mask, 0)) ||
+        (!gpio_group_set_direction(group, byte_mask, E_GPIO_IN, 0)))
+    {
+        return false;
+    }
+
+    gpio_tm1637_delay(tm->config.half_period_ns);
+    if ((!gpio_group_set_values(group, clk, clk)) || (!gpio_group_get_values(&values, group, byte_mask)) ||
+        (!gpio_group_set_values(group, clk, 0)) || (!gpio_group_set_direction(group, byte_mask, E_GPIO_OUT, 0)))
+    {
+        return false;
+    }
+
+    gpio_tm1637_delay(tm->config.half_period_ns);
+    *nack = values & byte_mask;
+
+    return true;
+}
+
+/**
+ * @brief  生成数码管本次刷新的传输: 未同步时先发数据命令, 变化的位按地址连续分段(只隔1位未变化时合并), 最后是显示控制命令
+ * @param  display: 输入参数, 数码管
+ */
+static void gpio_tm1637_build_transfers(gpio_tm1637_display_t *display)
+{
+    uint8_t *transfer = NULL;
+    int last = -2;
+
+    display->transfer_num = 0;
+    if (!display->shown_valid)
+    {
+        display->transfers[0][0] = GPIO_TM1637_CMD_DATA;
+        display->transfer_len[0] = 1;
+        display->transfer_num = 1;
+    }
+
+    for (uint8_t i = 0; i < display->digits; i++)
+    {
+        if ((display->shown_valid) && (display->pending[i] == display->shown[i]))
+        {
+            continue;
+        }
+
+        // 与上一段相隔超过1位时开始新的一段, 否则把中间未变化的位一起发送
+        if ((last < 0) || (i - last > 2))
+        {
+            transfer = display->transfers[display->transfer_num];
+            transfer[0] = GPIO_TM1637_CMD_ADDRESS | i;
+            display->transfer_len[display->transfer_num] = 1;
+            display->transfer_num++;
+            last = i - 1;
+        }
+
+        for (uint8_t j = (uint8_t)(last + 1); j <= i; j++)
+        {
+            transfer[display->transfer_len[display->transfer_num - 1]++] = display->pending[j];
+        }
+
+        last = i;
+    }
+
+    if ((display->ctrl_dirty) || (!display->shown_valid))
+    {
+        display->transfers[display->transfer_num][0] =
+            display->on ? (GPIO_TM1637_CMD_DISPLAY_ON | display->brightness) : GPIO_TM1637_CMD_DISPLAY_OFF;
+        display->transfer_len[display->transfer_num] = 1;
+        display->transfer_num++;
+    }
+}
+
+/**
+ * @brief  同时执行所有数码管的第n个传输: 同时起始, 逐字节同时发送, 字节较少的数码管提前停止后保持空闲
+ * @note   DIO保持高电平时CLK脉冲不构成起始/停止条件, 芯片忽略
+ * @param  nack: 输入输出参数, 未应答的数码管掩码(按数码管序号)
+ * @param  tm  : 输入参数, TM1637驱动
+ * @param  n   : 输入参数, 传输序号
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_tm1637_transfer(uint64_t *nack, gpio_tm1637_t *tm, const uint8_t n)
+{
+    gpio_tm1637_display_t *display = NULL;
+    uint64_t current = tm->dio_mask;
+    uint64_t active = 0;
+    uint64_t byte_mask = 0;
+    uint64_t stop_mask = 0;
+    uint64_t low = 0;
+    uint64_t failed = 0;
+    uint8_t max_len = 0;
+
+    for (uint8_t i = 0; i < tm->display_num; i++)
+    {
+        display = &tm->displays[i];
+        if (n < display->transfer_num)
+        {
+            active |= (1ULL << display->dio);
+            if (display->transfer_len[n] > max_len)
+            {
+                max_len = display->transfer_len[n];
+            }
+        }
+    }
+
+    if (0 == active)
+    {
+        return true;
+    }
+
+    // 起始条件: CLK高电平时DIO下降
+    if (!gpio_tm1637_append_cell(tm, &current, current, current & ~active))
+    {
+        return false;
+    }
+
+    for (uint8_t j = 0; j <= max_len; j++)
+    {
+        byte_mask = 0;
+        stop_mask = 0;
+        for (uint8_t i = 0; i < tm->display_num; i++)
+        {
+            display = &tm->displays[i];
+            if (n >= display->transfer_num)
+            {
+                continue;
+            }
+
+            if (j < display->transfer_len[n])
+            {
+                byte_mask |= (1ULL << display->dio);
+            }
+            else if (j == display->transfer_len[n])
+            {
+                stop_mask |= (1ULL << display->dio);
+            }
+        }
+
+        // 8个数据位(LSB优先), 停止条件放在第1个时钟: CLK低电平时DIO为低, CLK高电平时DIO上升
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            low = current & ~(byte_mask | ((0 == bit) ? stop_mask : 0));
+            for (uint8_t i = 0; i < tm->display_num; i++)
+            {
+                display = &tm->displays[i];
+                if ((byte_mask & (1ULL << display->dio)) && ((display->transfers[n][j] >> bit) & 1))
+                {
+                    low |= (1ULL << display->dio);
+                }
+            }
+
+            if (!gpio_tm1637_append_cell(tm, &current, low, low | (0 == bit ? stop_mask : 0)))
+            {
+                return false;
+            }
+
+            if (0 == byte_mask)
+            {
+                break;
+            }
+        }
+
+        if (0 == byte_mask)
+        {
+            break;
+        }
+
+        // 应答时钟
+        if (tm->config.check_ack)
+        {
+            if (!gpio_tm1637_check_ack(&failed, tm, byte_mask))
+            {
+                return false;
+            }
+
+            current &= ~byte_mask;
+            for (uint8_t i = 0; i < tm->display_num; i++)
+            {
+                if (failed & (1ULL << tm->displays[i].dio))
+                {
+                    *nack |= (1ULL << i);
+                }
+            }
+        }
+        else
+        {
+            // 第8位为1时DIO仍为高电平, 先清除, CLK下降与DIO下降在同一次写入, 不与芯片的应答冲突
+            current &= ~byte_mask;
+            if (!gpio_tm1637_append_cell(tm, &current, current, current))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  初始化TM1637驱动, CLK和DIO输出高电平(总线空闲)
+ * @param  tm    : 输出参数, TM1637驱动
+ * @param  config: 输入参数, TM1637配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_init(gpio_tm1637_t *tm, const gpio_tm1637_config_t *config)
+{
+    uint64_t clk = 0;
+
+    if ((!tm) || (!config) || (!config->group) || (config->clk >= config->group->num))
+    {
+        return false;
+    }
+
+    memset(tm, 0, sizeof(gpio_tm1637_t));
+    tm->config = *config;
+    if (0 == tm->config.half_period_ns)
+    {
+        tm->config.half_period_ns = GPIO_TM1637_DEFAULT_HALF_PERIOD_NS;
+    }
+
+    clk = 1ULL << config->clk;
+    if (!gpio_pattern_init(&tm->pattern, clk, 0))
+    {
+        return false;
+    }
+
+    if ((!gpio_group_set_direction(config->group, clk, E_GPIO_OUT, clk)) ||
+        (!gpio_group_set_values(config->group, clk, clk)))
+    {
+        gpio_pattern_deinit(&tm->pattern);
+
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  释放TM1637驱动(不关闭GPIO组)
+ * @param  tm: 输入参数, TM1637驱动
+ */
+void gpio_tm1637_deinit(gpio_tm1637_t *tm)
+{
+    if (!tm)
+    {
+        return;
+    }
+
+    gpio_pattern_deinit(&tm->pattern);
+}
+
+/**
+ * @brief  添加数码管, 初始为全灭、亮度7、显示打开, 第一次刷新时写入全部位
+ * @param  tm    : 输入参数, TM1637驱动
+ * @param  dio   : 输入参数, DIO在GPIO组内的序号
+ * @param  digits: 输入参数, 位数[1, GPIO_TM1637_MAX_DIGITS]
+ * @return 成功: 数码管序号
+ *         失败: -1
+ */
+int gpio_tm1637_add_display(gpio_tm1637_t *tm, const uint8_t dio, const uint8_t digits)
+{
+    gpio_tm1637_display_t *display = NULL;
+    uint64_t bit = 0;
+
+    if ((!tm) || (tm->display_num >= GPIO_TM1637_MAX_DISPLAYS) || (dio >= tm->config.group->num) ||
+        (dio == tm->config.clk) || (0 == digits) || (digits > GPIO_TM1637_MAX_DIGITS))
+    {
+        return -1;
+    }
+
+    bit = 1ULL << dio;
+    if ((tm->dio_mask & bit) || (!gpio_group_set_direction(tm->config.group, bit, E_GPIO_OUT, bit)) ||
+        (!gpio_group_set_values(tm->config.group, bit, bit)))
+    {
+        return -1;
+    }
+
+    display = &tm->displays[tm->display_num];
+    memset(display, 0, sizeof(gpio_tm1637_display_t));
+    display->dio = dio;
+    display->digits = digits;
+    display->brightness = 7;
+    display->on = true;
+    display->ctrl_dirty = true;
+    tm->dio_mask |= bit;
+    tm->pattern.mask |= bit;
+
+    return tm->display_num++;
+}
+
+/**
+ * @brief  设置待显示的段码(只更新缓存, 由gpio_tm1637_refresh发送)
+ * @param  tm      : 输入参数, TM1637驱动
+ * @param  index   : 输入参数, 数码管序号
+ * @param  pos     : 输入参数, 起始位
+ * @param  segments: 输入参数, 段码(bit0~bit6为a~g, bit7为小数点)
+ * @param  num     : 输入参数, 个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_set_segments(gpio_tm1637_t *tm, const uint8_t index, const uint8_t pos, const uint8_t *segments,
+                              const uint8_t num)
+{
+    if ((!tm) || (!segments) || (index >= tm->display_num) || (pos + num > tm->displays[index].digits))
+    {
+        return false;
+    }
+
+    memcpy(&tm->displays[index].pending[pos], segments, num);
+
+    return true;
+}
+
+/**
+ * @brief  设置待显示的文本(只更新缓存), 支持0~9、A~F、'-'和空格, '.'点亮前一位的小数点, 不足的位熄灭
+ * @param  tm   : 输入参数, TM1637驱动
+ * @param  index: 输入参数, 数码管序号
+ * @param  text : 输入参数, 文本
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_set_text(gpio_tm1637_t *tm, const uint8_t index, const char *text)
+{
+    uint8_t segments[GPIO_TM1637_MAX_DIGITS] = {0};
+    uint8_t pos = 0;
+
+    if ((!tm) || (!text) || (index >= tm->display_num))
+    {
+        return false;
+    }
+
+    for (const char *c = text; '\0' != *c; c++)
+    {
+        if (('.' == *c) && (0 != pos) && (!(segments[pos - 1] & GPIO_TM1637_SEG_DP)))
+        {
+            segments[pos - 1] |= GPIO_TM1637_SEG_DP;
+
+            continue;
+        }
+
+        if (pos >= tm->displays[index].digits)
+        {
+            return false;
+        }
+
+        segments[pos++] = ('.' == *c) ? GPIO_TM1637_SEG_DP : gpio_tm1637_encode(*c);
+    }
+
+    return gpio_tm1637_set_segments(tm, index, 0, segments, tm->displays[index].digits);
+}
+
+/**
+ * @brief  设置亮度和显示开关(只更新缓存)
+ * @param  tm        : 输入参数, TM1637驱动
+ * @param  index     : 输入参数, 数码管序号
+ * @param  brightness: 输入参数, 亮度[0, 7]
+ * @param  on        : 输入参数, 显示开关
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_set_brightness(gpio_tm1637_t *tm, const uint8_t index, const uint8_t brightness, const bool on)
+{
+    gpio_tm1637_display_t *display = NULL;
+
+    if ((!tm) || (index >= tm->display_num) || (brightness > 7))
+    {
+        return false;
+    }
+
+    display = &tm->displays[index];
+    if ((brightness != display->brightness) || (on != display->on))
+    {
+        display->brightness = brightness;
+        display->on = on;
+        display->ctrl_dirty = true;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  刷新全部数码管: 每个数码管只发送变化的位, 所有数码管共用CLK同时传输, 每个时钟一次批量设置
+ * @param  tm: 输入参数, TM1637驱动
+ * @return true : 成功(检查应答时, 应答错误的数码管下次刷新全部位, 并计入ack_errors)
+ * @return false: 失败
+ */
+bool gpio_tm1637_refresh(gpio_tm1637_t *tm)
+{
+    gpio_tm1637_display_t *display = NULL;
+    uint64_t nack = 0;
+    uint8_t transfer_num = 0;
+    bool ret = true;
+
+    if (!tm)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < tm->display_num; i++)
+    {
+        display = &tm->displays[i];
+        gpio_tm1637_build_transfers(display);
+        if (display->transfer_num > transfer_num)
+        {
+            transfer_num = display->transfer_num;
+        }
+    }
+
+    for (uint8_t n = 0; (ret) && (n < transfer_num); n++)
+    {
+        ret = gpio_tm1637_transfer(&nack, tm, n);
+    }
+
+    ret = ret && gpio_tm1637_play(tm);
+    gpio_pattern_clear(&tm->pattern);
+    for (uint8_t i = 0; i < tm->display_num; i++)
+    {
+        display = &tm->displays[i];
+        if (0 == display->transfer_num)
+        {
+            continue;
+        }
+
+        // 失败或未应答时不确定芯片中的内容, 下次全部重写
+        if ((!ret) || (nack & (1ULL << i)))
+        {
+            display->ack_errors += (nack & (1ULL << i)) ? 1 : 0;
+            display->shown_valid = false;
+
+            continue;
+        }
+
+        for (uint8_t n = 0; n < display->transfer_num; n++)
+        {
+            tm->bytes += display->transfer_len[n];
+        }
+
+        memcpy(display->shown, display->pending, sizeof(display->shown));
+        display->shown_valid = true;
+        display->ctrl_dirty = false;
+    }
+
+    tm->refreshes++;
+
+    return ret;
+}
+
+/**
+ * @brief  字符转换为段码
+ * @param  c: 输入参数, 字符, 支持0~9、A~F(不区分大小写)、'-'和空格
+ * @return 段码, 不支持的字符为0(熄灭)
+ */
+uint8_t gpio_tm1637_encode(const char c)
+{
+    if ((c >= '0') && (c <= '9'))
+    {
+        return gpio_tm1637_hex_segments[c - '0'];
+    }
+
+    if ((c >= 'A') && (c <= 'F'))
+    {
+        return gpio_tm1637_hex_segments[c - 'A' + 10];
+    }
+
+    if ((c >= 'a') && (c <= 'f'))
+    {
+        return gpio_tm1637_hex_segments[c - 'a' + 10];
+    }
+
+    if ('-' == c)
+    {
+        return 0x40;
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file      : gpio_tm1637.h
+ * @brief     : TM1637两线LED数码管驱动头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-19 10:05:14
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-19 huenrong        创建文件
+ *              2026-10-19 huenrong        应答时钟的CLK下降与DIO输出低电平在同一次写入
+ *
+ */
+
+#ifndef __GPIO_TM1637_H
+#define __GPIO_TM1637_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "./gpio_group.h"
+#include "./gpio_pattern.h"
+
+// 共用一个CLK的最多数码管个数(GPIO组除CLK外的GPIO)
+#define GPIO_TM1637_MAX_DISPLAYS (GPIO_GROUP_MAX_NUM - 1)
+
+// 每个数码管最多的位数
+#define GPIO_TM1637_MAX_DIGITS 6
+
+// 一次刷新中每个数码管最多的传输个数(数据命令、两段地址连续的段码、显示控制命令)
+#define GPIO_TM1637_MAX_TRANSFERS 4
+
+// 一个传输最多的字节个数(地址命令 + 段码)
+#define GPIO_TM1637_MAX_TRANSFER_BYTES (GPIO_TM1637_MAX_DIGITS + 1)
+
+// 默认CLK半周期, 单位: ns
+#define GPIO_TM1637_DEFAULT_HALF_PERIOD_NS 2000
+
+// 段码中的小数点
+#define GPIO_TM1637_SEG_DP 0x80
+
+// TM1637配置
+typedef struct
+{
+    // GPIO组(CLK和各数码管的DIO, 打开为输出)
+    gpio_group_t *group;
+    // CLK在GPIO组内的序号
+    uint8_t clk;
+    // CLK半周期, 单位: ns, 0表示使用GPIO_TM1637_DEFAULT_HALF_PERIOD_NS
+    uint64_t half_period_ns;
+    // 是否检查应答: true: 应答时钟释放DIO并读取, false: 应答时钟主机也输出低电平, 整次刷新为一个波形;
+    // 芯片在第8个CLK下降沿拉低DIO应答, 两种方式都在CLK下降的同一次写入中把DIO输出低电平, 不与芯片冲突
+    bool check_ack;
+} gpio_tm1637_config_t;
+
+// 单个数码管
+typedef struct
+{
+    // DIO在GPIO组内的序号
+    uint8_t dio;
+    // 位数
+    uint8_t digits;
+    // 亮度[0, 7]
+    uint8_t brightness;
+    // 显示开关
+    bool on;
+    // 待显示的段码
+    uint8_t pending[GPIO_TM1637_MAX_DIGITS];
+    // 芯片中当前的段码
+    uint8_t shown[GPIO_TM1637_MAX_DIGITS];
+    // shown有效, 为false时下次刷新写入全部位
+    bool shown_valid;
+    // 亮度/开关待写入
+    bool ctrl_dirty;
+    // 本次刷新的传输(起始 + 字节 + 停止), 各数码管的第n个传输同时开始
+    uint8_t transfers[GPIO_TM1637_MAX_TRANSFERS][GPIO_TM1637_MAX_TRANSFER_BYTES];
+    uint8_t transfer_len[GPIO_TM1637_MAX_TRANSFERS];
+    uint8_t transfer_num;
+    // 应答错误次数
+    uint64_t ack_errors;
+} gpio_tm1637_display_t;
+
+// 共用一个CLK的一组TM1637
+typedef struct
+{
+    gpio_tm1637_config_t config;
+    gpio_tm1637_display_t displays[GPIO_TM1637_MAX_DISPLAYS];
+    uint8_t display_num;
+    // 全部DIO的掩码
+    uint64_t dio_mask;
+    // 刷新时编译的波形
+    gpio_pattern_t pattern;
+    // 刷新次数
+    uint64_t refreshes;
+    // 已发送的字节个数(各数码管累计)
+    uint64_t bytes;
+} gpio_tm1637_t;
+
+/**
+ * @brief  初始化TM1637驱动, CLK和DIO输出高电平(总线空闲)
+ * @param  tm    : 输出参数, TM1637驱动
+ * @param  config: 输入参数, TM1637配置
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_init(gpio_tm1637_t *tm, const gpio_tm1637_config_t *config);
+
+/**
+ * @brief  释放TM1637驱动(不关闭GPIO组)
+ * @param  tm: 输入参数, TM1637驱动
+ */
+void gpio_tm1637_deinit(gpio_tm1637_t *tm);
+
+/**
+ * @brief  添加数码管, 初始为全灭、亮度7、显示打开, 第一次刷新时写入全部位
+ * @param  tm    : 输入参数, TM1637驱动
+ * @param  dio   : 输入参数, DIO在GPIO组内的序号
+ * @param  digits: 输入参数, 位数[1, GPIO_TM1637_MAX_DIGITS]
+ * @return 成功: 数码管序号
+ *         失败: -1
+ */
+int gpio_tm1637_add_display(gpio_tm1637_t *tm, const uint8_t dio, const uint8_t digits);
+
+/**
+ * @brief  设置待显示的段码(只更新缓存, 由gpio_tm1637_refresh发送)
+ * @param  tm      : 输入参数, TM1637驱动
+ * @param  index   : 输入参数, 数码管序号
+ * @param  pos     : 输入参数, 起始位
+ * @param  segments: 输入参数, 段码(bit0~bit6为a~g, bit7为小数点)
+ * @param  num     : 输入参数, 个数
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_set_segments(gpio_tm1637_t *tm, const uint8_t index, const uint8_t pos, const uint8_t *segments,
+                              const uint8_t num);
+
+/**
+ * @brief  设置待显示的文本(只更新缓存), 支持0~9、A~F、'-'和空格, '.'点亮前一位的小数点, 不足的位熄灭
+ * @param  tm   : 输入参数, TM1637驱动
+ * @param  index: 输入参数, 数码管序号
+ * @param  text : 输入参数, 文本
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_set_text(gpio_tm1637_t *tm, const uint8_t index, const char *text);
+
+/**
+ * @brief  设置亮度和显示开关(只更新缓存)
+ * @param  tm        : 输入参数, TM1637驱动
+ * @param  index     : 输入参数, 数码管序号
+ * @param  brightness: 输入参数, 亮度[0, 7]
+ * @param  on        : 输入参数, 显示开关
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_tm1637_set_brightness(gpio_tm1637_t *tm, const uint8_t index, const uint8_t brightness, const bool on);
+
+/**
+ * @brief  刷新全部数码管: 每个数码管只发送变化的位, 所有数码管共用CLK同时传输, 每个时钟一次批量设置
+ * @param  tm: 输入参数, TM1637驱动
+ * @return true : 成功(检查应答时, 应答错误的数码管下次刷新全部位, 并计入ack_errors)
+ * @return false: 失败
+ */
+bool gpio_tm1637_refresh(gpio_tm1637_t *tm);
+
+/**
+ * @brief  字符转换为段码
+ * @param  c: 输入参数, 字符, 支持0~9、A~F(不区分大小写)、'-'和空格
+ * @return 段码, 不支持的字符为0(熄灭)
+ */
+uint8_t gpio_tm1637_encode(const char c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_TM1637_H
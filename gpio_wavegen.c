@@ -0,0 +1,482 @@
+/**
+ * @file      : gpio_wavegen.c
+ * @brief     : GPIO多通道方波发生器源文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 16:47:12
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-19 huenrong        增加带死区的互补PWM通道
+ *
+ */
+
+#include <string.h>
+
+#include "./gpio_wavegen.h"
+
+// 互补通道的阶段: 上管导通、上管关断、下管导通、两路关断
+#define GPIO_WAVEGEN_HIGH_ON 0
+#define GPIO_WAVEGEN_HIGH_OFF 1
+#define GPIO_WAVEGEN_LOW_ON 2
+#define GPIO_WAVEGEN_LOW_OFF 3
+
+static void gpio_wavegen_toggled(gpio_timer_t *timer, const gpio_timer_action_t *action, const int64_t error_ns,
+                                 void *arg);
+
+/**
+ * @brief  通道输出的GPIO掩码
+ * @param  channel: 输入参数, 通道配置
+ * @return GPIO掩码
+ */
+static uint64_t gpio_wavegen_pins(const gpio_wavegen_channel_t *channel)
+{
+    uint64_t pins = 1ULL << channel->index;
+
+    if (channel->complementary)
+    {
+        pins |= 1ULL << channel->complement_index;
+    }
+
+    return pins;
+}
+
+/**
+ * @brief  安排通道的一次翻转(调用前需持有发生器的锁)
+ * @param  slot       : 输入参数, 通道运行状态
+ * @param  deadline_ns: 输入参数, 翻转时刻, 单位: ns
+ * @param  level      : 输入参数, 翻转后的电平
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_wavegen_schedule(gpio_wavegen_slot_t *slot, const uint64_t deadline_ns, const gpio_value_e level)
+{
+    gpio_wavegen_channel_t *channel = &slot->wavegen->channels[slot->index];
+    gpio_timer_action_t action = {0};
+    uint64_t bit = 1ULL << channel->index;
+
+    action.deadline_ns = deadline_ns;
+    action.group = channel->group;
+    action.mask = bit;
+    action.values = (E_GPIO_HIGH == level) ? bit : 0;
+    action.callback = gpio_wavegen_toggled;
+    action.arg = slot;
+    slot->timer_id = gpio_timer_schedule(slot->wavegen->timer, &action);
+
+    return (0 != slot->timer_id);
+}
+
+/**
+ * @brief  安排互补通道的下一个阶段(调用前需持有发生器的锁)
+ * @note   导通阶段不提前执行且不与同组更早的输出合并, 保证死区; 下管关断时上管同时写低, 作为安全状态
+ * @param  slot       : 输入参数, 通道运行状态
+ * @param  deadline_ns: 输入参数, 执行时刻, 单位: ns
+ * @param  phase      : 输入参数, 阶段
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpio_wavegen_schedule_phase(gpio_wavegen_slot_t *slot, const uint64_t deadline_ns, const uint8_t phase)
+{
+    gpio_wavegen_channel_t *channel = &slot->wavegen->channels[slot->index];
+    gpio_timer_action_t action = {0};
+    uint64_t high = 1ULL << channel->index;
+    uint64_t low = 1ULL << channel->complement_index;
+
+    action.deadline_ns = deadline_ns;
+    action.group = channel->group;
+    switch (phase)
+    {
+    case GPIO_WAVEGEN_HIGH_ON:
+    {
+        action.mask = high;
+        action.values = high;
+        action.barrier = true;
+        break;
+    }
+
+    case GPIO_WAVEGEN_HIGH_OFF:
+    {
+        action.mask = high;
+        break;
+    }
+
+    case GPIO_WAVEGEN_LOW_ON:
+    {
+        action.mask = low;
+        action.values = low;
+        action.barrier = true;
+        break;
+    }
+
+    default:
+    {
+        action.mask = high | low;
+        break;
+    }
+    }
+
+    action.callback = gpio_wavegen_toggled;
+    action.arg = slot;
+    slot->phase = phase;
+    slot->timer_id = gpio_timer_schedule(slot->wavegen->timer, &action);
+
+    return (0 != slot->timer_id);
+}
+
+/**
+ * @brief  互补通道的一个阶段执行完成, 安排下一个阶段(调用前需持有发生器的锁)
+ * @note   一路关断后另一路的导通时刻不早于关断写入完成后一个死区, 定时滞后时缩短导通时间而不缩短死区
+ * @param  slot   : 输入参数, 通道运行状态
+ * @param  action : 输入参数, 已执行的定时动作
+ * @param  done_ns: 输入参数, 输出完成时刻, 单位: ns
+ */
+static void gpio_wavegen_complementary(gpio_wavegen_slot_t *slot, const gpio_timer_action_t *action,
+                                       const uint64_t done_ns)
+{
+    gpio_wavegen_channel_t *channel = &slot->wavegen->channels[slot->index];
+    uint64_t period_ns = slot->high_ns + slot->low_ns;
+    uint64_t deadline_ns = 0;
+
+    switch (slot->phase)
+    {
+    case GPIO_WAVEGEN_HIGH_ON:
+    {
+        slot->level = E_GPIO_HIGH;
+        gpio_wavegen_schedule_phase(slot, slot->cycle_ns + slot->high_ns, GPIO_WAVEGEN_HIGH_OFF);
+        break;
+    }
+
+    case GPIO_WAVEGEN_HIGH_OFF:
+    {
+        slot->level = E_GPIO_LOW;
+        deadline_ns = slot->cycle_ns + slot->high_ns + channel->dead_ns;
+        if (done_ns + channel->dead_ns > deadline_ns)
+        {
+            deadline_ns = done_ns + channel->dead_ns;
+        }
+
+        gpio_wavegen_schedule_phase(slot, deadline_ns, GPIO_WAVEGEN_LOW_ON);
+        break;
+    }
+
+    case GPIO_WAVEGEN_LOW_ON:
+    {
+        deadline_ns = slot->cycle_ns + period_ns - channel->dead_ns;
+        if (action->deadline_ns > deadline_ns)
+        {
+            deadline_ns = action->deadline_ns;
+        }
+
+        gpio_wavegen_schedule_phase(slot, deadline_ns, GPIO_WAVEGEN_LOW_OFF);
+        break;
+    }
+
+    default:
+    {
+        slot->cycle_ns += period_ns;
+        deadline_ns = slot->cycle_ns;
+        if (done_ns + channel->dead_ns > deadline_ns)
+        {
+            deadline_ns = done_ns + channel->dead_ns;
+        }
+
+        gpio_wavegen_schedule_phase(slot, deadline_ns, GPIO_WAVEGEN_HIGH_ON);
+        break;
+    }
+    }
+}
+
+/**
+ * @brief  通道翻转完成, 以本次截止时刻(而不是实际时刻)为基准安排下一次翻转, 不累积误差
+ * @param  timer   : 输入参数, 定时引擎
+ * @param  action  : 输入参数, 已执行的定时动作
+ * @param  error_ns: 输入参数, 实际输出时刻与截止时刻的偏差, 单位: ns
+ * @param  arg     : 输入参数, 通道运行状态
+ */
+static void gpio_wavegen_toggled(gpio_timer_t *timer, const gpio_timer_action_t *action, const int64_t error_ns,
+                                 void *arg)
+{
+    gpio_wavegen_slot_t *slot = (gpio_wavegen_slot_t *)arg;
+    gpio_wavegen_t *wavegen = slot->wavegen;
+
+    (void)timer;
+
+    pthread_mutex_lock(&wavegen->mutex);
+    if ((!wavegen->running) || (action->id != slot->timer_id))
+    {
+        pthread_mutex_unlock(&wavegen->mutex);
+
+        return;
+    }
+
+    slot->toggles++;
+    if (error_ns > slot->max_error_ns)
+    {
+        slot->max_error_ns = error_ns;
+    }
+
+    if (wavegen->channels[slot->index].complementary)
+    {
+        gpio_wavegen_complementary(slot, action,
+                                   (error_ns > 0) ? (action->deadline_ns + (uint64_t)error_ns) : action->deadline_ns);
+        pthread_mutex_unlock(&wavegen->mutex);
+
+        return;
+    }
+
+    slot->level = (0 != action->values) ? E_GPIO_HIGH : E_GPIO_LOW;
+    if (E_GPIO_HIGH == slot->level)
+    {
+        gpio_wavegen_schedule(slot, action->deadline_ns + slot->high_ns, E_GPIO_LOW);
+    }
+    else
+    {
+        gpio_wavegen_schedule(slot, action->deadline_ns + slot->low_ns, E_GPIO_HIGH);
+    }
+
+    pthread_mutex_unlock(&wavegen->mutex);
+}
+
+/**
+ * @brief  初始化方波发生器
+ * @param  wavegen: 输出参数, 方波发生器
+ * @param  timer  : 输入参数, 已启动的定时引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_init(gpio_wavegen_t *wavegen, gpio_timer_t *timer)
+{
+    if ((!wavegen) || (!timer))
+    {
+        return false;
+    }
+
+    memset(wavegen, 0, sizeof(gpio_wavegen_t));
+    if (0 != pthread_mutex_init(&wavegen->mutex, NULL))
+    {
+        return false;
+    }
+
+    wavegen->timer = timer;
+
+    return true;
+}
+
+/**
+ * @brief  销毁方波发生器(运行中时先停止)
+ * @param  wavegen: 输入参数, 方波发生器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_deinit(gpio_wavegen_t *wavegen)
+{
+    if (!wavegen)
+    {
+        return false;
+    }
+
+    gpio_wavegen_stop(wavegen);
+    pthread_mutex_destroy(&wavegen->mutex);
+
+    return true;
+}
+
+/**
+ * @brief  添加方波通道, 只能在停止状态下添加
+ * @note   互补通道的下管导通时间(低电平时间减去两个死区)必须大于0, 两路GPIO不能被其他通道使用
+ * @param  wavegen: 输入参数, 方波发生器
+ * @param  channel: 输入参数, 通道配置
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_wavegen_add_channel(gpio_wavegen_t *wavegen, const gpio_wavegen_channel_t *channel)
+{
+    gpio_wavegen_slot_t *slot = NULL;
+    uint64_t period_ns = 0;
+    uint8_t duty = 0;
+    uint8_t index = 0;
+
+    if ((!wavegen) || (!channel) || (wavegen->running) || (wavegen->channel_num >= GPIO_WAVEGEN_MAX_CHANNELS))
+    {
+        return -1;
+    }
+
+    if ((!channel->group) || (channel->index >= channel->group->num) || (channel->frequency_hz <= 0) ||
+        (channel->duty_percent > 99))
+    {
+        return -1;
+    }
+
+    if ((channel->complementary) &&
+        ((channel->complement_index >= channel->group->num) || (channel->complement_index == channel->index) ||
+         (0 == channel->dead_ns)))
+    {
+        return -1;
+    }
+
+    // 互补通道的两路不能再被其他通道输出, 否则无法保证不同时导通
+    for (uint8_t i = 0; i < wavegen->channel_num; i++)
+    {
+        if ((wavegen->channels[i].group == channel->group) &&
+            (gpio_wavegen_pins(&wavegen->channels[i]) & gpio_wavegen_pins(channel)) &&
+            ((wavegen->channels[i].complementary) || (channel->complementary)))
+        {
+            return -1;
+        }
+    }
+
+    // 周期至少2ns, 保证高低电平时间都不为0
+    period_ns = (uint64_t)(1000000000.0 / channel->frequency_hz + 0.5);
+    if (period_ns < 2)
+    {
+        return -1;
+    }
+
+    index = wavegen->channel_num;
+    duty = (0 == channel->duty_percent) ? 50 : channel->duty_percent;
+    wavegen->channels[index] = *channel;
+    slot = &wavegen->slots[index];
+    memset(slot, 0, sizeof(gpio_wavegen_slot_t));
+    slot->wavegen = wavegen;
+    slot->index = index;
+    slot->high_ns = period_ns * duty / 100;
+    if (0 == slot->high_ns)
+    {
+        slot->high_ns = 1;
+    }
+
+    slot->low_ns = period_ns - slot->high_ns;
+    if (0 == slot->low_ns)
+    {
+        slot->high_ns--;
+        slot->low_ns = 1;
+    }
+
+    if ((channel->complementary) && (slot->low_ns <= 2 * channel->dead_ns))
+    {
+        return -1;
+    }
+
+    slot->level = channel->complementary ? E_GPIO_LOW : channel->idle_level;
+    wavegen->channel_num++;
+
+    return index;
+}
+
+/**
+ * @brief  启动所有通道, 各通道以同一起始时刻为基准, 频率成整数倍的通道翻转时刻重合
+ * @param  wavegen : 输入参数, 方波发生器
+ * @param  start_ns: 输入参数, 起始时刻(CLOCK_MONOTONIC), 单位: ns, 0表示当前时刻后1ms
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_start(gpio_wavegen_t *wavegen, const uint64_t start_ns)
+{
+    uint64_t epoch_ns = start_ns;
+    bool ret = true;
+
+    if (!wavegen)
+    {
+        return false;
+    }
+
+    if (0 == epoch_ns)
+    {
+        epoch_ns = gpio_timer_now_ns() + 1000000ULL;
+    }
+
+    pthread_mutex_lock(&wavegen->mutex);
+    if (wavegen->running)
+    {
+        pthread_mutex_unlock(&wavegen->mutex);
+
+        return false;
+    }
+
+    wavegen->running = true;
+    for (uint8_t i = 0; i < wavegen->channel_num; i++)
+    {
+        // 每个周期从高电平开始
+        wavegen->slots[i].toggles = 0;
+        wavegen->slots[i].max_error_ns = 0;
+        if (wavegen->channels[i].complementary)
+        {
+            // 先两路关断, 一个死区后上管导通, 第一个周期从起始时刻开始
+            wavegen->slots[i].cycle_ns =
+                epoch_ns + wavegen->channels[i].phase_ns - wavegen->slots[i].high_ns - wavegen->slots[i].low_ns;
+            if (!gpio_wavegen_schedule_phase(&wavegen->slots[i],
+                                             epoch_ns + wavegen->channels[i].phase_ns - wavegen->channels[i].dead_ns,
+                                             GPIO_WAVEGEN_LOW_OFF))
+            {
+                ret = false;
+            }
+
+            continue;
+        }
+
+        if (!gpio_wavegen_schedule(&wavegen->slots[i], epoch_ns + wavegen->channels[i].phase_ns, E_GPIO_HIGH))
+        {
+            ret = false;
+        }
+    }
+
+    pthread_mutex_unlock(&wavegen->mutex);
+
+    if (!ret)
+    {
+        gpio_wavegen_stop(wavegen);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  停止所有通道, 输出恢复为空闲电平
+ * @param  wavegen: 输入参数, 方波发生器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_stop(gpio_wavegen_t *wavegen)
+{
+    gpio_wavegen_channel_t *channel = NULL;
+    gpio_timer_action_t action = {0};
+    uint64_t now_ns = 0;
+
+    if (!wavegen)
+    {
+        return false;
+    }
+
+    pthread_mutex_lock(&wavegen->mutex);
+    if (!wavegen->running)
+    {
+        pthread_mutex_unlock(&wavegen->mutex);
+
+        return true;
+    }
+
+    wavegen->running = false;
+    now_ns = gpio_timer_now_ns();
+    for (uint8_t i = 0; i < wavegen->channel_num; i++)
+    {
+        if (0 != wavegen->slots[i].timer_id)
+        {
+            gpio_timer_cancel(wavegen->timer, wavegen->slots[i].timer_id);
+            wavegen->slots[i].timer_id = 0;
+        }
+
+        // 空闲电平同样由定时线程输出, 同一截止时刻合并为一次批量设置
+        channel = &wavegen->channels[i];
+        action.deadline_ns = now_ns;
+        action.group = channel->group;
+        action.mask = gpio_wavegen_pins(channel);
+        action.values = ((!channel->complementary) && (E_GPIO_HIGH == channel->idle_level)) ? action.mask : 0;
+        gpio_timer_schedule(wavegen->timer, &action);
+        wavegen->slots[i].level = channel->complementary ? E_GPIO_LOW : channel->idle_level;
+    }
+
+    pthread_mutex_unlock(&wavegen->mutex);
+
+    return true;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file      : gpio_wavegen.h
+ * @brief     : GPIO多通道方波发生器头文件
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 16:47:12
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-19 huenrong        增加带死区的互补PWM通道
+ *
+ */
+
+#ifndef __GPIO_WAVEGEN_H
+#define __GPIO_WAVEGEN_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "./gpio_group.h"
+#include "./gpio_timer.h"
+
+// 方波发生器最多的通道数
+#define GPIO_WAVEGEN_MAX_CHANNELS 64
+
+// 方波通道配置
+typedef struct
+{
+    // 输出GPIO组(只由定时线程写入)
+    gpio_group_t *group;
+    // 输出GPIO组内序号
+    uint8_t index;
+    // 频率, 单位: Hz
+    double frequency_hz;
+    // 占空比[1, 99], 单位: %, 0表示50%
+    uint8_t duty_percent;
+    // 相对发生器起始时刻的相位延时, 单位: ns
+    uint64_t phase_ns;
+    // 停止后的空闲电平(互补通道固定为两路都低)
+    gpio_value_e idle_level;
+    // 互补通道(半桥): index为上管, complement_index为下管, 高电平导通, 两路在同一GPIO组中
+    bool complementary;
+    uint8_t complement_index;
+    // 死区时间, 单位: ns, 一路关断写入完成后至少经过该时间另一路才导通
+    uint64_t dead_ns;
+} gpio_wavegen_channel_t;
+
+typedef struct gpio_wavegen gpio_wavegen_t;
+
+// 通道运行状态
+typedef struct
+{
+    gpio_wavegen_t *wavegen;
+    uint8_t index;
+    // 高电平时间, 单位: ns
+    uint64_t high_ns;
+    // 低电平时间, 单位: ns
+    uint64_t low_ns;
+    // 当前输出电平
+    gpio_value_e level;
+    // 互补通道: 已安排的阶段(上管导通/上管关断/下管导通/下管关断)和当前周期的起始时刻, 单位: ns
+    uint8_t phase;
+    uint64_t cycle_ns;
+    // 下一次翻转的定时动作标识
+    uint32_t timer_id;
+    // 已翻转次数
+    uint64_t toggles;
+    // 最大滞后, 单位: ns
+    int64_t max_error_ns;
+} gpio_wavegen_slot_t;
+
+// 多通道方波发生器, 所有通道的翻转共用一个定时引擎, 同一时刻的翻转合并为一次批量设置
+struct gpio_wavegen
+{
+    // 执行输出的定时引擎
+    gpio_timer_t *timer;
+    // 保护运行标志和定时动作标识, 与定时回调互斥
+    pthread_mutex_t mutex;
+    bool running;
+    gpio_wavegen_channel_t channels[GPIO_WAVEGEN_MAX_CHANNELS];
+    gpio_wavegen_slot_t slots[GPIO_WAVEGEN_MAX_CHANNELS];
+    uint8_t channel_num;
+};
+
+/**
+ * @brief  初始化方波发生器
+ * @param  wavegen: 输出参数, 方波发生器
+ * @param  timer  : 输入参数, 已启动的定时引擎
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_init(gpio_wavegen_t *wavegen, gpio_timer_t *timer);
+
+/**
+ * @brief  销毁方波发生器(运行中时先停止)
+ * @param  wavegen: 输入参数, 方波发生器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_deinit(gpio_wavegen_t *wavegen);
+
+/**
+ * @brief  添加方波通道, 只能在停止状态下添加
+ * @note   互补通道的下管导通时间(低电平时间减去两个死区)必须大于0, 两路GPIO不能被其他通道使用
+ * @param  wavegen: 输入参数, 方波发生器
+ * @param  channel: 输入参数, 通道配置
+ * @return 成功: 通道序号
+ *         失败: -1
+ */
+int gpio_wavegen_add_channel(gpio_wavegen_t *wavegen, const gpio_wavegen_channel_t *channel);
+
+/**
+ * @brief  启动所有通道, 各通道以同一起始时刻为基准, 频率成整数倍的通道翻转时刻重合
+ * @param  wavegen : 输入参数, 方波发生器
+ * @param  start_ns: 输入参数, 起始时刻(CLOCK_MONOTONIC), 单位: ns, 0表示当前时刻后1ms
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_start(gpio_wavegen_t *wavegen, const uint64_t start_ns);
+
+/**
+ * @brief  停止所有通道, 输出恢复为空闲电平
+ * @param  wavegen: 输入参数, 方波发生器
+ * @return true : 成功
+ * @return false: 失败
+ */
+bool gpio_wavegen_stop(gpio_wavegen_t *wavegen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GPIO_WAVEGEN_H
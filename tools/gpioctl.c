@@ -0,0 +1,695 @@
+/**
+ * @file      : gpioctl.c
+ * @brief     : GPIO命令行工具, 在一个进程内批量执行GPIO操作脚本并统计每步耗时
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 09:40:12
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *              2026-10-18 huenrong        支持GPIO字符设备后端
+ *              2026-10-18 huenrong        增加stats命令, 输出事件丢失统计
+ *              2026-10-18 huenrong        wait命令支持边沿/掩码过滤和纳秒超时
+ *              2026-10-19 huenrong        参数过多或行过长时报错, wait支持不超时
+ *
+ * 脚本格式(每行一条命令, 也可用';'分隔, '#'开头为注释):
+ *   open  <name> out <gpio[,gpio...]> [init]     打开输出GPIO组, init按位给出初始电平
+ *   open  <name> in  <gpio[,gpio...]> [edge] [n] 打开输入GPIO组, edge: none/rising/falling/both,
+ *                                                n为内核事件缓冲区大小(仅uAPI v2)
+ *   set   <name> <values> [mask]                 批量设置电平, 数值支持0x/0前缀
+ *   get   <name> [mask]                          批量获取电平
+ *   wait  <name> [timeout] [edge] [mask]         等待边沿事件, 默认任意GPIO的任意边沿, 超时省略或为负数时一直等待
+ *   sleep <duration>                             相对延时
+ *   until <time>                                 延时到脚本开始后的指定时刻
+ *   stats <name>                                 输出已读取/丢失的事件数
+ *   close <name>                                 关闭GPIO组
+ * GPIO列表可加芯片前缀使用字符设备后端, 如"gpiochip0:17,18"或"/dev/gpiochip0:17,18",
+ * 此时编号为芯片内偏移; 无前缀时为sysfs全局编号
+ * 时间支持ns/us/ms/s后缀, 无后缀按ms处理
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../gpio_group.h"
+
+// 最多同时打开的GPIO组数量
+#define GPIOCTL_MAX_GROUPS 16
+
+// GPIO组名称最大长度
+#define GPIOCTL_NAME_MAX_LEN 16
+
+// 脚本单行最大长度
+#define GPIOCTL_LINE_MAX_LEN 512
+
+// GPIO芯片路径最大长度
+#define GPIOCTL_CHIP_MAX_LEN 64
+
+// 单条命令最多参数个数
+#define GPIOCTL_MAX_ARGS 8
+
+// 已命名的GPIO组
+typedef struct
+{
+    char name[GPIOCTL_NAME_MAX_LEN];
+    bool used;
+    gpio_group_t group;
+} gpioctl_group_t;
+
+// 执行上下文
+typedef struct
+{
+    gpioctl_group_t groups[GPIOCTL_MAX_GROUPS];
+    // 脚本开始时刻, 单位: ns
+    uint64_t start_ns;
+    // 已执行步数
+    uint32_t step;
+    // 不输出每步耗时
+    bool quiet;
+} gpioctl_ctx_t;
+
+/**
+ * @brief  获取CLOCK_MONOTONIC当前时间
+ * @return 当前时间, 单位: ns
+ */
+static uint64_t gpioctl_now_ns(void)
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  绝对延时到指定时刻
+ * @param  deadline_ns: 输入参数, 目标时刻(CLOCK_MONOTONIC), 单位: ns
+ */
+static void gpioctl_sleep_until(const uint64_t deadline_ns)
+{
+    struct timespec ts = {0};
+
+    ts.tv_sec = (time_t)(deadline_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(deadline_ns % 1000000000ULL);
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL))
+    {
+    }
+}
+
+/**
+ * @brief  解析时间字符串
+ * @param  ns : 输出参数, 解析结果, 单位: ns
+ * @param  str: 输入参数, 时间字符串, 支持ns/us/ms/s后缀, 无后缀按ms处理
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpioctl_parse_duration(uint64_t *ns, const char *str)
+{
+    char *end = NULL;
+    double value = strtod(str, &end);
+
+    if ((end == str) || (value < 0))
+    {
+        return false;
+    }
+
+    if ((0 == strcmp(end, "")) || (0 == strcmp(end, "ms")))
+    {
+        *ns = (uint64_t)(value * 1000000.0);
+    }
+    else if (0 == strcmp(end, "ns"))
+    {
+        *ns = (uint64_t)value;
+    }
+    else if (0 == strcmp(end, "us"))
+    {
+        *ns = (uint64_t)(value * 1000.0);
+    }
+    else if (0 == strcmp(end, "s"))
+    {
+        *ns = (uint64_t)(value * 1000000000.0);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  解析无符号整数(支持0x/0前缀)
+ * @param  value: 输出参数, 解析结果
+ * @param  str  : 输入参数, 待解析字符串
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpioctl_parse_u64(uint64_t *value, const char *str)
+{
+    char *end = NULL;
+
+    errno = 0;
+    *value = strtoull(str, &end, 0);
+    if ((0 != errno) || (end == str) || ('\0' != *end))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  解析边沿字符串
+ * @param  edge: 输出参数, 解析结果
+ * @param  str : 输入参数, none/rising/falling/both
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpioctl_parse_edge(gpio_edge_e *edge, const char *str)
+{
+    if (0 == strcmp(str, "none"))
+    {
+        *edge = E_GPIO_NONE;
+    }
+    else if (0 == strcmp(str, "rising"))
+    {
+        *edge = E_GPIO_RISING;
+    }
+    else if (0 == strcmp(str, "falling"))
+    {
+        *edge = E_GPIO_FALLING;
+    }
+    else if (0 == strcmp(str, "both"))
+    {
+        *edge = E_GPIO_BOTH;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief  按名称查找GPIO组
+ * @param  ctx : 输入参数, 执行上下文
+ * @param  name: 输入参数, GPIO组名称
+ * @return 成功: GPIO组
+ *         失败: NULL
+ */
+static gpio_group_t *gpioctl_find_group(gpioctl_ctx_t *ctx, const char *name)
+{
+    for (int i = 0; i < GPIOCTL_MAX_GROUPS; i++)
+    {
+        if ((ctx->groups[i].used) && (0 == strcmp(ctx->groups[i].name, name)))
+        {
+            return &ctx->groups[i].group;
+        }
+    }
+
+    fprintf(stderr, "gpioctl: unknown group '%s'\n", name);
+
+    return NULL;
+}
+
+/**
+ * @brief  获取后端名称
+ * @param  backend: 输入参数, 后端
+ * @return 后端名称
+ */
+static const char *gpioctl_backend_name(const gpio_backend_e backend)
+{
+    switch (backend)
+    {
+    case E_GPIO_BACKEND_SYSFS:
+    {
+        return "sysfs";
+    }
+
+    case E_GPIO_BACKEND_CDEV_V2:
+    {
+        return "cdev-v2";
+    }
+
+    case E_GPIO_BACKEND_CDEV_V1:
+    {
+        return "cdev-v1";
+    }
+
+    default:
+    {
+        return "unknown";
+    }
+    }
+}
+
+/**
+ * @brief  执行open命令
+ * @param  ctx   : 输入参数, 执行上下文
+ * @param  argc  : 输入参数, 参数个数
+ * @param  argv  : 输入参数, 参数列表
+ * @param  result: 输出参数, 命令结果描述(实际使用的后端)
+ * @param  size  : 输入参数, result缓存大小
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpioctl_cmd_open(gpioctl_ctx_t *ctx, const int argc, char **argv, char *result, const size_t size)
+{
+    gpioctl_group_t *slot = NULL;
+    gpio_group_config_t config = {0};
+    uint16_t gpio_nums[GPIO_GROUP_MAX_NUM] = {0};
+    uint8_t num = 0;
+    uint64_t value = 0;
+    char chip[GPIOCTL_CHIP_MAX_LEN] = {0};
+    char *list = argv[3];
+    char *colon = NULL;
+    char *saveptr = NULL;
+    char *token = NULL;
+
+    if ((argc < 4) || (strlen(argv[1]) >= GPIOCTL_NAME_MAX_LEN))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < GPIOCTL_MAX_GROUPS; i++)
+    {
+        if ((ctx->groups[i].used) && (0 == strcmp(ctx->groups[i].name, argv[1])))
+        {
+            fprintf(stderr, "gpioctl: group '%s' already open\n", argv[1]);
+
+            return false;
+        }
+
+        if ((!slot) && (!ctx->groups[i].used))
+        {
+            slot = &ctx->groups[i];
+        }
+    }
+
+    if (!slot)
+    {
+        return false;
+    }
+
+    if (0 == strcmp(argv[2], "out"))
+    {
+        config.direction = E_GPIO_OUT;
+        if ((argc > 4) && (!gpioctl_parse_u64(&config.init_values, argv[4])))
+        {
+            return false;
+        }
+    }
+    else if (0 == strcmp(argv[2], "in"))
+    {
+        config.direction = E_GPIO_IN;
+        if ((argc > 4) && (!gpioctl_parse_edge(&config.edge, argv[4])))
+        {
+            return false;
+        }
+
+        if (argc > 5)
+        {
+            if ((!gpioctl_parse_u64(&value, argv[5])) || (value > UINT32_MAX))
+            {
+                return false;
+            }
+
+            config.event_buffer_size = (uint32_t)value;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    // 芯片前缀: gpiochipN:... 或 /dev/gpiochipN:...
+    colon = strchr(list, ':');
+    if (colon)
+    {
+        *colon = '\0';
+        snprintf(chip, sizeof(chip), "%s%s", ('/' == list[0]) ? "" : "/dev/", list);
+        config.chip = chip;
+        list = colon + 1;
+    }
+
+    for (token = strtok_r(list, ",", &saveptr); token; token = strtok_r(NULL, ",", &saveptr))
+    {
+        if ((num >= GPIO_GROUP_MAX_NUM) || (!gpioctl_parse_u64(&value, token)) || (value > UINT16_MAX))
+        {
+            return false;
+        }
+
+        gpio_nums[num++] = (uint16_t)value;
+    }
+
+    if (!gpio_group_open(&slot->group, gpio_nums, num, &config))
+    {
+        return false;
+    }
+
+    snprintf(slot->name, sizeof(slot->name), "%s", argv[1]);
+    slot->used = true;
+    snprintf(result, size, "%s", gpioctl_backend_name(slot->group.backend));
+
+    return true;
+}
+
+/**
+ * @brief  执行一条命令
+ * @param  ctx   : 输入参数, 执行上下文
+ * @param  argc  : 输入参数, 参数个数
+ * @param  argv  : 输入参数, 参数列表
+ * @param  result: 输出参数, 命令结果描述
+ * @param  size  : 输入参数, result缓存大小
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpioctl_exec(gpioctl_ctx_t *ctx, const int argc, char **argv, char *result, const size_t size)
+{
+    gpio_group_t *group = NULL;
+    gpio_event_t event = {0};
+    uint64_t values = 0;
+    uint64_t mask = UINT64_MAX;
+    uint64_t ns = 0;
+    int64_t timeout_ns = -1;
+    gpio_edge_e edge = E_GPIO_BOTH;
+
+    if (0 == strcmp(argv[0], "open"))
+    {
+        return gpioctl_cmd_open(ctx, argc, argv, result, size);
+    }
+    else if ((0 == strcmp(argv[0], "set")) && (argc >= 3))
+    {
+        group = gpioctl_find_group(ctx, argv[1]);
+        if ((!group) || (!gpioctl_parse_u64(&values, argv[2])) ||
+            ((argc > 3) && (!gpioctl_parse_u64(&mask, argv[3]))))
+        {
+            return false;
+        }
+
+        return gpio_group_set_values(group, mask, values);
+    }
+    else if ((0 == strcmp(argv[0], "get")) && (argc >= 2))
+    {
+        group = gpioctl_find_group(ctx, argv[1]);
+        if ((!group) || ((argc > 2) && (!gpioctl_parse_u64(&mask, argv[2]))))
+        {
+            return false;
+        }
+
+        if (!gpio_group_get_values(&values, group, mask))
+        {
+            return false;
+        }
+
+        snprintf(result, size, "0x%llx", (unsigned long long)values);
+
+        return true;
+    }
+    else if ((0 == strcmp(argv[0], "wait")) && (argc >= 2))
+    {
+        // 超时省略或为负数时一直等待
+        group = gpioctl_find_group(ctx, argv[1]);
+        if ((argc > 2) && ('-' != argv[2][0]))
+        {
+            if (!gpioctl_parse_duration(&ns, argv[2]))
+            {
+                return false;
+            }
+
+            timeout_ns = (int64_t)ns;
+        }
+
+        if ((!group) || ((argc > 3) && (!gpioctl_parse_edge(&edge, argv[3]))) ||
+            ((argc > 4) && (!gpioctl_parse_u64(&mask, argv[4]))))
+        {
+            return false;
+        }
+
+        if (!gpio_group_wait_any(&event, group, mask, edge, timeout_ns))
+        {
+            if (ETIMEDOUT == errno)
+            {
+                snprintf(result, size, "timeout");
+
+                return true;
+            }
+
+            return false;
+        }
+
+        snprintf(result, size, "line %u %s @%.3f us seq %u lost %u", event.index,
+                 (E_GPIO_RISING == event.edge) ? "rising" : "falling",
+                 (double)(int64_t)(event.timestamp_ns - ctx->start_ns) / 1000.0, event.seqno, event.lost);
+
+        return true;
+    }
+    else if ((0 == strcmp(argv[0], "stats")) && (argc >= 2))
+    {
+        group = gpioctl_find_group(ctx, argv[1]);
+        if (!group)
+        {
+            return false;
+        }
+
+        snprintf(result, size, "events %llu lost %llu", (unsigned long long)group->event_count,
+                 (unsigned long long)group->lost_count);
+
+        return true;
+    }
+    else if ((0 == strcmp(argv[0], "sleep")) && (argc >= 2))
+    {
+        if (!gpioctl_parse_duration(&ns, argv[1]))
+        {
+            return false;
+        }
+
+        gpioctl_sleep_until(gpioctl_now_ns() + ns);
+
+        return true;
+    }
+    else if ((0 == strcmp(argv[0], "until")) && (argc >= 2))
+    {
+        if (!gpioctl_parse_duration(&ns, argv[1]))
+        {
+            return false;
+        }
+
+        gpioctl_sleep_until(ctx->start_ns + ns);
+
+        return true;
+    }
+    else if ((0 == strcmp(argv[0], "close")) && (argc >= 2))
+    {
+        for (int i = 0; i < GPIOCTL_MAX_GROUPS; i++)
+        {
+            if ((ctx->groups[i].used) && (0 == strcmp(ctx->groups[i].name, argv[1])))
+            {
+                ctx->groups[i].used = false;
+
+                return gpio_group_close(&ctx->groups[i].group);
+            }
+        }
+
+        return false;
+    }
+
+    fprintf(stderr, "gpioctl: bad command '%s'\n", argv[0]);
+
+    return false;
+}
+
+/**
+ * @brief  执行一行脚本(可包含多条以';'分隔的命令)
+ * @param  ctx : 输入参数, 执行上下文
+ * @param  line: 输入参数, 脚本行, 会被修改
+ * @return true : 成功
+ * @return false: 失败
+ */
+static bool gpioctl_run_line(gpioctl_ctx_t *ctx, char *line)
+{
+    char *cmd_saveptr = NULL;
+    char *arg_saveptr = NULL;
+    char *cmd = NULL;
+    char *comment = NULL;
+    char *argv[GPIOCTL_MAX_ARGS] = {0};
+    int argc = 0;
+    char result[128] = {0};
+    uint64_t begin_ns = 0;
+    uint64_t end_ns = 0;
+    bool ret = false;
+
+    comment = strchr(line, '#');
+    if (comment)
+    {
+        *comment = '\0';
+    }
+
+    for (cmd = strtok_r(line, ";\n", &cmd_saveptr); cmd; cmd = strtok_r(NULL, ";\n", &cmd_saveptr))
+    {
+        argc = 0;
+        for (char *arg = strtok_r(cmd, " \t\r", &arg_saveptr); arg; arg = strtok_r(NULL, " \t\r", &arg_saveptr))
+        {
+            // 多余的参数不能静默丢弃, 否则执行的是被截断的命令
+            if (argc >= GPIOCTL_MAX_ARGS)
+            {
+                fprintf(stderr, "gpioctl: too many arguments for '%s'\n", argv[0]);
+
+                return false;
+            }
+
+            argv[argc++] = arg;
+        }
+
+        if (0 == argc)
+        {
+            continue;
+        }
+
+        result[0] = '\0';
+        begin_ns = gpioctl_now_ns();
+        ret = gpioctl_exec(ctx, argc, argv, result, sizeof(result));
+        end_ns = gpioctl_now_ns();
+        ctx->step++;
+
+        if (!ctx->quiet)
+        {
+            printf("[%4u] @%12.3f us  %10.3f us  %-6s %s%s\n", ctx->step,
+                   (double)(begin_ns - ctx->start_ns) / 1000.0, (double)(end_ns - begin_ns) / 1000.0, argv[0],
+                   ret ? "" : "FAILED ", result);
+        }
+        else if (result[0])
+        {
+            printf("%s\n", result);
+        }
+
+        if (!ret)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief  打印使用说明
+ * @param  prog: 输入参数, 程序名
+ */
+static void gpioctl_usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [-q] [-e \"cmd; cmd ...\"] [script|-]\n"
+            "  -q  only print command results, no per-step timing\n"
+            "  -e  execute commands given on the command line\n",
+            prog);
+}
+
+int main(int argc, char *argv[])
+{
+    gpioctl_ctx_t ctx = {0};
+    char line[GPIOCTL_LINE_MAX_LEN] = {0};
+    const char *inline_cmds = NULL;
+    FILE *fp = NULL;
+    bool ok = true;
+    int opt = -1;
+
+    while (-1 != (opt = getopt(argc, argv, "qe:h")))
+    {
+        switch (opt)
+        {
+        case 'q':
+        {
+            ctx.quiet = true;
+
+            break;
+        }
+
+        case 'e':
+        {
+            inline_cmds = optarg;
+
+            break;
+        }
+
+        default:
+        {
+            gpioctl_usage(argv[0]);
+
+            return 1;
+        }
+        }
+    }
+
+    ctx.start_ns = gpioctl_now_ns();
+
+    if (inline_cmds)
+    {
+        if (strlen(inline_cmds) >= sizeof(line))
+        {
+            fprintf(stderr, "gpioctl: line too long\n");
+
+            return 1;
+        }
+
+        snprintf(line, sizeof(line), "%s", inline_cmds);
+        ok = gpioctl_run_line(&ctx, line);
+    }
+    else
+    {
+        if ((optind >= argc) || (0 == strcmp(argv[optind], "-")))
+        {
+            fp = stdin;
+        }
+        else
+        {
+            fp = fopen(argv[optind], "r");
+            if (!fp)
+            {
+                perror(argv[optind]);
+
+                return 1;
+            }
+        }
+
+        while ((ok) && (fgets(line, sizeof(line), fp)))
+        {
+            // 没有读到换行且未到文件末尾说明行被截断
+            if ((!strchr(line, '\n')) && (!feof(fp)))
+            {
+                fprintf(stderr, "gpioctl: line too long\n");
+                ok = false;
+
+                break;
+            }
+
+            ok = gpioctl_run_line(&ctx, line);
+        }
+
+        if (stdin != fp)
+        {
+            fclose(fp);
+        }
+    }
+
+    for (int i = 0; i < GPIOCTL_MAX_GROUPS; i++)
+    {
+        if (ctx.groups[i].used)
+        {
+            gpio_group_close(&ctx.groups[i].group);
+        }
+    }
+
+    if (!ctx.quiet)
+    {
+        printf("total %u steps, %.3f us\n", ctx.step, (double)(gpioctl_now_ns() - ctx.start_ns) / 1000.0);
+    }
+
+    return ok ? 0 : 1;
+}
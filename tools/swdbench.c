@@ -0,0 +1,738 @@
+/**
+ * @file      : swdbench.c
+ * @brief     : SWD引擎基准测试工具, 在虚拟后端上仿真一个SWD目标(DP + MEM-AP + RAM)
+ * @author    : huenrong (huenrong1028@outlook.com)
+ * @date      : 2026-10-18 20:21:09
+ *
+ * @copyright : Copyright (c) 2026 huenrong
+ *
+ * @history   : date       author          description
+ *              2026-10-18 huenrong        创建文件
+ *
+ * 仿真目标在每个SWCLK上升沿推进协议状态机, 统计主机的GPIO操作次数;
+ * 可注入WAIT应答验证批量写入的回退路径. 输出批量写入、逐字写入和批量读取的吞吐量
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../gpio_group.h"
+#include "../gpio_swd.h"
+
+// 仿真目标的GPIO序号
+#define SWDBENCH_SWCLK 0
+#define SWDBENCH_SWDIO 1
+
+// 仿真RAM起始地址和大小(字)
+#define SWDBENCH_RAM_BASE 0x20000000
+#define SWDBENCH_RAM_WORDS (256 * 1024)
+
+// 仿真目标的DPIDR和MEM-AP IDR
+#define SWDBENCH_DPIDR 0x2BA01477
+#define SWDBENCH_AP_IDR 0x24770011
+
+// 仿真目标协议状态
+typedef enum
+{
+    // 等待请求
+    E_SWDBENCH_REQ = 0,
+    // 请求后的转换周期
+    E_SWDBENCH_TRN_ACK = 1,
+    // 输出应答
+    E_SWDBENCH_ACK = 2,
+    // 输出读数据和校验位
+    E_SWDBENCH_RDATA = 3,
+    // 写数据前的转换周期
+    E_SWDBENCH_TRN_WDATA = 4,
+    // 接收写数据和校验位
+    E_SWDBENCH_WDATA = 5,
+    // 释放总线后的转换周期
+    E_SWDBENCH_TRN_REQ = 6,
+} swdbench_state_e;
+
+// 仿真目标
+typedef struct
+{
+    // 主机输出的GPIO和电平
+    uint64_t output_mask;
+    uint64_t values;
+    // 目标输出的SWDIO电平
+    uint32_t target_dio;
+    // 线复位前不响应
+    bool locked;
+    uint32_t ones;
+    swdbench_state_e state;
+    uint32_t count;
+    uint32_t request;
+    uint32_t ack;
+    uint64_t data;
+    // DP/AP寄存器
+    uint32_t ctrl;
+    uint32_t select;
+    uint32_t rdbuff;
+    uint32_t csw;
+    uint32_t tar;
+    uint32_t *ram;
+    // 每N次DRW访问注入一次WAIT, 0表示不注入
+    uint32_t wait_every;
+    uint32_t drw_count;
+    // 主机GPIO操作次数
+    uint64_t set_calls;
+    uint64_t get_calls;
+    uint64_t dir_calls;
+} swdbench_target_t;
+
+/**
+ * @brief  获取CLOCK_MONOTONIC当前时间
+ * @return 当前时间, 单位: ns
+ */
+static uint64_t swdbench_now_ns(void)
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief  计算奇偶校验位
+ * @param  value: 输入参数, 数据
+ * @return 1的个数为奇数时为1
+ */
+static uint32_t swdbench_parity(uint64_t value)
+{
+    uint32_t parity = 0;
+
+    while (value)
+    {
+        parity ^= (uint32_t)(value & 1);
+        value >>= 1;
+    }
+
+    return parity;
+}
+
+/**
+ * @brief  访问仿真RAM
+ * @param  target: 输入参数, 仿真目标
+ * @param  write : 输入参数, 是否写入
+ * @param  value : 输入输出参数, 数据
+ */
+static void swdbench_mem_access(swdbench_target_t *target, const bool write, uint32_t *value)
+{
+    uint32_t index = (target->tar - SWDBENCH_RAM_BASE) / 4;
+
+    if ((target->tar < SWDBENCH_RAM_BASE) || (index >= SWDBENCH_RAM_WORDS))
+    {
+        target->ctrl |= 0x20;
+        *value = 0;
+
+        return;
+    }
+
+    if (write)
+    {
+        target->ram[index] = *value;
+    }
+    else
+    {
+        *value = target->ram[index];
+    }
+
+    // CSW AddrInc为单步递增时TAR在1KB内递增
+    if (0x10 == (target->csw & 0x30))
+    {
+        target->tar = (target->tar & ~0x3FFU) | ((target->tar + 4) & 0x3FFU);
+    }
+}
+
+/**
+ * @brief  根据请求决定应答
+ * @param  target: 输入参数, 仿真目标
+ * @return 应答
+ */
+static uint32_t swdbench_decide_ack(swdbench_target_t *target)
+{
+    bool ap = target->request & 0x2;
+    bool read = target->request & 0x4;
+    uint8_t addr = (uint8_t)((target->request >> 1) & 0xC);
+    uint8_t ap_addr = (uint8_t)((target->select & 0xF0) | addr);
+
+    // 粘滞错误时只允许读DPIDR/CTRL-STAT和写ABORT
+    if ((target->ctrl & 0x22) && ((ap) || ((read) && (GPIO_SWD_DP_RDBUFF == addr)) || ((!read) && (0 != addr))))
+    {
+        return GPIO_SWD_ACK_FAULT;
+    }
+
+    if ((ap) && (GPIO_SWD_AP_DRW == ap_addr) && (0 != target->wait_every) &&
+        (0 == (++target->drw_count % target->wait_every)))
+    {
+        if (target->ctrl & 0x1)
+        {
+            target->ctrl |= 0x2;
+        }
+
+        return GPIO_SWD_ACK_WAIT;
+    }
+
+    return GPIO_SWD_ACK_OK;
+}
+
+/**
+ * @brief  执行读请求
+ * @param  target: 输入参数, 仿真目标
+ * @return 读取结果
+ */
+static uint32_t swdbench_read(swdbench_target_t *target)
+{
+    uint8_t addr = (uint8_t)((target->request >> 1) & 0xC);
+    uint8_t ap_addr = (uint8_t)((target->select & 0xF0) | addr);
+    uint32_t value = 0;
+    uint32_t result = 0;
+
+    if (!(target->request & 0x2))
+    {
+        switch (addr)
+        {
+        case GPIO_SWD_DP_DPIDR:
+        {
+            return SWDBENCH_DPIDR;
+        }
+
+        case GPIO_SWD_DP_CTRL_STAT:
+        {
+            return target->ctrl | ((target->ctrl & 0x50000000) << 1);
+        }
+
+        case GPIO_SWD_DP_RDBUFF:
+        {
+            return target->rdbuff;
+        }
+
+        default:
+        {
+            return 0;
+        }
+        }
+    }
+
+    // AP读取延迟一次返回
+    switch (ap_addr)
+    {
+    case GPIO_SWD_AP_CSW:
+    {
+        value = target->csw;
+
+        break;
+    }
+
+    case GPIO_SWD_AP_TAR:
+    {
+        value = target->tar;
+
+        break;
+    }
+
+    case GPIO_SWD_AP_DRW:
+    {
+        swdbench_mem_access(target, false, &value);
+
+        break;
+    }
+
+    case GPIO_SWD_AP_IDR:
+    {
+        value = SWDBENCH_AP_IDR;
+
+        break;
+    }
+
+    default:
+    {
+        break;
+    }
+    }
+
+    result = target->rdbuff;
+    target->rdbuff = value;
+
+    return result;
+}
+
+/**
+ * @brief  执行写请求
+ * @param  target: 输入参数, 仿真目标
+ * @param  value : 输入参数, 写入的数据
+ */
+static void swdbench_write(swdbench_target_t *target, uint32_t value)
+{
+    uint8_t addr = (uint8_t)((target->request >> 1) & 0xC);
+    uint8_t ap_addr = (uint8_t)((target->select & 0xF0) | addr);
+
+    if (!(target->request & 0x2))
+    {
+        switch (addr)
+        {
+        case GPIO_SWD_DP_ABORT:
+        {
+            if (value & 0x10)
+            {
+                target->ctrl &= ~0x2U;
+            }
+
+            if (value & 0x4)
+            {
+                target->ctrl &= ~0x20U;
+            }
+
+            break;
+        }
+
+        case GPIO_SWD_DP_CTRL_STAT:
+        {
+            target->ctrl = (target->ctrl & 0x22) | (value & 0x50000001);
+
+            break;
+        }
+
+        case GPIO_SWD_DP_SELECT:
+        {
+            target->select = value;
+
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+        }
+
+        return;
+    }
+
+    switch (ap_addr)
+    {
+    case GPIO_SWD_AP_CSW:
+    {
+        target->csw = value;
+
+        break;
+    }
+
+    case GPIO_SWD_AP_TAR:
+    {
+        target->tar = value;
+
+        break;
+    }
+
+    case GPIO_SWD_AP_DRW:
+    {
+        swdbench_mem_access(target, true, &value);
+
+        break;
+    }
+
+    default:
+    {
+        break;
+    }
+    }
+}
+
+/**
+ * @brief  SWCLK上升沿: 推进仿真目标的协议状态机
+ * @param  target: 输入参数, 仿真目标
+ */
+static void swdbench_clock(swdbench_target_t *target)
+{
+    uint32_t bit = (target->values >> SWDBENCH_SWDIO) & 1;
+    bool host = target->output_mask & (1ULL << SWDBENCH_SWDIO);
+    bool read = target->request & 0x4;
+
+    switch (target->state)
+    {
+    case E_SWDBENCH_REQ:
+    {
+        if (!host)
+        {
+            break;
+        }
+
+        // 至少50个1之后的0完成线复位
+        if (bit)
+        {
+            target->ones++;
+        }
+        else
+        {
+            if (target->ones >= 50)
+            {
+                target->locked = false;
+                target->count = 0;
+            }
+
+            target->ones = 0;
+        }
+
+        if ((target->locked) || ((0 == target->count) && (!bit)))
+        {
+            break;
+        }
+
+        if (0 == target->count)
+        {
+            target->request = 0;
+        }
+
+        target->request |= bit << target->count;
+        if (++target->count < 8)
+        {
+            break;
+        }
+
+        // 校验起始位、停止位、驻留位和奇偶校验位
+        target->count = 0;
+        if ((0x81 != (target->request & 0xC1)) ||
+            (swdbench_parity((target->request >> 1) & 0xF) != ((target->request >> 5) & 1)))
+        {
+            break;
+        }
+
+        target->state = E_SWDBENCH_TRN_ACK;
+
+        break;
+    }
+
+    case E_SWDBENCH_TRN_ACK:
+    {
+        target->ack = swdbench_decide_ack(target);
+        target->target_dio = target->ack & 1;
+        target->count = 1;
+        target->state = E_SWDBENCH_ACK;
+
+        break;
+    }
+
+    case E_SWDBENCH_ACK:
+    {
+        if (target->count < 3)
+        {
+            target->target_dio = (target->ack >> target->count) & 1;
+            target->count++;
+
+            break;
+        }
+
+        // 溢出检测时WAIT/FAULT也有数据阶段
+        if ((GPIO_SWD_ACK_OK != target->ack) && (!(target->ctrl & 0x1)))
+        {
+            target->state = E_SWDBENCH_TRN_REQ;
+        }
+        else if (read)
+        {
+            target->data = (GPIO_SWD_ACK_OK == target->ack) ? swdbench_read(target) : 0;
+            target->data |= (uint64_t)swdbench_parity(target->data) << 32;
+            target->target_dio = target->data & 1;
+            target->count = 1;
+            target->state = E_SWDBENCH_RDATA;
+        }
+        else
+        {
+            target->state = E_SWDBENCH_TRN_WDATA;
+        }
+
+        break;
+    }
+
+    case E_SWDBENCH_RDATA:
+    {
+        if (target->count < 33)
+        {
+            target->target_dio = (target->data >> target->count) & 1;
+            target->count++;
+
+            break;
+        }
+
+        target->state = E_SWDBENCH_TRN_REQ;
+
+        break;
+    }
+
+    case E_SWDBENCH_TRN_WDATA:
+    {
+        target->data = 0;
+        target->count = 0;
+        target->state = E_SWDBENCH_WDATA;
+
+        break;
+    }
+
+    case E_SWDBENCH_WDATA:
+    {
+        target->data |= (uint64_t)bit << target->count;
+        if (++target->count < 33)
+        {
+            break;
+        }
+
+        if ((GPIO_SWD_ACK_OK == target->ack) &&
+            (swdbench_parity(target->data & UINT32_MAX) == (uint32_t)(target->data >> 32)))
+        {
+            swdbench_write(target, (uint32_t)target->data);
+        }
+
+        target->count = 0;
+        target->state = E_SWDBENCH_REQ;
+
+        break;
+    }
+
+    case E_SWDBENCH_TRN_REQ:
+    {
+        target->count = 0;
+        target->state = E_SWDBENCH_REQ;
+
+        break;
+    }
+
+    default:
+    {
+        break;
+    }
+    }
+}
+
+/**
+ * @brief  虚拟后端: 主机设置电平, SWCLK上升沿时推进仿真目标
+ */
+static bool swdbench_set_values(void *arg, const uint64_t mask, const uint64_t values)
+{
+    swdbench_target_t *target = (swdbench_target_t *)arg;
+    uint64_t clk = 1ULL << SWDBENCH_SWCLK;
+    bool rising = (!(target->values & clk)) && (mask & values & clk);
+
+    target->set_calls++;
+    target->values = (target->values & ~mask) | (values & mask);
+    if (rising)
+    {
+        swdbench_clock(target);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  虚拟后端: 主机获取电平, 主机未驱动SWDIO时为目标输出
+ */
+static bool swdbench_get_values(void *arg, const uint64_t mask, uint64_t *values)
+{
+    swdbench_target_t *target = (swdbench_target_t *)arg;
+    uint64_t dio = 1ULL << SWDBENCH_SWDIO;
+
+    target->get_calls++;
+    *values = target->values & mask;
+    if ((mask & dio) && (!(target->output_mask & dio)))
+    {
+        *values = (*values & ~dio) | (target->target_dio ? dio : 0);
+    }
+
+    return true;
+}
+
+/**
+ * @brief  虚拟后端: 方向变化
+ */
+static bool swdbench_set_direction(void *arg, const uint64_t output_mask)
+{
+    swdbench_target_t *target = (swdbench_target_t *)arg;
+
+    target->dir_calls++;
+    target->output_mask = output_mask;
+
+    return true;
+}
+
+/**
+ * @brief  打印一项测试结果
+ * @param  name  : 输入参数, 测试名称
+ * @param  words : 输入参数, 字数
+ * @param  ns    : 输入参数, 耗时, 单位: ns
+ * @param  ops   : 输入参数, GPIO操作次数
+ */
+static void swdbench_report(const char *name, const uint32_t words, const uint64_t ns, const uint64_t ops)
+{
+    printf("%-12s %8u words  %10.3f ms  %10.1f KiB/s  %6.1f gpio ops/word\n", name, words, (double)ns / 1e6,
+           (double)words * 4.0 / 1024.0 / ((double)ns / 1e9), (double)ops / (double)words);
+}
+
+/**
+ * @brief  获取仿真目标的GPIO操作总次数
+ * @param  target: 输入参数, 仿真目标
+ * @return 操作次数
+ */
+static uint64_t swdbench_ops(const swdbench_target_t *target)
+{
+    return target->set_calls + target->get_calls + target->dir_calls;
+}
+
+int main(int argc, char *argv[])
+{
+    static const gpio_group_ops_t ops = {swdbench_set_values, swdbench_get_values, swdbench_set_direction};
+    swdbench_target_t target = {0};
+    gpio_group_config_t config = {0};
+    gpio_group_t group = {0};
+    gpio_swd_config_t swd_config = {0};
+    gpio_swd_t swd = {0};
+    uint16_t lines[2] = {SWDBENCH_SWCLK, SWDBENCH_SWDIO};
+    uint32_t words = 16384;
+    uint32_t single = 0;
+    uint32_t *data = NULL;
+    uint32_t *readback = NULL;
+    uint32_t idcode = 0;
+    uint64_t start_ns = 0;
+    uint64_t start_ops = 0;
+    int ret = 1;
+    int opt = -1;
+
+    while (-1 != (opt = getopt(argc, argv, "n:w:h")))
+    {
+        switch (opt)
+        {
+        case 'n':
+        {
+            words = (uint32_t)strtoul(optarg, NULL, 0);
+
+            break;
+        }
+
+        case 'w':
+        {
+            target.wait_every = (uint32_t)strtoul(optarg, NULL, 0);
+
+            break;
+        }
+
+        default:
+        {
+            fprintf(stderr,
+                    "usage: %s [-n words] [-w N]\n"
+                    "  -n  words per block transfer (default 16384)\n"
+                    "  -w  inject a WAIT response every N DRW accesses\n",
+                    argv[0]);
+
+            return 1;
+        }
+        }
+    }
+
+    if ((0 == words) || (words > SWDBENCH_RAM_WORDS))
+    {
+        fprintf(stderr, "words must be in [1, %u]\n", SWDBENCH_RAM_WORDS);
+
+        return 1;
+    }
+
+    target.locked = true;
+    target.ram = calloc(SWDBENCH_RAM_WORDS, sizeof(uint32_t));
+    data = malloc(words * sizeof(uint32_t));
+    readback = malloc(words * sizeof(uint32_t));
+    if ((!target.ram) || (!data) || (!readback))
+    {
+        goto exit;
+    }
+
+    for (uint32_t i = 0; i < words; i++)
+    {
+        data[i] = i * 2654435761U;
+    }
+
+    config.backend = E_GPIO_BACKEND_VIRTUAL;
+    config.direction = E_GPIO_OUT;
+    config.init_values = 1ULL << SWDBENCH_SWDIO;
+    config.ops = &ops;
+    config.ops_arg = &target;
+    target.output_mask = 0x3;
+    if (!gpio_group_open(&group, lines, 2, &config))
+    {
+        fprintf(stderr, "open virtual group failed\n");
+
+        goto exit;
+    }
+
+    swd_config.group = &group;
+    swd_config.swclk = SWDBENCH_SWCLK;
+    swd_config.swdio = SWDBENCH_SWDIO;
+    if ((!gpio_swd_init(&swd, &swd_config)) || (!gpio_swd_connect(&idcode, &swd)))
+    {
+        fprintf(stderr, "connect failed\n");
+
+        goto exit;
+    }
+
+    printf("DPIDR 0x%08X\n", idcode);
+
+    // 批量写入
+    start_ops = swdbench_ops(&target);
+    start_ns = swdbench_now_ns();
+    if (!gpio_swd_mem_write_block(&swd, SWDBENCH_RAM_BASE, data, words))
+    {
+        fprintf(stderr, "block write failed\n");
+
+        goto exit;
+    }
+
+    swdbench_report("block write", words, swdbench_now_ns() - start_ns, swdbench_ops(&target) - start_ops);
+
+    // 批量读取并校验
+    start_ops = swdbench_ops(&target);
+    start_ns = swdbench_now_ns();
+    if (!gpio_swd_mem_read_block(readback, &swd, SWDBENCH_RAM_BASE, words))
+    {
+        fprintf(stderr, "block read failed\n");
+
+        goto exit;
+    }
+
+    swdbench_report("block read", words, swdbench_now_ns() - start_ns, swdbench_ops(&target) - start_ops);
+    if (0 != memcmp(data, readback, words * sizeof(uint32_t)))
+    {
+        fprintf(stderr, "verify failed\n");
+
+        goto exit;
+    }
+
+    // 逐字写入(每个字都写TAR并校验应答)作为对比
+    single = (words > 1024) ? 1024 : words;
+    start_ops = swdbench_ops(&target);
+    start_ns = swdbench_now_ns();
+    for (uint32_t i = 0; i < single; i++)
+    {
+        if (!gpio_swd_mem_write32(&swd, SWDBENCH_RAM_BASE + i * 4, ~data[i]))
+        {
+            fprintf(stderr, "single write failed\n");
+
+            goto exit;
+        }
+    }
+
+    swdbench_report("single write", single, swdbench_now_ns() - start_ns, swdbench_ops(&target) - start_ops);
+    printf("transfers %llu, waits %llu, faults %llu, fallbacks %llu\n", (unsigned long long)swd.stats.transfers,
+           (unsigned long long)swd.stats.waits, (unsigned long long)swd.stats.faults,
+           (unsigned long long)swd.stats.fallbacks);
+    ret = 0;
+
+exit:
+    gpio_group_close(&group);
+    free(target.ram);
+    free(data);
+    free(readback);
+
+    return ret;
+}